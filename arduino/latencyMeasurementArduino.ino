@@ -2,6 +2,8 @@
  * Arduino part for serial communication delay measurement.
  * This code will simply listen to one byte messages and send
  * them back to the host.
+ * At the end of setup(), the banner "LATENCY_READY" is sent to tell
+ * the host that the echo loop is running.
  * 
  * (c) 2019 by Clemens Rabe <info@clemensrabe.de>
  */
@@ -10,6 +12,8 @@ void setup() {
   Serial.begin(115200);
   pinMode(2, OUTPUT);
   digitalWrite(2, LOW);
+  Serial.print("LATENCY_READY\n");
+  Serial.flush();
 }
 
 void loop() {
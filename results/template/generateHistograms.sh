@@ -1,10 +1,18 @@
 #!/bin/bash
 
-./generateHistogram.py                         digitalWriteEnd_to_interrupt.gpd   digitalWriteEnd_to_interrupt_histogram   >/dev/null
-./generateHistogram.py                         digitalWriteStart_to_interrupt.gpd digitalWriteStart_to_interrupt_histogram >/dev/null
-./generateHistogram.py                         endWrite_to_endRead.gpd            endWrite_to_endRead_histogram            >/dev/null
-./generateHistogram.py -w 10.0 --bin-start 5.0 startWrite_to_endRead.gpd          startWrite_to_endRead_histogram          >/dev/null
-./generateHistogram.py                         startWrite_to_endWrite.gpd         startWrite_to_endWrite_histogram         >/dev/null
-./generateHistogram.py -w 10.0 --bin-start 5.0 startWrite_to_interrupt.gpd        startWrite_to_interrupt_histogram        >/dev/null
+# Use the native analyzer (src/latencyAnalyzer) if available. It analyzes all
+# time series of this directory in parallel with the settings used below.
+ANALYZER=${LATENCY_ANALYZER:-$(command -v latencyAnalyzer || echo ../../../src/latencyAnalyzer)}
+
+if [ -x "$ANALYZER" ]; then
+    "$ANALYZER" --all . >/dev/null || exit 1
+else
+    ./generateHistogram.py                         digitalWriteEnd_to_interrupt.gpd   digitalWriteEnd_to_interrupt_histogram   >/dev/null
+    ./generateHistogram.py                         digitalWriteStart_to_interrupt.gpd digitalWriteStart_to_interrupt_histogram >/dev/null
+    ./generateHistogram.py                         endWrite_to_endRead.gpd            endWrite_to_endRead_histogram            >/dev/null
+    ./generateHistogram.py -w 10.0 --bin-start 5.0 startWrite_to_endRead.gpd          startWrite_to_endRead_histogram          >/dev/null
+    ./generateHistogram.py                         startWrite_to_endWrite.gpd         startWrite_to_endWrite_histogram         >/dev/null
+    ./generateHistogram.py -w 10.0 --bin-start 5.0 startWrite_to_interrupt.gpd        startWrite_to_interrupt_histogram        >/dev/null
+fi
 
 ./generatePngs.gpi
@@ -0,0 +1,619 @@
+/* ********************************* FILE ************************************/
+/** \file    backgroundLoad.cpp
+ *
+ * \brief    This file describes the background load started for the
+ *           duration of the tests.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "backgroundLoad.h"
+#include "serialTiming.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+/// Default buffer size of the memory load in MB
+#define LOAD_MEMORY_DEFAULT_MB   64
+
+/// Default file size of the I/O load in MB
+#define LOAD_IO_DEFAULT_MB       64
+
+/// Default block size of the USB load in bytes
+#define LOAD_USB_DEFAULT_BYTES   4096
+
+/// Largest buffer or file size in MB
+#define LOAD_MAX_MB              2048
+
+/// Largest block size of the USB load in bytes
+#define LOAD_USB_MAX_BYTES       65536
+
+/// Default baud rate of the USB load
+#define LOAD_USB_DEFAULT_BAUD    SERIAL_DEFAULT_BAUD_RATE
+
+/// Size of the writes and reads of the I/O load
+#define LOAD_IO_BLOCK_SIZE       (1024 * 1024)
+
+/// Iterations of the busy loop per count
+#define LOAD_CPU_ITERATIONS      1000000
+
+/// Time for the load to reach its steady state before the tests start
+#define LOAD_SETTLE_TIME_MS      500
+
+/// File with the throughput of the load
+#define LOAD_SUMMARY_FILE        "load_summary.txt"
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// Receives a byte of each copy, so the copies of the memory load are not
+/// optimized away.
+static volatile uint8_t g_loadSink_ui = 0;
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Parse a list of cores like 1,3 or 1-3.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_list  - The list.
+ * \param[out] fr_cores - The cores.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool parseCores(const std::string&    fr_list,
+                       std::vector<int32_t>& fr_cores)
+{
+    const int32_t numCores_i = int32_t(sysconf(_SC_NPROCESSORS_CONF));
+    fr_cores.clear();
+
+    for (size_t start_ui = 0; start_ui <= fr_list.size(); ) {
+        size_t end_ui = fr_list.find(',', start_ui);
+        if (end_ui == std::string::npos)
+            end_ui = fr_list.size();
+        const std::string item = fr_list.substr(start_ui, end_ui - start_ui);
+        start_ui = end_ui + 1;
+
+        int first_i, last_i;
+        char dummy_c;
+        if (sscanf(item.c_str(), "%d-%d%c", &first_i, &last_i, &dummy_c) != 2) {
+            if (sscanf(item.c_str(), "%d%c", &first_i, &dummy_c) != 1)
+                return false;
+            last_i = first_i;
+        }
+        if ((first_i < 0) || (last_i < first_i) || (last_i >= numCores_i))
+            return false;
+        for (int core_i = first_i; core_i <= last_i; ++core_i)
+            fr_cores.push_back(core_i);
+    }
+    return !fr_cores.empty();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Parse a positive size.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_value     - The size, or empty for the default.
+ * \param[in]  f_default_ui - The default size.
+ * \param[in]  f_max_ui     - The largest size.
+ * \param[out] fr_size_ui   - The size.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool parseSize(const std::string& fr_value,
+                      const uint32_t     f_default_ui,
+                      const uint32_t     f_max_ui,
+                      uint32_t&          fr_size_ui)
+{
+    if (fr_value.empty()) {
+        fr_size_ui = f_default_ui;
+        return true;
+    }
+
+    char* end_p;
+    const unsigned long size_ul = strtoul(fr_value.c_str(), &end_p, 10);
+    if ((*end_p != '\0') || (size_ul == 0) || (size_ul > f_max_ui))
+        return false;
+    fr_size_ui = uint32_t(size_ul);
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Constructor. Keeps the affinity of latencyTest for the loads
+ *            without a core.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+BackgroundLoad::BackgroundLoad()
+    : m_counters_p(NULL),
+      m_startNs_ui(0),
+      m_running_b(false)
+{
+    if (sched_getaffinity(0, sizeof(m_affinity), &m_affinity) != 0) {
+        CPU_ZERO(&m_affinity);
+        for (int32_t core_i = 0; core_i < int32_t(sysconf(_SC_NPROCESSORS_CONF)); ++core_i)
+            CPU_SET(core_i, &m_affinity);
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Destructor. Stops the load without saving its summary, e.g.
+ *            after an error.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+BackgroundLoad::~BackgroundLoad()
+{
+    stop();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Add a load given by its specification.
+ *
+ *            The specifications are:
+ *            - cpu:CORES        - a busy loop on each core
+ *            - mem:CORES[:MB]   - a memory copy of MB on each core
+ *            - io:DIR[:MB]      - file write, sync and read of MB in DIR
+ *            - usb:DEV[:BYTES[:BAUD]] - bulk write/read of blocks on a serial
+ *              device at the baud rate
+ *
+ *            CORES is a list like 1,3 or 1-3.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_spec - The specification.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool BackgroundLoad::add(const std::string& fr_spec)
+{
+    const size_t typePos_ui = fr_spec.find(':');
+    if ((typePos_ui == std::string::npos) || (typePos_ui + 1 == fr_spec.size())) {
+        printf("Error: Invalid load %s!\n", fr_spec.c_str());
+        return false;
+    }
+    const std::string type  = fr_spec.substr(0, typePos_ui);
+    const std::string value = fr_spec.substr(typePos_ui + 1);
+
+    // The size follows the last colon, except for the busy loop
+    std::string head = value, size;
+    const size_t sizePos_ui = value.rfind(':');
+    if ((type != "cpu") && (sizePos_ui != std::string::npos)) {
+        head = value.substr(0, sizePos_ui);
+        size = value.substr(sizePos_ui + 1);
+    }
+
+    LoadWorker worker;
+    worker.spec     = fr_spec;
+    worker.core_i   = -1;
+    worker.size_ui  = 0;
+    worker.baudRate_ui = 0;
+    worker.handle_i = -1;
+    worker.pid_i    = 0;
+
+    std::vector<int32_t> cores;
+    bool ok_b = true;
+    if (type == "cpu") {
+        worker.type_e = LOAD_CPU;
+        ok_b = parseCores(head, cores);
+    }
+    else if (type == "mem") {
+        worker.type_e = LOAD_MEMORY;
+        ok_b = parseCores(head, cores) && parseSize(size, LOAD_MEMORY_DEFAULT_MB, LOAD_MAX_MB, worker.size_ui);
+        worker.size_ui *= 1024 * 1024;
+    }
+    else if (type == "io") {
+        worker.type_e = LOAD_IO;
+        worker.target = head;
+        ok_b = !head.empty() && parseSize(size, LOAD_IO_DEFAULT_MB, LOAD_MAX_MB, worker.size_ui);
+        worker.size_ui *= 1024 * 1024;
+        cores.push_back(-1);
+    }
+    else if (type == "usb") {
+        // The block size and the baud rate follow the device
+        std::string device = value, bytes, baud;
+        const size_t bytesPos_ui = value.find(':');
+        if (bytesPos_ui != std::string::npos) {
+            device = value.substr(0, bytesPos_ui);
+            bytes  = value.substr(bytesPos_ui + 1);
+            const size_t baudPos_ui = bytes.find(':');
+            if (baudPos_ui != std::string::npos) {
+                baud  = bytes.substr(baudPos_ui + 1);
+                bytes = bytes.substr(0, baudPos_ui);
+            }
+        }
+        worker.type_e = LOAD_USB;
+        worker.target = (device.compare(0, 5, "/dev/") == 0) ? device.substr(5) : device;
+        ok_b = !worker.target.empty() &&
+               parseSize(bytes, LOAD_USB_DEFAULT_BYTES, LOAD_USB_MAX_BYTES, worker.size_ui) &&
+               parseSize(baud, LOAD_USB_DEFAULT_BAUD, UINT32_MAX, worker.baudRate_ui) &&
+               serialBaudRateSupported(worker.baudRate_ui);
+        cores.push_back(-1);
+    }
+    else {
+        printf("Error: Unknown load type %s!\n", type.c_str());
+        return false;
+    }
+
+    if (!ok_b) {
+        printf("Error: Invalid load %s!\n", fr_spec.c_str());
+        return false;
+    }
+
+    for (size_t i = 0; i < cores.size(); ++i) {
+        worker.core_i = cores[i];
+        m_workers.push_back(worker);
+    }
+    m_specs.push_back(fr_spec);
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the load profile, the tag of the results.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns the specifications separated by spaces, or "none".
+ *
+ *****************************************************************************/
+std::string BackgroundLoad::profile() const
+{
+    if (m_specs.empty())
+        return "none";
+
+    std::string profile = m_specs[0];
+    for (size_t i = 1; i < m_specs.size(); ++i)
+        profile += " " + m_specs[i];
+    return profile;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if a USB load runs on a serial device, e.g. the one of
+ *            the Arduino.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_device - The device name without /dev/, e.g. "ttyUSB0".
+ * \return    Returns \c true if a load uses the device, otherwise \c false.
+ *
+ *****************************************************************************/
+bool BackgroundLoad::usesDevice(const std::string& fr_device) const
+{
+    struct stat device;
+    const bool deviceExists_b = (stat(("/dev/" + fr_device).c_str(), &device) == 0);
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        const LoadWorker& worker = m_workers[i];
+        if (worker.type_e != LOAD_USB)
+            continue;
+        if (worker.target == fr_device)
+            return true;
+
+        // Links like /dev/serial/by-id/ name the same device
+        struct stat target;
+        if (deviceExists_b && (stat(("/dev/" + worker.target).c_str(), &target) == 0) &&
+            S_ISCHR(device.st_mode) && S_ISCHR(target.st_mode) && (device.st_rdev == target.st_rdev))
+            return true;
+    }
+    return false;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Start a process for each load and let the load settle.
+ *
+ *            The files and devices are opened here, so their errors are
+ *            reported before the tests start.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool BackgroundLoad::start()
+{
+    if (m_workers.empty() || m_running_b)
+        return true;
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        LoadWorker& worker = m_workers[i];
+        if (worker.type_e == LOAD_IO) {
+            // The file is removed at once and vanishes with the process
+            std::string fileName = worker.target + "/latencyTest_load_XXXXXX";
+            worker.handle_i = mkstemp(&fileName[0]);
+            if (worker.handle_i < 0) {
+                printf("Error: Can't create a file for the load %s!\n", worker.spec.c_str());
+                stop();
+                return false;
+            }
+            unlink(fileName.c_str());
+        }
+        else if (worker.type_e == LOAD_USB) {
+            const std::string deviceName = "/dev/" + worker.target;
+            worker.handle_i = open(deviceName.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+            if ((worker.handle_i < 0) || !initializeSerialPort(worker.handle_i, 1, worker.baudRate_ui)) {
+                printf("Error: Can't open %s for the load %s!\n", deviceName.c_str(), worker.spec.c_str());
+                stop();
+                return false;
+            }
+        }
+    }
+
+    void* counters_p = mmap(NULL, m_workers.size() * sizeof(uint64_t), PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (counters_p == MAP_FAILED) {
+        printf("Error: Can't allocate the counters of the load!\n");
+        stop();
+        return false;
+    }
+    m_counters_p = (volatile uint64_t*) counters_p;
+
+    fflush(stdout);
+    m_startNs_ui = getTimeStampNs();
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        m_counters_p[i] = 0;
+        const pid_t pid_i = fork();
+        if (pid_i == 0) {
+            runWorker(m_workers[i], m_affinity, &m_counters_p[i]);
+            _exit(1);
+        }
+        if (pid_i < 0) {
+            printf("Error: Can't start the process of the load %s!\n", m_workers[i].spec.c_str());
+            stop();
+            return false;
+        }
+        m_workers[i].pid_i = pid_i;
+    }
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        if (m_workers[i].handle_i >= 0) {
+            close(m_workers[i].handle_i);
+            m_workers[i].handle_i = -1;
+        }
+    }
+
+    m_running_b = true;
+    printf("Info: Started the background load %s in %u processes.\n", profile().c_str(),
+           uint32_t(m_workers.size()));
+    usleep(LOAD_SETTLE_TIME_MS * 1000);
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Stop the processes of the load and print their throughput.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_saveSummary_b - If \c true, save the throughput to
+ *                              load_summary.txt. Only done after the tests
+ *                              ran, so a failed run does not leave a summary.
+ *
+ *****************************************************************************/
+void BackgroundLoad::stop(const bool f_saveSummary_b)
+{
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        LoadWorker& worker = m_workers[i];
+        if (worker.pid_i > 0) {
+            int status_i = 0;
+            if (waitpid(worker.pid_i, &status_i, WNOHANG) == worker.pid_i) {
+                printf("Warning: The load %s stopped early!\n", worker.spec.c_str());
+            }
+            else {
+                kill(worker.pid_i, SIGKILL);
+                waitpid(worker.pid_i, &status_i, 0);
+            }
+            worker.pid_i = 0;
+        }
+        if (worker.handle_i >= 0) {
+            close(worker.handle_i);
+            worker.handle_i = -1;
+        }
+    }
+
+    if (m_running_b) {
+        const double durationS_d = double(getTimeStampNs() - m_startNs_ui) / 1.0e9;
+        FILE* file_p = f_saveSummary_b ? fopen(LOAD_SUMMARY_FILE, "w") : NULL;
+        if (file_p)
+            fprintf(file_p, "# Background load %s. Columns: specification, core (-1: not pinned),\n"
+                    "# throughput, unit\n", profile().c_str());
+
+        for (size_t i = 0; i < m_workers.size(); ++i) {
+            const LoadWorker& worker = m_workers[i];
+            const bool   cpu_b = (worker.type_e == LOAD_CPU);
+            const double rate_d = double(m_counters_p[i]) / durationS_d / (cpu_b ? 1.0 : 1.0e6);
+            const char*  unit_p = cpu_b ? "M_iterations/s" : "MB/s";
+
+            printf("Info: Load %s on core %d: %.1f %s\n", worker.spec.c_str(), worker.core_i, rate_d, unit_p);
+            if (file_p)
+                fprintf(file_p, "%s %d %.3f %s\n", worker.spec.c_str(), worker.core_i, rate_d, unit_p);
+        }
+        if (file_p)
+            fclose(file_p);
+        m_running_b = false;
+    }
+
+    if (m_counters_p) {
+        munmap((void*) m_counters_p, m_workers.size() * sizeof(uint64_t));
+        m_counters_p = NULL;
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Main loop of the process of a load. Does not return unless an
+ *            error occurs.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_worker   - The load.
+ * \param[in]  fr_affinity - Affinity of the load without a core.
+ * \param[out] f_counter_p - Counter of the work done: millions of iterations
+ *                           of the busy loop, otherwise bytes.
+ *
+ *****************************************************************************/
+void BackgroundLoad::runWorker(const LoadWorker&  fr_worker,
+                               const cpu_set_t&   fr_affinity,
+                               volatile uint64_t* f_counter_p)
+{
+    // Die with latencyTest, and never inherit its real-time policy
+    prctl(PR_SET_PDEATHSIG, SIGKILL);
+    struct sched_param parameters;
+    memset(&parameters, 0, sizeof(parameters));
+    sched_setscheduler(0, SCHED_OTHER, &parameters);
+
+    // The loads without a core do not inherit the core of the measurement
+    cpu_set_t cpuSet = fr_affinity;
+    if (fr_worker.core_i >= 0) {
+        CPU_ZERO(&cpuSet);
+        CPU_SET(fr_worker.core_i, &cpuSet);
+    }
+    if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+        printf("Error: Can't run the load %s on core %d!\n", fr_worker.spec.c_str(), fr_worker.core_i);
+        fflush(stdout);
+        return;
+    }
+
+    switch (fr_worker.type_e) {
+    case LOAD_CPU: {
+        volatile uint64_t state_ui = 1;
+        for (;;) {
+            uint64_t value_ui = state_ui;
+            for (uint32_t i = 0; i < LOAD_CPU_ITERATIONS; ++i)
+                value_ui = value_ui * 6364136223846793005ULL + 1442695040888963407ULL;
+            state_ui = value_ui;
+            *f_counter_p += 1;
+        }
+    }
+
+    case LOAD_MEMORY: {
+        const size_t halfSize_ui = fr_worker.size_ui / 2;
+        uint8_t* source_p      = (uint8_t*) malloc(halfSize_ui);
+        uint8_t* destination_p = (uint8_t*) malloc(halfSize_ui);
+        if (!source_p || !destination_p)
+            return;
+        memset(source_p, 0x55, halfSize_ui);
+        memset(destination_p, 0, halfSize_ui);
+        for (uint32_t i = 0; ; ++i) {
+            memcpy(destination_p, source_p, halfSize_ui);
+            g_loadSink_ui = destination_p[(i * 4096) % halfSize_ui];
+            *f_counter_p += halfSize_ui;
+        }
+    }
+
+    case LOAD_IO: {
+        uint8_t* block_p = (uint8_t*) malloc(LOAD_IO_BLOCK_SIZE);
+        if (!block_p)
+            return;
+        memset(block_p, 0xAA, LOAD_IO_BLOCK_SIZE);
+        for (;;) {
+            if (lseek(fr_worker.handle_i, 0, SEEK_SET) < 0)
+                return;
+            for (uint32_t offset_ui = 0; offset_ui < fr_worker.size_ui; offset_ui += LOAD_IO_BLOCK_SIZE) {
+                if (write(fr_worker.handle_i, block_p, LOAD_IO_BLOCK_SIZE) != LOAD_IO_BLOCK_SIZE)
+                    return;
+                *f_counter_p += LOAD_IO_BLOCK_SIZE;
+            }
+            fdatasync(fr_worker.handle_i);
+
+            // Read from the disk, not from the page cache
+            posix_fadvise(fr_worker.handle_i, 0, 0, POSIX_FADV_DONTNEED);
+            if (lseek(fr_worker.handle_i, 0, SEEK_SET) < 0)
+                return;
+            for (uint32_t offset_ui = 0; offset_ui < fr_worker.size_ui; offset_ui += LOAD_IO_BLOCK_SIZE) {
+                if (read(fr_worker.handle_i, block_p, LOAD_IO_BLOCK_SIZE) != LOAD_IO_BLOCK_SIZE)
+                    return;
+                *f_counter_p += LOAD_IO_BLOCK_SIZE;
+            }
+        }
+    }
+
+    case LOAD_USB: {
+        uint8_t* block_p = (uint8_t*) malloc(fr_worker.size_ui);
+        if (!block_p)
+            return;
+        for (uint32_t i = 0; i < fr_worker.size_ui; ++i)
+            block_p[i] = uint8_t(i);
+
+        // Write as fast as the device accepts and drain its answers
+        for (;;) {
+            struct pollfd pollHandle;
+            pollHandle.fd      = fr_worker.handle_i;
+            pollHandle.events  = POLLIN | POLLOUT;
+            pollHandle.revents = 0;
+            if ((poll(&pollHandle, 1, 100) < 0) && (errno != EINTR))
+                return;
+            if (pollHandle.revents & (POLLERR | POLLHUP | POLLNVAL))
+                return;
+
+            if (pollHandle.revents & POLLOUT) {
+                const ssize_t written_i = write(fr_worker.handle_i, block_p, fr_worker.size_ui);
+                if (written_i > 0)
+                    *f_counter_p += written_i;
+            }
+            if (pollHandle.revents & POLLIN) {
+                uint8_t buffer[4096];
+                const ssize_t read_i = read(fr_worker.handle_i, buffer, sizeof(buffer));
+                if (read_i > 0)
+                    *f_counter_p += read_i;
+            }
+        }
+    }
+    }
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
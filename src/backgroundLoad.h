@@ -0,0 +1,97 @@
+/* ********************************* FILE ************************************/
+/** \file    backgroundLoad.h
+ *
+ * \brief    This file describes the background load started for the
+ *           duration of the tests.
+ *
+ *           Each load runs in its own child process with the normal
+ *           scheduling policy, so it competes with the measurement like the
+ *           logging, network and disk activity of a production board:
+ *           busy loops on chosen cores, memory copies streaming through a
+ *           buffer larger than the caches, file writes with fdatasync() and
+ *           uncached reads, and bulk traffic on a second serial device. The
+ *           processes are killed when the tests are done or when latencyTest
+ *           exits. Their throughput is reported, so a load profile can be
+ *           reproduced.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef BACKGROUND_LOAD_H
+#define BACKGROUND_LOAD_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <sched.h>
+#include <sys/types.h>
+#include <string>
+#include <vector>
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Types of the background load
+enum LoadType_t {
+  LOAD_CPU,     ///< Busy loop
+  LOAD_MEMORY,  ///< Memory copy
+  LOAD_IO,      ///< File write, sync and uncached read
+  LOAD_USB      ///< Bulk write/read on a serial device
+};
+
+
+/// A process generating background load
+struct LoadWorker {
+  LoadType_t  type_e;      ///< The type of the load
+  std::string spec;        ///< The specification the worker belongs to
+  int32_t     core_i;      ///< Core of the process, -1 if not pinned
+  uint32_t    size_ui;     ///< Buffer size in bytes (memory, I/O) or block size (USB)
+  uint32_t    baudRate_ui; ///< Baud rate of the device (USB)
+  std::string target;      ///< Directory (I/O) or device (USB)
+  int         handle_i;    ///< File or serial port opened for the process, -1 if none
+  pid_t       pid_i;       ///< The process, 0 if not running
+};
+
+
+/*****************************************************************************
+ * CLASS
+ ******************************************************************************/
+/// The background load of a run (--load option).
+class BackgroundLoad {
+ public:
+  BackgroundLoad();
+  ~BackgroundLoad();
+
+  bool        add(const std::string& fr_spec);
+  bool        empty() const { return m_workers.empty(); }
+  std::string profile() const;
+  bool        usesDevice(const std::string& fr_device) const;
+
+  bool        start();
+  void        stop(const bool f_saveSummary_b = false);
+  bool        isRunning() const { return m_running_b; }
+
+ private:
+  static void runWorker(const LoadWorker& fr_worker,
+                        const cpu_set_t&  fr_affinity,
+                        volatile uint64_t* f_counter_p);
+
+  std::vector<std::string> m_specs;
+  std::vector<LoadWorker>  m_workers;
+  volatile uint64_t*       m_counters_p;  ///< Work done by each worker, shared with the processes
+  cpu_set_t                m_affinity;    ///< Affinity of latencyTest before the measurement is pinned
+  uint64_t                 m_startNs_ui;
+  bool                     m_running_b;
+};
+
+#endif /* BACKGROUND_LOAD_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
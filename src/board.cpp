@@ -0,0 +1,295 @@
+/* ********************************* FILE ************************************/
+/** \file    board.cpp
+ *
+ * \brief    This file describes the boards supported by the GPIO tests.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "board.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+/// File holding the model of the board, provided by the device tree
+#define BOARD_MODEL_FILE "/proc/device-tree/model"
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// The built-in boards. The last entry is used for hosts without GPIOs.
+static const BoardDescriptor g_boards[] = {
+  // Physical pin 7 (BCM 4) for the Arduino, physical pin 35 (BCM 19) to
+  // physical pin 37 (BCM 26) for the interrupt latency test
+  { "raspberryPi", "Raspberry Pi",  7, 24, 25,  4, 26, "pinctrl-bcm2835",  0 },
+  // Physical pin 27 (GPIO 33) for the Arduino, physical pin 13 (GPIO 21) to
+  // physical pin 17 (GPIO 22) for the interrupt latency test. Core 5 is one
+  // of the big cores. The GPIO banks and the wakeup banks have different
+  // interrupt chips.
+  { "odroidxu4",   "Odroid XU4",   27,  2,  3, 33, 22, "exynos.*irq_chip",  5 },
+  { "none",        "",             -1, -1, -1, -1, -1, "",                 -1 }
+};
+
+/// Number of the built-in boards
+static const uint32_t g_numBoards_ui = sizeof(g_boards) / sizeof(g_boards[0]);
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Remove leading and trailing white space.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_text - The text.
+ * \return    Returns the text without leading and trailing white space.
+ *
+ *****************************************************************************/
+static std::string boardTrim(const std::string& fr_text)
+{
+    const size_t first_ui = fr_text.find_first_not_of(" \t\r\n");
+    if (first_ui == std::string::npos)
+        return "";
+    const size_t last_ui = fr_text.find_last_not_of(" \t\r\n");
+    return fr_text.substr(first_ui, last_ui - first_ui + 1);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Read a board descriptor from a file of key = value lines.
+ *
+ *            The keys are name, model, arduino_pin, inttest_out_pin,
+ *            inttest_in_pin, arduino_gpio, inttest_gpio, irq_chip and core,
+ *            as written by boardPrint(). Missing pins and cores are set to -1,
+ *            a missing interrupt chip is empty.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_fileName - The file name.
+ * \param[out] fr_board    - The board descriptor.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool boardLoad(const std::string& fr_fileName,
+                      BoardDescriptor&   fr_board)
+{
+    FILE* file_p = fopen(fr_fileName.c_str(), "r");
+    if (!file_p) {
+        printf("Error: Can't open the board file %s!\n", fr_fileName.c_str());
+        return false;
+    }
+
+    fr_board = g_boards[g_numBoards_ui - 1];
+    fr_board.name.clear();
+
+    char line[512];
+    uint32_t lineNumber_ui = 0;
+    bool     ok_b          = true;
+    while (ok_b && fgets(line, sizeof(line), file_p)) {
+        ++lineNumber_ui;
+        const std::string lineStr = boardTrim(line);
+        const size_t      pos_ui  = lineStr.find('=');
+        if (lineStr.empty() || (lineStr[0] == '#'))
+            continue;
+        if (pos_ui == std::string::npos) {
+            printf("Error: Expected key = value in line %u of %s!\n", lineNumber_ui, fr_fileName.c_str());
+            ok_b = false;
+            break;
+        }
+
+        const std::string key   = boardTrim(lineStr.substr(0, pos_ui));
+        const std::string value = boardTrim(lineStr.substr(pos_ui + 1));
+        if (key == "name") {
+            fr_board.name = value;
+            continue;
+        }
+        if (key == "model") {
+            fr_board.model = value;
+            continue;
+        }
+        if (key == "irq_chip") {
+            fr_board.irqChip = value;
+            continue;
+        }
+
+        int32_t* number_p = NULL;
+        if (key == "arduino_pin")
+            number_p = &fr_board.arduinoPin_i;
+        else if (key == "inttest_out_pin")
+            number_p = &fr_board.intTestOutPin_i;
+        else if (key == "inttest_in_pin")
+            number_p = &fr_board.intTestInPin_i;
+        else if (key == "arduino_gpio")
+            number_p = &fr_board.arduinoGpio_i;
+        else if (key == "inttest_gpio")
+            number_p = &fr_board.intTestInGpio_i;
+        else if (key == "core")
+            number_p = &fr_board.defaultCore_i;
+        else {
+            printf("Warning: Unknown key '%s' in line %u of %s.\n", key.c_str(), lineNumber_ui, fr_fileName.c_str());
+            continue;
+        }
+
+        char* end_p = NULL;
+        const long number_i = strtol(value.c_str(), &end_p, 10);
+        if (value.empty() || (*end_p != '\0')) {
+            printf("Error: Expected a number for '%s' in line %u of %s!\n", key.c_str(), lineNumber_ui, fr_fileName.c_str());
+            ok_b = false;
+            break;
+        }
+        *number_p = int32_t(number_i);
+    }
+    fclose(file_p);
+
+    if (ok_b && fr_board.name.empty()) {
+        printf("Error: The board file %s has no name!\n", fr_fileName.c_str());
+        ok_b = false;
+    }
+    return ok_b;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Select a built-in board by its name or load a board file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_nameOrFile - Name of a built-in board or a board file.
+ * \param[out] fr_board      - The board descriptor.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool boardSelect(const std::string& fr_nameOrFile,
+                 BoardDescriptor&   fr_board)
+{
+    for (uint32_t i = 0; i < g_numBoards_ui; ++i) {
+        if (fr_nameOrFile == g_boards[i].name) {
+            fr_board = g_boards[i];
+            return true;
+        }
+    }
+    return boardLoad(fr_nameOrFile, fr_board);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Detect the board from the model given by the device tree.
+ *
+ *            Hosts without a device tree or with an unknown model get the
+ *            board "none" without GPIOs.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[out] fr_board - The board descriptor.
+ *
+ *****************************************************************************/
+void boardDetect(BoardDescriptor& fr_board)
+{
+    fr_board = g_boards[g_numBoards_ui - 1];
+
+    FILE* file_p = fopen(BOARD_MODEL_FILE, "r");
+    if (!file_p)
+        return;
+
+    char model[256];
+    const size_t length_ui = fread(model, 1, sizeof(model) - 1, file_p);
+    fclose(file_p);
+    model[length_ui] = '\0';
+
+    for (uint32_t i = 0; i < g_numBoards_ui - 1; ++i) {
+        if (strstr(model, g_boards[i].model.c_str()) != NULL) {
+            fr_board = g_boards[i];
+            return;
+        }
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if the board has the GPIO connections of the interrupt
+ *            tests.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_board - The board descriptor.
+ * \return    Returns \c true if all pins are given, otherwise \c false.
+ *
+ *****************************************************************************/
+bool boardHasGpio(const BoardDescriptor& fr_board)
+{
+    return ((fr_board.arduinoPin_i >= 0) &&
+            (fr_board.intTestOutPin_i >= 0) &&
+            (fr_board.intTestInPin_i >= 0));
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the board descriptor in the format of a board file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_board - The board descriptor.
+ *
+ *****************************************************************************/
+void boardPrint(const BoardDescriptor& fr_board)
+{
+    printf("name = %s\n",            fr_board.name.c_str());
+    printf("model = %s\n",           fr_board.model.c_str());
+    printf("arduino_pin = %d\n",     fr_board.arduinoPin_i);
+    printf("inttest_out_pin = %d\n", fr_board.intTestOutPin_i);
+    printf("inttest_in_pin = %d\n",  fr_board.intTestInPin_i);
+    printf("arduino_gpio = %d\n",    fr_board.arduinoGpio_i);
+    printf("inttest_gpio = %d\n",    fr_board.intTestInGpio_i);
+    printf("irq_chip = %s\n",        fr_board.irqChip.c_str());
+    printf("core = %d\n",            fr_board.defaultCore_i);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print a summary of the built-in boards for the usage.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void boardPrintTable()
+{
+    printf("Built-in boards (wiringPi pins):\n");
+    for (uint32_t i = 0; i < g_numBoards_ui; ++i) {
+        const BoardDescriptor& board = g_boards[i];
+        if (boardHasGpio(board))
+            printf("  %-12s Arduino on pin %d, interrupt test from pin %d to pin %d, core %d\n",
+                   board.name.c_str(), board.arduinoPin_i, board.intTestOutPin_i,
+                   board.intTestInPin_i, board.defaultCore_i);
+        else
+            printf("  %-12s No GPIO connections, only the serial tests\n", board.name.c_str());
+    }
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
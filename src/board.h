@@ -0,0 +1,63 @@
+/* ********************************* FILE ************************************/
+/** \file    board.h
+ *
+ * \brief    This file describes the boards supported by the GPIO tests.
+ *
+ *           A board descriptor holds the wiringPi pins of the signal from the
+ *           Arduino and of the interrupt latency test, the kernel GPIO numbers
+ *           of the input pins for the gpiotiming kernel module, the interrupt
+ *           chip of the GPIOs in /proc/interrupts and the default core of the
+ *           measurement. The descriptors of the known boards are
+ *           built in; other boards are described by a file of key = value
+ *           lines. Without --board, the board is detected from the model in
+ *           the device tree.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef BOARD_H
+#define BOARD_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <string>
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Description of a board. Pins and cores not available are set to -1.
+struct BoardDescriptor {
+  std::string name;             ///< Name as used for the directories in results/
+  std::string model;            ///< Part of the device tree model for the detection
+  int32_t     arduinoPin_i;     ///< wiringPi pin of the signal from the Arduino
+  int32_t     intTestOutPin_i;  ///< wiringPi output pin of the interrupt latency test
+  int32_t     intTestInPin_i;   ///< wiringPi input pin of the interrupt latency test
+  int32_t     arduinoGpio_i;    ///< Kernel GPIO number of arduinoPin_i
+  int32_t     intTestInGpio_i;  ///< Kernel GPIO number of intTestInPin_i
+  std::string irqChip;          ///< Regular expression of the GPIO interrupt chip in /proc/interrupts
+  int32_t     defaultCore_i;    ///< Core of the measurement if not set by the user
+};
+
+
+/*****************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+bool boardSelect(const std::string& fr_nameOrFile,
+                 BoardDescriptor&   fr_board);
+void boardDetect(BoardDescriptor& fr_board);
+bool boardHasGpio(const BoardDescriptor& fr_board);
+void boardPrint(const BoardDescriptor& fr_board);
+void boardPrintTable();
+
+#endif /* BOARD_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
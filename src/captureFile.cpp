@@ -0,0 +1,574 @@
+/* ********************************* FILE ************************************/
+/** \file    captureFile.cpp
+ *
+ * \brief    This file describes the binary capture format of raw timestamps.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "captureFile.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Timestamp of a record used by a derived series
+enum CaptureField {
+  FIELD_BEFORE_WRITE,
+  FIELD_AFTER_WRITE,
+  FIELD_AFTER_READ,
+  FIELD_INTERRUPT
+};
+
+/// Definition of a derived series as difference of two timestamps
+struct CaptureSeriesDefinition {
+  const char*  name_p;
+  uint32_t     type_ui;
+  CaptureField start_e;
+  CaptureField end_e;
+};
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// Derived series, named like the gnuplot data files written by latencyTest.
+/// The wakeup methods are in the order of determineWakeupLatency(), the
+/// probes in the order of latencyProbeCreate().
+static const CaptureSeriesDefinition g_captureSeries[] = {
+  { "digitalWriteStart_to_interrupt",            CAPTURE_INTERRUPT,            FIELD_BEFORE_WRITE, FIELD_INTERRUPT },
+  { "digitalWriteEnd_to_interrupt",              CAPTURE_INTERRUPT,            FIELD_AFTER_WRITE,  FIELD_INTERRUPT },
+  { "startWrite_to_interrupt",                   CAPTURE_SERIAL,               FIELD_BEFORE_WRITE, FIELD_INTERRUPT },
+  { "startWrite_to_endWrite",                    CAPTURE_SERIAL,               FIELD_BEFORE_WRITE, FIELD_AFTER_WRITE },
+  { "endWrite_to_endRead",                       CAPTURE_SERIAL,               FIELD_AFTER_WRITE,  FIELD_AFTER_READ },
+  { "startWrite_to_endRead",                     CAPTURE_SERIAL,               FIELD_BEFORE_WRITE, FIELD_AFTER_READ },
+  { "concurrent_digitalWriteStart_to_interrupt", CAPTURE_CONCURRENT_INTERRUPT, FIELD_BEFORE_WRITE, FIELD_INTERRUPT },
+  { "concurrent_digitalWriteEnd_to_interrupt",   CAPTURE_CONCURRENT_INTERRUPT, FIELD_AFTER_WRITE,  FIELD_INTERRUPT },
+  { "concurrent_startWrite_to_interrupt",        CAPTURE_CONCURRENT_SERIAL,    FIELD_BEFORE_WRITE, FIELD_INTERRUPT },
+  { "concurrent_startWrite_to_endWrite",         CAPTURE_CONCURRENT_SERIAL,    FIELD_BEFORE_WRITE, FIELD_AFTER_WRITE },
+  { "concurrent_endWrite_to_endRead",            CAPTURE_CONCURRENT_SERIAL,    FIELD_AFTER_WRITE,  FIELD_AFTER_READ },
+  { "concurrent_startWrite_to_endRead",          CAPTURE_CONCURRENT_SERIAL,    FIELD_BEFORE_WRITE, FIELD_AFTER_READ },
+  { "wakeup_usleep",                             CAPTURE_WAKEUP + 0,           FIELD_BEFORE_WRITE, FIELD_AFTER_READ },
+  { "wakeup_nanosleep_rel",                      CAPTURE_WAKEUP + 1,           FIELD_BEFORE_WRITE, FIELD_AFTER_READ },
+  { "wakeup_nanosleep_abs",                      CAPTURE_WAKEUP + 2,           FIELD_BEFORE_WRITE, FIELD_AFTER_READ },
+  { "wakeup_timerfd",                            CAPTURE_WAKEUP + 3,           FIELD_BEFORE_WRITE, FIELD_AFTER_READ },
+  { "probe0_send_to_receive",                    CAPTURE_PROBE + 0,            FIELD_BEFORE_WRITE, FIELD_AFTER_READ },
+  { "probe1_send_to_receive",                    CAPTURE_PROBE + 1,            FIELD_BEFORE_WRITE, FIELD_AFTER_READ },
+  { "probe2_send_to_receive",                    CAPTURE_PROBE + 2,            FIELD_BEFORE_WRITE, FIELD_AFTER_READ },
+  { "probe3_send_to_receive",                    CAPTURE_PROBE + 3,            FIELD_BEFORE_WRITE, FIELD_AFTER_READ },
+  { NULL,                                        0,                            FIELD_BEFORE_WRITE, FIELD_BEFORE_WRITE }
+};
+
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get a timestamp of a record.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_record - The record.
+ * \param[in] f_field_e - The timestamp to get.
+ * \return    Returns the timestamp in nanoseconds.
+ *
+ *****************************************************************************/
+static uint64_t getField(const CaptureRecord& fr_record,
+                         const CaptureField   f_field_e)
+{
+    switch (f_field_e) {
+    case FIELD_BEFORE_WRITE: return fr_record.beforeWriteNs_ui;
+    case FIELD_AFTER_WRITE:  return fr_record.afterWriteNs_ui;
+    case FIELD_AFTER_READ:   return fr_record.afterReadNs_ui;
+    default:                 return fr_record.interruptNs_ui;
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Initialize a capture header with the magic, the version and the
+ *            metadata of the host and the start times.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[out] fr_header - The header to initialize.
+ *
+ *****************************************************************************/
+void captureInitializeHeader(CaptureHeader& fr_header)
+{
+    memset(&fr_header, 0, sizeof(fr_header));
+    memcpy(fr_header.magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC));
+    fr_header.version_ui    = CAPTURE_VERSION;
+    fr_header.headerSize_ui = CAPTURE_HEADER_SIZE;
+    fr_header.recordSize_ui = sizeof(CaptureRecord);
+    fr_header.ftdiLatencyMs_i = -1;
+
+    struct timespec t;
+    clock_gettime(CLOCK_REALTIME, &t);
+    fr_header.startRealtimeNs_ui = uint64_t(t.tv_sec) * 1000000000 + uint64_t(t.tv_nsec);
+    clock_gettime(CLOCK_MONOTONIC_RAW, &t);
+    fr_header.startMonotonicNs_ui = uint64_t(t.tv_sec) * 1000000000 + uint64_t(t.tv_nsec);
+
+    struct utsname name;
+    if (uname(&name) == 0) {
+        // The header fields have a fixed size, so long names are cut explicitly
+        if (snprintf(fr_header.hostname, sizeof(fr_header.hostname), "%.*s",
+                     int(sizeof(fr_header.hostname) - 1), name.nodename) < 0)
+            fr_header.hostname[0] = '\0';
+        if (snprintf(fr_header.kernel, sizeof(fr_header.kernel), "%.*s",
+                     int(sizeof(fr_header.kernel) - 1), name.release) < 0)
+            fr_header.kernel[0] = '\0';
+        if (snprintf(fr_header.machine, sizeof(fr_header.machine), "%.*s",
+                     int(sizeof(fr_header.machine) - 1), name.machine) < 0)
+            fr_header.machine[0] = '\0';
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Constructor.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+CaptureWriter::CaptureWriter()
+    : m_handle_i(-1),
+      m_map_p(NULL),
+      m_mapSize_ui(0),
+      m_header_p(NULL),
+      m_records_p(NULL),
+      m_capacity_ui(0),
+      m_numDropped_ui(0),
+      m_locked_b(true),
+      m_hasBlocks_b(false)
+{
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Destructor. Closes the capture file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+CaptureWriter::~CaptureWriter()
+{
+    close();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Resize the file and the mapping, then lock and prefault it.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_newSize_ui - The new size of the file in bytes.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool CaptureWriter::mapChunk(const size_t f_newSize_ui)
+{
+    // Reserve the disk blocks, so writing to the pages does not allocate them
+    if (posix_fallocate(m_handle_i, 0, f_newSize_ui) != 0) {
+        if (ftruncate(m_handle_i, f_newSize_ui) != 0) {
+            printf("Error: Can't resize the capture file to %zu bytes!\n", f_newSize_ui);
+            return false;
+        }
+    }
+
+    void* map_p;
+    if (m_map_p == NULL) {
+        map_p = mmap(NULL, f_newSize_ui, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_handle_i, 0);
+    } else {
+        map_p = mremap(m_map_p, m_mapSize_ui, f_newSize_ui, MREMAP_MAYMOVE);
+    }
+    if (map_p == MAP_FAILED) {
+        printf("Error: Can't map the capture file!\n");
+        return false;
+    }
+
+    // Locking also faults in all pages of the new chunk
+    if (m_locked_b && (mlock((char*) map_p + m_mapSize_ui, f_newSize_ui - m_mapSize_ui) != 0)) {
+        printf("Warning: Can't lock the capture buffer in memory. Page faults may occur during the test.\n");
+        m_locked_b = false;
+    }
+    if (!m_locked_b) {
+        for (size_t i = m_mapSize_ui; i < f_newSize_ui; i += 4096)
+            ((volatile char*) map_p)[i] = ((volatile char*) map_p)[i];
+    }
+
+    m_map_p       = map_p;
+    m_mapSize_ui  = f_newSize_ui;
+    m_header_p    = (CaptureHeader*) map_p;
+    m_records_p   = (CaptureRecord*) ((char*) map_p + CAPTURE_HEADER_SIZE);
+    m_capacity_ui = (f_newSize_ui - CAPTURE_HEADER_SIZE) / sizeof(CaptureRecord);
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Grow the capture file in chunks until the given number of
+ *            further records fits. Call it outside of the measurement loop,
+ *            e.g. before appending a batch of records.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_numRecords_ui - Number of records to append.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool CaptureWriter::reserve(const uint64_t f_numRecords_ui)
+{
+    const uint64_t numRecords_ui = m_header_p->numRecords_ui + f_numRecords_ui;
+    if (numRecords_ui <= m_capacity_ui)
+        return true;
+
+    const size_t size_ui = CAPTURE_HEADER_SIZE + numRecords_ui * sizeof(CaptureRecord);
+    return mapChunk((size_ui + CAPTURE_CHUNK_SIZE - 1) / CAPTURE_CHUNK_SIZE * CAPTURE_CHUNK_SIZE);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Reserve a block of records for a thread measuring concurrently
+ *            to others. Call it before the threads start, as the block is
+ *            taken from the records sized by open().
+ *
+ *            The unused records of a block are removed when the capture
+ *            file is closed. Without a capture file, the block is empty.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  f_numRecords_ui - Number of records of the block.
+ * \param[out] fr_block        - The block.
+ *
+ *****************************************************************************/
+void CaptureWriter::reserveBlock(const uint64_t f_numRecords_ui,
+                                 CaptureBlock&  fr_block)
+{
+    fr_block = CaptureBlock();
+    if (!isOpen())
+        return;
+
+    const uint64_t first_ui = m_header_p->numRecords_ui;
+    const uint64_t free_ui  = m_capacity_ui - first_ui;
+    fr_block.m_records_p   = m_records_p + first_ui;
+    fr_block.m_capacity_ui = (f_numRecords_ui < free_ui) ? f_numRecords_ui : free_ui;
+    if (fr_block.m_capacity_ui < f_numRecords_ui)
+        m_numDropped_ui += f_numRecords_ui - fr_block.m_capacity_ui;
+
+    // Records of type 0 are unused and removed by close()
+    memset(fr_block.m_records_p, 0, fr_block.m_capacity_ui * sizeof(CaptureRecord));
+    m_header_p->numRecords_ui += fr_block.m_capacity_ui;
+    m_hasBlocks_b = true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Create the capture file and write the header.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_fileName     - The file name.
+ * \param[in] fr_header       - The header, initialized by
+ *                              captureInitializeHeader() and filled with the
+ *                              metadata of the run.
+ * \param[in] f_numRecords_ui - Number of records the file is sized for.
+ *                              Further ones need a reserve().
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool CaptureWriter::open(const std::string&   fr_fileName,
+                         const CaptureHeader& fr_header,
+                         const uint64_t       f_numRecords_ui)
+{
+    close();
+
+    m_handle_i = ::open(fr_fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_handle_i < 0) {
+        printf("Error: Can't create capture file %s!\n", fr_fileName.c_str());
+        return false;
+    }
+
+    const size_t size_ui = CAPTURE_HEADER_SIZE + (f_numRecords_ui > 0 ? f_numRecords_ui : 1) * sizeof(CaptureRecord);
+    if (!mapChunk(size_ui)) {
+        close();
+        return false;
+    }
+
+    memcpy(m_header_p, &fr_header, sizeof(CaptureHeader));
+    m_header_p->numRecords_ui = 0;
+    m_numDropped_ui           = 0;
+    m_hasBlocks_b             = false;
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Close the capture file and truncate it to the valid records.
+ *            The unused records of the blocks are removed.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void CaptureWriter::close()
+{
+    if (m_handle_i < 0)
+        return;
+
+    size_t fileSize_ui = CAPTURE_HEADER_SIZE;
+    if (m_map_p) {
+        if (m_hasBlocks_b) {
+            uint64_t numRecords_ui = 0;
+            for (uint64_t i = 0; i < m_header_p->numRecords_ui; ++i) {
+                if (m_records_p[i].type_ui != 0)
+                    m_records_p[numRecords_ui++] = m_records_p[i];
+            }
+            m_header_p->numRecords_ui = numRecords_ui;
+        }
+        fileSize_ui += m_header_p->numRecords_ui * sizeof(CaptureRecord);
+        msync(m_map_p, m_mapSize_ui, MS_SYNC);
+        munmap(m_map_p, m_mapSize_ui);
+    }
+    if (ftruncate(m_handle_i, fileSize_ui) != 0) {
+        printf("Warning: Can't truncate the capture file!\n");
+    }
+    if (m_numDropped_ui > 0) {
+        printf("Warning: %llu records did not fit into the capture file and were dropped!\n",
+               (unsigned long long) m_numDropped_ui);
+    }
+    ::close(m_handle_i);
+
+    m_handle_i      = -1;
+    m_map_p         = NULL;
+    m_mapSize_ui    = 0;
+    m_header_p      = NULL;
+    m_records_p     = NULL;
+    m_capacity_ui   = 0;
+    m_numDropped_ui = 0;
+    m_locked_b      = true;
+    m_hasBlocks_b   = false;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Constructor.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+CaptureReader::CaptureReader()
+    : m_handle_i(-1),
+      m_map_p(NULL),
+      m_mapSize_ui(0),
+      m_header_p(NULL),
+      m_records_p(NULL),
+      m_numRecords_ui(0)
+{
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Destructor. Closes the capture file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+CaptureReader::~CaptureReader()
+{
+    close();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Open and validate a capture file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_fileName - The file name.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool CaptureReader::open(const std::string& fr_fileName)
+{
+    close();
+
+    m_handle_i = ::open(fr_fileName.c_str(), O_RDONLY);
+    if (m_handle_i < 0) {
+        printf("Error: Can't open capture file %s!\n", fr_fileName.c_str());
+        return false;
+    }
+
+    struct stat fileStat;
+    if ((fstat(m_handle_i, &fileStat) != 0) || (size_t(fileStat.st_size) < CAPTURE_HEADER_SIZE)) {
+        printf("Error: %s is not a capture file!\n", fr_fileName.c_str());
+        close();
+        return false;
+    }
+
+    m_mapSize_ui = fileStat.st_size;
+    m_map_p      = mmap(NULL, m_mapSize_ui, PROT_READ, MAP_SHARED, m_handle_i, 0);
+    if (m_map_p == MAP_FAILED) {
+        printf("Error: Can't map capture file %s!\n", fr_fileName.c_str());
+        m_map_p = NULL;
+        close();
+        return false;
+    }
+
+    m_header_p = (const CaptureHeader*) m_map_p;
+    if ((memcmp(m_header_p->magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0) ||
+        (m_header_p->version_ui != CAPTURE_VERSION) ||
+        (m_header_p->recordSize_ui != sizeof(CaptureRecord))) {
+        printf("Error: %s is not a capture file of version %d!\n", fr_fileName.c_str(), CAPTURE_VERSION);
+        close();
+        return false;
+    }
+
+    if ((m_header_p->headerSize_ui < sizeof(CaptureHeader)) || (m_header_p->headerSize_ui > m_mapSize_ui)) {
+        printf("Error: Invalid header size %u of capture file %s!\n", m_header_p->headerSize_ui,
+               fr_fileName.c_str());
+        close();
+        return false;
+    }
+
+    m_records_p     = (const CaptureRecord*) ((const char*) m_map_p + m_header_p->headerSize_ui);
+    m_numRecords_ui = m_header_p->numRecords_ui;
+
+    // A capture of an aborted run may claim more records than written
+    const uint64_t maxRecords_ui = (m_mapSize_ui - m_header_p->headerSize_ui) / sizeof(CaptureRecord);
+    if (m_numRecords_ui > maxRecords_ui)
+        m_numRecords_ui = maxRecords_ui;
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Close the capture file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void CaptureReader::close()
+{
+    if (m_map_p)
+        munmap(m_map_p, m_mapSize_ui);
+    if (m_handle_i >= 0)
+        ::close(m_handle_i);
+
+    m_handle_i      = -1;
+    m_map_p         = NULL;
+    m_mapSize_ui    = 0;
+    m_header_p      = NULL;
+    m_records_p     = NULL;
+    m_numRecords_ui = 0;
+    m_series.clear();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get a derived series. It is computed on the first access.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_name - Name of the series, see seriesNames().
+ * \return    Returns the series in nanoseconds in the order of the records
+ *            or \c NULL if the series name is unknown.
+ *
+ *****************************************************************************/
+const std::vector<int64_t>* CaptureReader::series(const std::string& fr_name)
+{
+    std::map<std::string, std::vector<int64_t> >::const_iterator cached = m_series.find(fr_name);
+    if (cached != m_series.end())
+        return &cached->second;
+
+    const CaptureSeriesDefinition* definition_p = NULL;
+    for (uint32_t i = 0; g_captureSeries[i].name_p != NULL; ++i) {
+        if (fr_name == g_captureSeries[i].name_p)
+            definition_p = &g_captureSeries[i];
+    }
+    if (!definition_p)
+        return NULL;
+
+    std::vector<int64_t>& values = m_series[fr_name];
+    for (uint64_t i = 0; i < m_numRecords_ui; ++i) {
+        const CaptureRecord& record = m_records_p[i];
+        if (record.type_ui != definition_p->type_ui)
+            continue;
+        if (((definition_p->start_e == FIELD_INTERRUPT) || (definition_p->end_e == FIELD_INTERRUPT)) &&
+            (record.interruptNs_ui == 0))
+            continue;
+        values.push_back(int64_t(getField(record, definition_p->end_e) - getField(record, definition_p->start_e)));
+    }
+
+    return &values;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the names of all derived series.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns a \c NULL terminated list of series names.
+ *
+ *****************************************************************************/
+const char* const* CaptureReader::seriesNames()
+{
+    static std::vector<const char*> names;
+    if (names.empty()) {
+        for (uint32_t i = 0; g_captureSeries[i].name_p != NULL; ++i)
+            names.push_back(g_captureSeries[i].name_p);
+        names.push_back(NULL);
+    }
+    return &names[0];
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,229 @@
+/* ********************************* FILE ************************************/
+/** \file    captureFile.h
+ *
+ * \brief    This file describes the binary capture format of raw timestamps.
+ *
+ *           A capture file consists of a header of CAPTURE_HEADER_SIZE bytes
+ *           with the run metadata, followed by fixed size records with the
+ *           raw timestamps in nanoseconds of each iteration (CLOCK_MONOTONIC
+ *           for the wakeup test, CLOCK_MONOTONIC_RAW otherwise). All values
+ *           are stored in host byte order.
+ *
+ *           The writer maps the file into memory and locks it. The file is
+ *           sized for all records of the run before the tests start, so
+ *           appending a record neither allocates memory, nor grows the file,
+ *           nor formats any text. Threads measuring concurrently append to
+ *           their own block of records reserved before they start, so they
+ *           share neither a lock nor a counter. The reader maps the file read-only and
+ *           computes the derived series (e.g. startWrite_to_endRead) on the
+ *           first access.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef CAPTURE_FILE_H
+#define CAPTURE_FILE_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <map>
+#include <vector>
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+#define CAPTURE_MAGIC          "LATCAPT"
+#define CAPTURE_VERSION        1
+#define CAPTURE_HEADER_SIZE    4096
+
+/// Size in bytes by which the capture file grows in reserve().
+#define CAPTURE_CHUNK_SIZE     (16 * 1024 * 1024)
+
+/// Number of latency probes with derived series (probe0 ... probe3)
+#define CAPTURE_MAX_PROBES     4
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Type of a capture record
+enum CaptureRecordType {
+  CAPTURE_INTERRUPT            = 1,   ///< Interrupt self-test: digital write and interrupt
+  CAPTURE_SERIAL               = 2,   ///< Serial write/read with optional Arduino interrupt
+  CAPTURE_CONCURRENT_INTERRUPT = 3,   ///< Interrupt self-test run concurrently to the serial test
+  CAPTURE_CONCURRENT_SERIAL    = 4,   ///< Serial write/read run concurrently to the interrupt self-test
+  CAPTURE_WAKEUP               = 16,  ///< Timer wakeup test, plus the index of the method
+  CAPTURE_PROBE                = 32   ///< Message of a latency probe, plus the index of the probe
+};
+
+/// Header of a capture file
+struct CaptureHeader {
+  char     magic[8];              ///< CAPTURE_MAGIC
+  uint32_t version_ui;            ///< CAPTURE_VERSION
+  uint32_t headerSize_ui;         ///< CAPTURE_HEADER_SIZE
+  uint32_t recordSize_ui;         ///< sizeof(CaptureRecord)
+  uint32_t reserved_ui;
+  uint64_t numRecords_ui;         ///< Number of valid records
+  uint64_t startRealtimeNs_ui;    ///< CLOCK_REALTIME at the start of the capture
+  uint64_t startMonotonicNs_ui;   ///< CLOCK_MONOTONIC_RAW at the start of the capture
+  int32_t  ftdiLatencyMs_i;       ///< FTDI latency timer or -1
+  uint32_t payloadSize_ui;        ///< Number of bytes sent at once
+  uint32_t rateHz_ui;             ///< Frequency of the timed serial test
+  uint32_t reserved2_ui;
+  char     hostname[64];
+  char     kernel[128];           ///< Kernel release (uname -r)
+  char     machine[32];           ///< Machine (uname -m)
+  char     board[32];             ///< Board the test was built or run for
+  char     driver[16];            ///< GPIO interrupt driver: kmod, userspace or none
+  char     device[64];            ///< Serial device
+  char     comment[256];          ///< Free text, e.g. the load profile
+};
+
+/// A single capture record
+struct CaptureRecord {
+  uint32_t type_ui;               ///< CaptureRecordType
+  uint32_t sequence_ui;           ///< Iteration of the test
+  uint64_t beforeWriteNs_ui;      ///< Before the write (or the expected wakeup)
+  uint64_t afterWriteNs_ui;       ///< After the write
+  uint64_t afterReadNs_ui;        ///< After the read (or the actual wakeup)
+  uint64_t interruptNs_ui;        ///< Time of the interrupt, 0 if none
+};
+
+
+/*****************************************************************************
+ * CLASSES
+ ******************************************************************************/
+/// Records of a capture file reserved for a single thread by
+/// CaptureWriter::reserveBlock(). Without a capture, the block is empty and
+/// appending does nothing.
+class CaptureBlock {
+ public:
+  CaptureBlock() : m_records_p(NULL), m_capacity_ui(0), m_numRecords_ui(0) {}
+
+  /// Append a record. Records beyond the reserved ones are dropped.
+  inline void append(const uint32_t f_type_ui,
+                     const uint32_t f_sequence_ui,
+                     const uint64_t f_beforeWriteNs_ui,
+                     const uint64_t f_afterWriteNs_ui,
+                     const uint64_t f_afterReadNs_ui,
+                     const uint64_t f_interruptNs_ui) {
+    if (m_numRecords_ui >= m_capacity_ui)
+      return;
+    CaptureRecord& record = m_records_p[m_numRecords_ui++];
+    record.type_ui          = f_type_ui;
+    record.sequence_ui      = f_sequence_ui;
+    record.beforeWriteNs_ui = f_beforeWriteNs_ui;
+    record.afterWriteNs_ui  = f_afterWriteNs_ui;
+    record.afterReadNs_ui   = f_afterReadNs_ui;
+    record.interruptNs_ui   = f_interruptNs_ui;
+  }
+
+ private:
+  friend class CaptureWriter;
+
+  CaptureRecord* m_records_p;
+  uint64_t       m_capacity_ui;
+  uint64_t       m_numRecords_ui;
+};
+
+
+/// Writer of a capture file using a locked, memory mapped buffer.
+class CaptureWriter {
+ public:
+  CaptureWriter();
+  ~CaptureWriter();
+
+  bool open(const std::string&   fr_fileName,
+            const CaptureHeader& fr_header,
+            const uint64_t       f_numRecords_ui);
+  void close();
+  bool isOpen() const { return m_handle_i >= 0; }
+  bool reserve(const uint64_t f_numRecords_ui);
+  void reserveBlock(const uint64_t f_numRecords_ui,
+                    CaptureBlock&  fr_block);
+
+  /// Append a record of the thread owning the writer. Never grows the file:
+  /// records beyond the reserved ones are counted as dropped. Threads
+  /// measuring concurrently append to their own CaptureBlock instead.
+  inline void append(const uint32_t f_type_ui,
+                     const uint32_t f_sequence_ui,
+                     const uint64_t f_beforeWriteNs_ui,
+                     const uint64_t f_afterWriteNs_ui,
+                     const uint64_t f_afterReadNs_ui,
+                     const uint64_t f_interruptNs_ui) {
+    if (m_header_p->numRecords_ui >= m_capacity_ui) {
+      ++m_numDropped_ui;
+      return;
+    }
+    CaptureRecord& record = m_records_p[m_header_p->numRecords_ui];
+    record.type_ui          = f_type_ui;
+    record.sequence_ui      = f_sequence_ui;
+    record.beforeWriteNs_ui = f_beforeWriteNs_ui;
+    record.afterWriteNs_ui  = f_afterWriteNs_ui;
+    record.afterReadNs_ui   = f_afterReadNs_ui;
+    record.interruptNs_ui   = f_interruptNs_ui;
+    ++m_header_p->numRecords_ui;
+  }
+
+ private:
+  bool mapChunk(const size_t f_newSize_ui);
+
+  int              m_handle_i;
+  void*            m_map_p;
+  size_t           m_mapSize_ui;
+  CaptureHeader*   m_header_p;
+  CaptureRecord*   m_records_p;
+  uint64_t         m_capacity_ui;
+  uint64_t         m_numDropped_ui;
+  bool             m_locked_b;
+  bool             m_hasBlocks_b;
+};
+
+
+/// Reader of a capture file with lazily computed derived series.
+class CaptureReader {
+ public:
+  CaptureReader();
+  ~CaptureReader();
+
+  bool open(const std::string& fr_fileName);
+  void close();
+
+  const CaptureHeader& header() const   { return *m_header_p; }
+  uint64_t             numRecords() const { return m_numRecords_ui; }
+  const CaptureRecord& record(const uint64_t f_idx_ui) const { return m_records_p[f_idx_ui]; }
+
+  const std::vector<int64_t>* series(const std::string& fr_name);
+
+  static const char* const* seriesNames();
+
+ private:
+  int                                         m_handle_i;
+  void*                                       m_map_p;
+  size_t                                      m_mapSize_ui;
+  const CaptureHeader*                        m_header_p;
+  const CaptureRecord*                        m_records_p;
+  uint64_t                                    m_numRecords_ui;
+  std::map<std::string, std::vector<int64_t> > m_series;
+};
+
+
+/*****************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+void captureInitializeHeader(CaptureHeader& fr_header);
+
+#endif /* CAPTURE_FILE_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,661 @@
+/* ********************************* FILE ************************************/
+/** \file    ftraceSnapshot.cpp
+ *
+ * \brief    This file describes the ftrace based capture of kernel trace
+ *           snapshots on latency outliers.
+ *
+ *           While a test is running, the kernel tracer keeps recording into
+ *           its ring buffer and each iteration is marked via trace_marker.
+ *           If a sample exceeds the configured limit, the ring buffer is
+ *           swapped into the snapshot buffer. A thread with the lowest
+ *           priority saves it to a file named after the series and the
+ *           sample index, so the measurement continues undisturbed. Until
+ *           the snapshot is saved, further outliers are only listed in the
+ *           index, which is written at the end. The tracing state found at
+ *           the start is restored on every exit of the program.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+/// Number of samples required before the percentile threshold is used.
+#define FTRACE_PERCENTILE_WARMUP   100
+
+/// Number of samples after which the percentile threshold is recalculated.
+#define FTRACE_PERCENTILE_UPDATE   100
+
+/// Maximum number of snapshots saved per run.
+#define FTRACE_MAX_SNAPSHOTS       100
+
+/// Maximum number of outliers listed in the index per run.
+#define FTRACE_MAX_INDEX_ENTRIES   10000
+
+/// File listing all saved snapshots together with their sample index.
+#define FTRACE_INDEX_FILE          "ftrace_snapshots.txt"
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "ftraceSnapshot.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// An outlier listed in the index file
+struct FtraceIndexEntry {
+  char     series[64];
+  char     test[64];
+  uint32_t iteration_ui;
+  uint32_t sampleIdx_ui;
+  float    valueMs_f;
+  float    thresholdMs_f;
+  char     fileName[128];   ///< Snapshot file, "-" if the snapshot buffer was busy
+};
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+static bool        g_ftraceEnabled_b        = false;
+static std::string g_ftraceDir;
+static int         g_ftraceMarkerHandle_i   = -1;
+static FILE*       g_ftraceIndexFile_p      = NULL;
+static float       g_ftracePercentile_f     = 0.0f;
+static float       g_ftraceLimitMs_f        = 0.0f;
+static uint32_t    g_ftraceNumSnapshots_ui  = 0;
+static std::mutex  g_ftraceSnapshotMutex;
+
+// Index of the outliers, allocated at the start and written at the end
+static std::vector<FtraceIndexEntry> g_ftraceIndex;
+static uint64_t                      g_ftraceNumOutliers_ui = 0;
+
+// Tracing state found at the start and restored on shutdown
+static bool                     g_ftraceStateSaved_b        = false;
+static bool                     g_ftraceWasOn_b             = false;
+static bool                     g_ftraceSnapshotAllocated_b = false;
+static std::vector<std::string> g_ftraceEnabledEvents;
+
+// The saver thread copies the snapshot buffer into the file of the pending
+// snapshot. It is woken by the event handle.
+static pthread_t          g_ftraceSaverThread;
+static bool               g_ftraceSaverRunning_b  = false;
+static int                g_ftraceSaverHandle_i   = -1;
+static std::atomic<bool>  g_ftraceSavePending_b(false);
+static std::atomic<bool>  g_ftraceSaverStop_b(false);
+static char               g_ftracePendingFileName[128];
+static int32_t            g_ftraceMeasurementCpu_i = -1;
+
+// Iteration of the last marker and the snapshot taken within it, so
+// several series exceeding their limit in the same iteration share one
+// snapshot. Kept per thread, as tests may run concurrently.
+static thread_local char     g_ftraceMarkerTest[64];
+static thread_local uint32_t g_ftraceMarkerIteration_ui = 0;
+static thread_local bool     g_ftraceSnapshotTaken_b    = false;
+static thread_local char     g_ftraceSnapshotFileName[128];
+
+/// Trace events enabled for the snapshots. Missing events are ignored.
+static const char* g_ftraceEvents_p[] = {
+  "sched/sched_switch",
+  "sched/sched_wakeup",
+  "irq/irq_handler_entry",
+  "irq/irq_handler_exit",
+  "irq/softirq_entry",
+  "irq/softirq_exit",
+  "xhci-hcd",
+  "dwc2",
+  NULL
+};
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Write a value into a file of the tracing directory.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_fileName - File name relative to the tracing directory.
+ * \param[in] f_value_p   - Value to write.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool writeTracingFile(const std::string& fr_fileName,
+                             const char*        f_value_p)
+{
+    const std::string fileName = g_ftraceDir + "/" + fr_fileName;
+    const int handle_i = open(fileName.c_str(), O_WRONLY | O_TRUNC);
+
+    if (handle_i < 0) {
+        return false;
+    }
+
+    const ssize_t len_i     = strlen(f_value_p);
+    const bool    retVal_b  = (write(handle_i, f_value_p, len_i) == len_i);
+    close(handle_i);
+
+    return retVal_b;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Read the beginning of a file of the tracing directory.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_fileName - File name relative to the tracing directory.
+ * \return    Returns the first 64 characters at most, or an empty string if
+ *            the file can't be read.
+ *
+ *****************************************************************************/
+static std::string readTracingFile(const std::string& fr_fileName)
+{
+    const std::string fileName = g_ftraceDir + "/" + fr_fileName;
+    const int handle_i = open(fileName.c_str(), O_RDONLY);
+
+    if (handle_i < 0) {
+        return "";
+    }
+
+    char buffer[64];
+    const ssize_t read_i = read(handle_i, buffer, sizeof(buffer));
+    close(handle_i);
+
+    return (read_i > 0) ? std::string(buffer, read_i) : std::string();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Copy the content of the snapshot buffer into a file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_fileName - The output file name.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool saveSnapshot(const std::string& fr_fileName)
+{
+    const std::string snapshotFileName = g_ftraceDir + "/snapshot";
+    const int inHandle_i = open(snapshotFileName.c_str(), O_RDONLY);
+
+    if (inHandle_i < 0) {
+        return false;
+    }
+
+    FILE* outFile_p = fopen(fr_fileName.c_str(), "w");
+    if (!outFile_p) {
+        close(inHandle_i);
+        return false;
+    }
+
+    char    buffer[16384];
+    ssize_t read_i;
+    while ((read_i = read(inHandle_i, buffer, sizeof(buffer))) > 0) {
+        fwrite(buffer, 1, read_i, outFile_p);
+    }
+
+    fclose(outFile_p);
+    close(inHandle_i);
+
+    return (read_i == 0);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Main loop of the thread saving the snapshots.
+ *
+ *            The thread runs with the lowest priority and, if possible,
+ *            away from the CPU of the measurement. It waits on the event
+ *            handle and saves the pending snapshot.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns \c NULL.
+ *
+ *****************************************************************************/
+static void* ftraceSaverMain(void* /*f_arg_p*/)
+{
+    setpriority(PRIO_PROCESS, pid_t(syscall(SYS_gettid)), 19);
+    const int32_t numCpus_i = int32_t(sysconf(_SC_NPROCESSORS_ONLN));
+    if ((numCpus_i > 1) && (g_ftraceMeasurementCpu_i >= 0)) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int32_t cpu_i = 0; cpu_i < numCpus_i; ++cpu_i) {
+            if (cpu_i != g_ftraceMeasurementCpu_i)
+                CPU_SET(cpu_i, &cpus);
+        }
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+
+    for (;;) {
+        uint64_t value_ui;
+        if (read(g_ftraceSaverHandle_i, &value_ui, sizeof(value_ui)) != sizeof(value_ui)) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (g_ftraceSavePending_b.load(std::memory_order_acquire)) {
+            if (!saveSnapshot(g_ftracePendingFileName)) {
+                printf("Warning: Can't save ftrace snapshot to %s!\n", g_ftracePendingFileName);
+            }
+            writeTracingFile("snapshot", "2");
+            g_ftraceSavePending_b.store(false, std::memory_order_release);
+        }
+
+        if (g_ftraceSaverStop_b.load())
+            break;
+    }
+
+    return NULL;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Restore the tracing state found by ftraceInitialize(): disable
+ *            the events enabled by it, stop the tracer if it was off and free
+ *            the snapshot buffer if it was not allocated.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+static void restoreTracingState()
+{
+    if (!g_ftraceStateSaved_b)
+        return;
+
+    for (size_t i = 0; i < g_ftraceEnabledEvents.size(); ++i) {
+        writeTracingFile("events/" + g_ftraceEnabledEvents[i] + "/enable", "0");
+    }
+    if (!g_ftraceWasOn_b && !writeTracingFile("tracing_on", "0")) {
+        printf("Warning: Can't disable tracing in %s again!\n", g_ftraceDir.c_str());
+    }
+    if (!g_ftraceSnapshotAllocated_b) {
+        writeTracingFile("snapshot", "0");
+    }
+
+    g_ftraceEnabledEvents.clear();
+    g_ftraceStateSaved_b = false;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Initialize the ftrace snapshot capture.
+ *
+ *            If neither a percentile nor an absolute limit is given, the
+ *            capture stays disabled and all other functions are no-ops.
+ *            Otherwise, the tracing state is saved and ftraceShutdown() is
+ *            registered with atexit(), so the state is restored however the
+ *            program ends. The calling thread is the measurement thread.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_percentile_f - Percentile (0..100) of the series above which a
+ *                             snapshot is taken, or 0 to disable.
+ * \param[in] f_limitMs_f    - Absolute limit in milliseconds above which a
+ *                             snapshot is taken, or 0 to disable.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool ftraceInitialize(const float f_percentile_f,
+                      const float f_limitMs_f)
+{
+    if ((f_percentile_f <= 0.0f) && (f_limitMs_f <= 0.0f)) {
+        return true;
+    }
+
+    struct stat buffer;
+    if (stat("/sys/kernel/tracing/trace_marker", &buffer) == 0) {
+        g_ftraceDir = "/sys/kernel/tracing";
+    } else if (stat("/sys/kernel/debug/tracing/trace_marker", &buffer) == 0) {
+        g_ftraceDir = "/sys/kernel/debug/tracing";
+    } else {
+        printf("Error: Can't find the ftrace directory! Is tracefs mounted and are you root?\n");
+        return false;
+    }
+
+    // Remember the state before changing anything
+    static bool registered_b = false;
+    if (!registered_b) {
+        atexit(&ftraceShutdown);
+        registered_b = true;
+    }
+    g_ftraceWasOn_b             = (readTracingFile("tracing_on").compare(0, 1, "1") == 0);
+    g_ftraceSnapshotAllocated_b = (readTracingFile("snapshot").find("NOT ALLOCATED") == std::string::npos);
+    g_ftraceEnabledEvents.clear();
+    g_ftraceStateSaved_b        = true;
+
+    // Events enabled by the user, completely or in parts, are left alone
+    for (uint32_t i = 0; g_ftraceEvents_p[i] != NULL; ++i) {
+        const std::string enableFileName = std::string("events/") + g_ftraceEvents_p[i] + "/enable";
+        const std::string state          = readTracingFile(enableFileName);
+        if (state.compare(0, 1, "0") != 0) {
+            if (state.empty())
+                printf("Warning: Can't enable trace event %s.\n", g_ftraceEvents_p[i]);
+            continue;
+        }
+        if (writeTracingFile(enableFileName, "1"))
+            g_ftraceEnabledEvents.push_back(g_ftraceEvents_p[i]);
+        else
+            printf("Warning: Can't enable trace event %s.\n", g_ftraceEvents_p[i]);
+    }
+
+    // Allocate the snapshot buffer and clear it again.
+    if (!writeTracingFile("snapshot", "1") || !writeTracingFile("snapshot", "2")) {
+        printf("Error: Can't allocate the ftrace snapshot buffer! Is CONFIG_TRACER_SNAPSHOT enabled?\n");
+        return false;
+    }
+
+    if (!writeTracingFile("tracing_on", "1")) {
+        printf("Error: Can't enable tracing in %s!\n", g_ftraceDir.c_str());
+        return false;
+    }
+
+    const std::string markerFileName = g_ftraceDir + "/trace_marker";
+    g_ftraceMarkerHandle_i = open(markerFileName.c_str(), O_WRONLY);
+    if (g_ftraceMarkerHandle_i < 0) {
+        printf("Error: Can't open %s!\n", markerFileName.c_str());
+        return false;
+    }
+
+    g_ftraceIndexFile_p = fopen(FTRACE_INDEX_FILE, "w");
+    if (!g_ftraceIndexFile_p) {
+        printf("Error: Can't create %s!\n", FTRACE_INDEX_FILE);
+        close(g_ftraceMarkerHandle_i);
+        g_ftraceMarkerHandle_i = -1;
+        return false;
+    }
+    fprintf(g_ftraceIndexFile_p, "# ftrace snapshots. Columns: series, test:iteration, sample index, "
+            "value [ms], threshold [ms], snapshot file (- if the snapshot buffer was busy)\n");
+    g_ftraceIndex.clear();
+    g_ftraceIndex.reserve(FTRACE_MAX_INDEX_ENTRIES);
+    g_ftraceNumOutliers_ui = 0;
+
+    // The snapshots are saved by a thread, which must not inherit a
+    // real-time policy of the measurement
+    g_ftraceMeasurementCpu_i = sched_getcpu();
+    g_ftraceSaverHandle_i    = eventfd(0, 0);
+    g_ftraceSavePending_b    = false;
+    g_ftraceSaverStop_b      = false;
+
+    pthread_attr_t attributes;
+    struct sched_param parameters;
+    memset(&parameters, 0, sizeof(parameters));
+    pthread_attr_init(&attributes);
+    pthread_attr_setinheritsched(&attributes, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attributes, SCHED_OTHER);
+    pthread_attr_setschedparam(&attributes, &parameters);
+    g_ftraceSaverRunning_b = ((g_ftraceSaverHandle_i >= 0) &&
+                              (pthread_create(&g_ftraceSaverThread, &attributes, &ftraceSaverMain, NULL) == 0));
+    pthread_attr_destroy(&attributes);
+    if (!g_ftraceSaverRunning_b) {
+        printf("Error: Can't start the thread saving the ftrace snapshots!\n");
+        return false;
+    }
+
+    g_ftracePercentile_f    = f_percentile_f;
+    g_ftraceLimitMs_f       = f_limitMs_f;
+    g_ftraceNumSnapshots_ui = 0;
+    g_ftraceEnabled_b       = true;
+
+    printf("Info: Capturing ftrace snapshots from %s on outliers", g_ftraceDir.c_str());
+    if (f_percentile_f > 0.0f)
+        printf(" above the %.2f%% percentile", f_percentile_f);
+    if (f_limitMs_f > 0.0f)
+        printf(" above %.3f ms", f_limitMs_f);
+    printf(".\n");
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if the ftrace snapshot capture is enabled.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns \c true if enabled, otherwise \c false.
+ *
+ *****************************************************************************/
+bool ftraceEnabled()
+{
+    return g_ftraceEnabled_b;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Shut down the ftrace snapshot capture: save the pending
+ *            snapshot, write the index and restore the tracing state.
+ *
+ *            Registered with atexit() by ftraceInitialize(), calling it
+ *            again does nothing.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void ftraceShutdown()
+{
+    if (g_ftraceSaverRunning_b) {
+        const uint64_t wakeup_ui = 1;
+        g_ftraceSaverStop_b = true;
+        if (write(g_ftraceSaverHandle_i, &wakeup_ui, sizeof(wakeup_ui)) == sizeof(wakeup_ui))
+            pthread_join(g_ftraceSaverThread, NULL);
+        g_ftraceSaverRunning_b = false;
+    }
+    if (g_ftraceSaverHandle_i >= 0) {
+        close(g_ftraceSaverHandle_i);
+        g_ftraceSaverHandle_i = -1;
+    }
+    if (g_ftraceMarkerHandle_i >= 0) {
+        close(g_ftraceMarkerHandle_i);
+        g_ftraceMarkerHandle_i = -1;
+    }
+
+    if (g_ftraceIndexFile_p) {
+        for (size_t i = 0; i < g_ftraceIndex.size(); ++i) {
+            const FtraceIndexEntry& entry = g_ftraceIndex[i];
+            fprintf(g_ftraceIndexFile_p, "%s %s:%u %u %.6f %.6f %s\n", entry.series, entry.test,
+                    entry.iteration_ui, entry.sampleIdx_ui, entry.valueMs_f, entry.thresholdMs_f,
+                    entry.fileName);
+        }
+        if (g_ftraceNumOutliers_ui > g_ftraceIndex.size())
+            fprintf(g_ftraceIndexFile_p, "# %llu further outliers are not listed\n",
+                    (unsigned long long) (g_ftraceNumOutliers_ui - g_ftraceIndex.size()));
+        fclose(g_ftraceIndexFile_p);
+        g_ftraceIndexFile_p = NULL;
+    }
+
+    restoreTracingState();
+
+    if (g_ftraceEnabled_b) {
+        g_ftraceEnabled_b = false;
+        printf("Info: Saved %d ftrace snapshots of %llu outliers (see %s).\n", g_ftraceNumSnapshots_ui,
+               (unsigned long long) g_ftraceNumOutliers_ui, FTRACE_INDEX_FILE);
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Initialize the outlier detection state of a series.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[out] fr_trigger - The trigger to initialize.
+ * \param[in]  f_name_p   - Name of the series.
+ *
+ *****************************************************************************/
+void ftraceInitTrigger(FtraceTrigger& fr_trigger,
+                       const char*    f_name_p)
+{
+    fr_trigger.name          = f_name_p;
+    fr_trigger.thresholdMs_f = 0.0f;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Write the marker of a test iteration into the trace.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_test_p       - Name of the test.
+ * \param[in] f_iteration_ui - Iteration of the test.
+ *
+ *****************************************************************************/
+void ftraceMarker(const char*    f_test_p,
+                  const uint32_t f_iteration_ui)
+{
+    if (!g_ftraceEnabled_b)
+        return;
+
+    char buffer[128];
+    const int len_i = snprintf(buffer, sizeof(buffer), "latencyTest: %s iteration %u\n",
+                               f_test_p, f_iteration_ui);
+    if (write(g_ftraceMarkerHandle_i, buffer, len_i) != len_i) {
+        // Ignore, a lost marker must not stop the test.
+    }
+
+    snprintf(g_ftraceMarkerTest, sizeof(g_ftraceMarkerTest), "%s", f_test_p);
+    g_ftraceMarkerIteration_ui = f_iteration_ui;
+    g_ftraceSnapshotTaken_b    = false;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check the last recorded sample of a series and take a snapshot
+ *            if it exceeds the percentile threshold or the absolute limit.
+ *
+ *            A snapshot is taken at most once per iteration. Further series
+ *            exceeding their limit in the same iteration are linked to the
+ *            same snapshot file. Taking a snapshot only swaps the buffers,
+ *            it is saved by the saver thread. While it is not saved yet, no
+ *            further snapshot is taken.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_trigger   - The outlier detection state of the series.
+ * \param[in]     fr_histogram - The histogram of the series with the sample
+ *                               already recorded.
+ * \param[in]     f_valueNs_i  - The sample in nanoseconds.
+ * \return    Returns \c true if the sample is an outlier, otherwise \c false.
+ *
+ *****************************************************************************/
+bool ftraceCheckSample(FtraceTrigger&      fr_trigger,
+                       const HdrHistogram& fr_histogram,
+                       const int64_t       f_valueNs_i)
+{
+    if (!g_ftraceEnabled_b || (fr_histogram.count() == 0))
+        return false;
+
+    const uint32_t sampleIdx_ui = fr_histogram.count() - 1;
+    const float    valueMs_f    = float(f_valueNs_i) / 1000000.0f;
+
+    // Update the percentile threshold from the histogram
+    if ((g_ftracePercentile_f > 0.0f) &&
+        (sampleIdx_ui >= FTRACE_PERCENTILE_WARMUP) &&
+        ((sampleIdx_ui % FTRACE_PERCENTILE_UPDATE) == 0)) {
+        fr_trigger.thresholdMs_f = float(fr_histogram.percentile(g_ftracePercentile_f)) / 1000000.0f;
+    }
+
+    float thresholdMs_f = fr_trigger.thresholdMs_f;
+    if ((g_ftraceLimitMs_f > 0.0f) &&
+        ((thresholdMs_f == 0.0f) || (g_ftraceLimitMs_f < thresholdMs_f))) {
+        thresholdMs_f = g_ftraceLimitMs_f;
+    }
+
+    if ((thresholdMs_f == 0.0f) || (valueMs_f <= thresholdMs_f))
+        return false;
+
+    std::lock_guard<std::mutex> lock(g_ftraceSnapshotMutex);
+    if (!g_ftraceSnapshotTaken_b) {
+        // Beyond the maximum number of snapshots, the outliers are still
+        // counted and indexed without a snapshot
+        strcpy(g_ftraceSnapshotFileName, "-");
+        if ((g_ftraceNumSnapshots_ui < FTRACE_MAX_SNAPSHOTS) &&
+            !g_ftraceSavePending_b.load(std::memory_order_acquire)) {
+            char buffer[256];
+            const int len_i = snprintf(buffer, sizeof(buffer),
+                                       "latencyTest: outlier %s sample %u = %.6f ms (threshold %.6f ms)\n",
+                                       fr_trigger.name.c_str(), sampleIdx_ui, valueMs_f, thresholdMs_f);
+            if (write(g_ftraceMarkerHandle_i, buffer, len_i) != len_i) {
+                // Ignore, the snapshot is still useful without the marker.
+            }
+
+            if (writeTracingFile("snapshot", "1")) {
+                const uint64_t wakeup_ui = 1;
+                snprintf(g_ftraceSnapshotFileName, sizeof(g_ftraceSnapshotFileName), "ftrace_%s_%u.txt",
+                         fr_trigger.name.c_str(), sampleIdx_ui);
+                memcpy(g_ftracePendingFileName, g_ftraceSnapshotFileName, sizeof(g_ftracePendingFileName));
+                g_ftraceSavePending_b.store(true, std::memory_order_release);
+                if (write(g_ftraceSaverHandle_i, &wakeup_ui, sizeof(wakeup_ui)) != sizeof(wakeup_ui)) {
+                    // Ignore, the snapshot is saved on shutdown.
+                }
+                ++g_ftraceNumSnapshots_ui;
+            }
+        }
+
+        g_ftraceSnapshotTaken_b = true;
+    }
+
+    ++g_ftraceNumOutliers_ui;
+    if (g_ftraceIndex.size() < FTRACE_MAX_INDEX_ENTRIES) {
+        FtraceIndexEntry entry;
+        snprintf(entry.series,   sizeof(entry.series),   "%s", fr_trigger.name.c_str());
+        snprintf(entry.test,     sizeof(entry.test),     "%s", g_ftraceMarkerTest);
+        snprintf(entry.fileName, sizeof(entry.fileName), "%s", g_ftraceSnapshotFileName);
+        entry.iteration_ui  = g_ftraceMarkerIteration_ui;
+        entry.sampleIdx_ui  = sampleIdx_ui;
+        entry.valueMs_f     = valueMs_f;
+        entry.thresholdMs_f = thresholdMs_f;
+        g_ftraceIndex.push_back(entry);
+    }
+
+    return true;
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,56 @@
+/* ********************************* FILE ************************************/
+/** \file    ftraceSnapshot.h
+ *
+ * \brief    This file describes the interface to the ftrace based capture of
+ *           kernel trace snapshots on latency outliers.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef FTRACE_SNAPSHOT_H
+#define FTRACE_SNAPSHOT_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <string>
+
+#include "hdrHistogram.h"
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Outlier detection state of a single time series.
+struct FtraceTrigger {
+  std::string name;           ///< Name of the series, used in the snapshot file names.
+  float       thresholdMs_f;  ///< Current percentile threshold in ms (0 = not yet known).
+};
+
+
+/*****************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+bool ftraceInitialize(const float f_percentile_f,
+                      const float f_limitMs_f);
+bool ftraceEnabled();
+void ftraceShutdown();
+
+void ftraceInitTrigger(FtraceTrigger& fr_trigger,
+                       const char*    f_name_p);
+void ftraceMarker(const char*    f_test_p,
+                  const uint32_t f_iteration_ui);
+bool ftraceCheckSample(FtraceTrigger&      fr_trigger,
+                       const HdrHistogram& fr_histogram,
+                       const int64_t       f_valueNs_i);
+
+#endif /* FTRACE_SNAPSHOT_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
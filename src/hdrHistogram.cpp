@@ -0,0 +1,317 @@
+/* ********************************* FILE ************************************/
+/** \file    hdrHistogram.cpp
+ *
+ * \brief    This file describes a high dynamic range histogram of latencies
+ *           in nanoseconds.
+ *
+ *           The bucket layout follows the HdrHistogram of Gil Tene: the value
+ *           range is split into buckets of powers of two, and each bucket is
+ *           split into linear sub-buckets so that the relative error of a
+ *           value stays below the configured number of significant digits.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "hdrHistogram.h"
+
+#include <math.h>
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Constructor.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_significantDigits_ui - Number of significant decimal digits
+ *                                     (1..5) kept for each value.
+ * \param[in] f_highestTrackableNs_i - The highest value in nanoseconds. Larger
+ *                                     values are recorded as this value and
+ *                                     counted as overflows.
+ *
+ *****************************************************************************/
+HdrHistogram::HdrHistogram(const uint32_t f_significantDigits_ui,
+                           const int64_t  f_highestTrackableNs_i)
+    : m_significantDigits_ui(f_significantDigits_ui),
+      m_highestTrackableNs_i(f_highestTrackableNs_i)
+{
+    if (m_significantDigits_ui < 1)
+        m_significantDigits_ui = 1;
+    if (m_significantDigits_ui > 5)
+        m_significantDigits_ui = 5;
+    if (m_highestTrackableNs_i < 2)
+        m_highestTrackableNs_i = 2;
+
+    const double   largestSingleUnitResolution_d = 2.0 * pow(10.0, double(m_significantDigits_ui));
+    const uint32_t subBucketCountMagnitude_ui    = uint32_t(ceil(log2(largestSingleUnitResolution_d)));
+
+    m_subBucketHalfCountMagnitude_ui = subBucketCountMagnitude_ui - 1;
+    m_subBucketHalfCount_ui          = 1u << m_subBucketHalfCountMagnitude_ui;
+    m_subBucketMask_ui               = (uint64_t(1) << subBucketCountMagnitude_ui) - 1;
+
+    // Number of power of two buckets required to cover the highest value
+    uint64_t smallestUntrackable_ui = uint64_t(1) << subBucketCountMagnitude_ui;
+    uint32_t bucketCount_ui         = 1;
+    while (smallestUntrackable_ui <= uint64_t(m_highestTrackableNs_i)) {
+        smallestUntrackable_ui <<= 1;
+        ++bucketCount_ui;
+    }
+
+    const size_t countsLen_ui = size_t(bucketCount_ui + 1) * m_subBucketHalfCount_ui;
+    m_positiveCounts.resize(countsLen_ui);
+    m_negativeCounts.resize(countsLen_ui);
+
+    reset();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Add all values of another histogram to this one.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_other - The other histogram. It must use the same number of
+ *                       significant digits and highest trackable value.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool HdrHistogram::merge(const HdrHistogram& fr_other)
+{
+    if ((fr_other.m_significantDigits_ui != m_significantDigits_ui) ||
+        (fr_other.m_positiveCounts.size() != m_positiveCounts.size())) {
+        return false;
+    }
+
+    if (fr_other.m_count_ui == 0)
+        return true;
+
+    for (size_t i = 0; i < m_positiveCounts.size(); ++i) {
+        m_positiveCounts[i] += fr_other.m_positiveCounts[i];
+        m_negativeCounts[i] += fr_other.m_negativeCounts[i];
+    }
+
+    if ((m_count_ui == 0) || (fr_other.m_minNs_i < m_minNs_i))
+        m_minNs_i = fr_other.m_minNs_i;
+    if ((m_count_ui == 0) || (fr_other.m_maxNs_i > m_maxNs_i))
+        m_maxNs_i = fr_other.m_maxNs_i;
+    m_sumNs_d         += fr_other.m_sumNs_d;
+    m_count_ui        += fr_other.m_count_ui;
+    m_numOverflows_ui += fr_other.m_numOverflows_ui;
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Remove all values from the histogram.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void HdrHistogram::reset()
+{
+    for (size_t i = 0; i < m_positiveCounts.size(); ++i) {
+        m_positiveCounts[i] = 0;
+        m_negativeCounts[i] = 0;
+    }
+    m_count_ui        = 0;
+    m_numOverflows_ui = 0;
+    m_minNs_i         = 0;
+    m_maxNs_i         = 0;
+    m_sumNs_d         = 0.0;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the lowest value that is recorded in the same counter.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_countsIdx_ui - Index into the counts array.
+ * \return    Returns the lowest equivalent value in nanoseconds.
+ *
+ *****************************************************************************/
+int64_t HdrHistogram::lowestEquivalentValue(const uint32_t f_countsIdx_ui) const
+{
+    int32_t bucketIdx_i    = int32_t(f_countsIdx_ui >> m_subBucketHalfCountMagnitude_ui) - 1;
+    int32_t subBucketIdx_i = int32_t(f_countsIdx_ui & (m_subBucketHalfCount_ui - 1)) + int32_t(m_subBucketHalfCount_ui);
+
+    if (bucketIdx_i < 0) {
+        subBucketIdx_i -= m_subBucketHalfCount_ui;
+        bucketIdx_i     = 0;
+    }
+
+    return int64_t(subBucketIdx_i) << bucketIdx_i;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the highest value that is recorded in the same counter.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_countsIdx_ui - Index into the counts array.
+ * \return    Returns the highest equivalent value in nanoseconds.
+ *
+ *****************************************************************************/
+int64_t HdrHistogram::highestEquivalentValue(const uint32_t f_countsIdx_ui) const
+{
+    int32_t bucketIdx_i = int32_t(f_countsIdx_ui >> m_subBucketHalfCountMagnitude_ui) - 1;
+
+    if (bucketIdx_i < 0)
+        bucketIdx_i = 0;
+
+    return lowestEquivalentValue(f_countsIdx_ui) + (int64_t(1) << bucketIdx_i) - 1;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the value at a given percentile.
+ *
+ *            The result is the highest value equivalent to the recorded
+ *            value at the percentile, limited to the recorded minimum and
+ *            maximum. So the 0% and 100% percentiles give the exact minimum
+ *            and maximum.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_percentile_d - The percentile (0..100).
+ * \return    Returns the value at the percentile in nanoseconds.
+ *
+ *****************************************************************************/
+int64_t HdrHistogram::percentile(const double f_percentile_d) const
+{
+    if (m_count_ui == 0)
+        return 0;
+    if (f_percentile_d <= 0.0)
+        return m_minNs_i;
+
+    return valueAtRank(uint64_t(ceil(f_percentile_d / 100.0 * double(m_count_ui))));
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the value of a given rank, i.e., the order statistic.
+ *
+ *            Like percentile(), the result is the highest equivalent value,
+ *            limited to the recorded minimum and maximum.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_rank_ui - The rank (1..count), clamped to this range.
+ * \return    Returns the value of the rank in nanoseconds.
+ *
+ *****************************************************************************/
+int64_t HdrHistogram::valueAtRank(uint64_t f_rank_ui) const
+{
+    if (m_count_ui == 0)
+        return 0;
+    if (f_rank_ui < 1)
+        f_rank_ui = 1;
+    if (f_rank_ui > m_count_ui)
+        f_rank_ui = m_count_ui;
+
+    int64_t  value_i = m_maxNs_i;
+    uint64_t cumulative_ui = 0;
+    bool     found_b = false;
+
+    // Negative values from the largest magnitude down to zero...
+    for (size_t i = m_negativeCounts.size(); (i > 0) && !found_b; --i) {
+        cumulative_ui += m_negativeCounts[i-1];
+        if (cumulative_ui >= f_rank_ui) {
+            value_i = -lowestEquivalentValue(i-1);
+            found_b = true;
+        }
+    }
+
+    // ...followed by the positive values
+    for (size_t i = 0; (i < m_positiveCounts.size()) && !found_b; ++i) {
+        cumulative_ui += m_positiveCounts[i];
+        if (cumulative_ui >= f_rank_ui) {
+            value_i = highestEquivalentValue(i);
+            found_b = true;
+        }
+    }
+
+    if (value_i < m_minNs_i)
+        value_i = m_minNs_i;
+    if (value_i > m_maxNs_i)
+        value_i = m_maxNs_i;
+
+    return value_i;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the memory used by the counters in bytes.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns the memory size in bytes.
+ *
+ *****************************************************************************/
+size_t HdrHistogram::memorySize() const
+{
+    return (m_positiveCounts.size() + m_negativeCounts.size()) * sizeof(uint64_t);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Save the cumulative distribution of all non-empty counters.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_file_p - The opened output file.
+ *
+ *****************************************************************************/
+void HdrHistogram::save(FILE* f_file_p) const
+{
+    fprintf(f_file_p, "# Cumulative distribution (%u significant digits). "
+            "Columns: value [ms], percentile, count.\n", m_significantDigits_ui);
+
+    uint64_t cumulative_ui = 0;
+    for (size_t i = m_negativeCounts.size(); i > 0; --i) {
+        if (m_negativeCounts[i-1] > 0) {
+            cumulative_ui += m_negativeCounts[i-1];
+            fprintf(f_file_p, "%.6f %.6f %llu\n", double(-lowestEquivalentValue(i-1)) / 1000000.0,
+                    100.0 * double(cumulative_ui) / double(m_count_ui),
+                    (unsigned long long) cumulative_ui);
+        }
+    }
+    for (size_t i = 0; i < m_positiveCounts.size(); ++i) {
+        if (m_positiveCounts[i] > 0) {
+            cumulative_ui += m_positiveCounts[i];
+            fprintf(f_file_p, "%.6f %.6f %llu\n", double(highestEquivalentValue(i)) / 1000000.0,
+                    100.0 * double(cumulative_ui) / double(m_count_ui),
+                    (unsigned long long) cumulative_ui);
+        }
+    }
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
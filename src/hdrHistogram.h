@@ -0,0 +1,108 @@
+/* ********************************* FILE ************************************/
+/** \file    hdrHistogram.h
+ *
+ * \brief    This file describes a high dynamic range histogram of latencies
+ *           in nanoseconds.
+ *
+ *           The histogram uses a fixed amount of memory, determined by the
+ *           highest trackable value and the number of significant digits,
+ *           and records a value in constant time. Negative values (e.g., an
+ *           interrupt timestamp taken before the end of the digital write)
+ *           are recorded in a second set of buckets by their magnitude.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef HDR_HISTOGRAM_H
+#define HDR_HISTOGRAM_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+
+/*****************************************************************************
+ * CLASS
+ ******************************************************************************/
+/// High dynamic range histogram of nanosecond values.
+class HdrHistogram {
+ public:
+  HdrHistogram(const uint32_t f_significantDigits_ui = 3,
+               const int64_t  f_highestTrackableNs_i = 10000000000LL);
+
+  /// Record a value in nanoseconds.
+  inline void record(const int64_t f_valueNs_i) {
+    int64_t magnitude_i = (f_valueNs_i < 0) ? -f_valueNs_i : f_valueNs_i;
+    if (magnitude_i > m_highestTrackableNs_i) {
+      magnitude_i = m_highestTrackableNs_i;
+      ++m_numOverflows_ui;
+    }
+
+    if (f_valueNs_i < 0)
+      ++m_negativeCounts[countsIndex(magnitude_i)];
+    else
+      ++m_positiveCounts[countsIndex(magnitude_i)];
+
+    if ((m_count_ui == 0) || (f_valueNs_i < m_minNs_i))
+      m_minNs_i = f_valueNs_i;
+    if ((m_count_ui == 0) || (f_valueNs_i > m_maxNs_i))
+      m_maxNs_i = f_valueNs_i;
+    m_sumNs_d += double(f_valueNs_i);
+    ++m_count_ui;
+  }
+
+  bool     merge(const HdrHistogram& fr_other);
+  void     reset();
+
+  uint64_t count() const        { return m_count_ui; }
+  uint64_t numOverflows() const { return m_numOverflows_ui; }
+  int64_t  min() const          { return m_minNs_i; }
+  int64_t  max() const          { return m_maxNs_i; }
+  double   mean() const         { return (m_count_ui > 0) ? m_sumNs_d / double(m_count_ui) : 0.0; }
+  int64_t  percentile(const double f_percentile_d) const;
+  int64_t  valueAtRank(uint64_t f_rank_ui) const;
+  uint32_t significantDigits() const { return m_significantDigits_ui; }
+  size_t   memorySize() const;
+
+  void     save(FILE* f_file_p) const;
+
+ private:
+  /// Get the index into the counts array of a non-negative value.
+  inline uint32_t countsIndex(const int64_t f_magnitude_i) const {
+    const int32_t bucketIdx_i    = 63 - __builtin_clzll(uint64_t(f_magnitude_i) | m_subBucketMask_ui)
+                                   - int32_t(m_subBucketHalfCountMagnitude_ui);
+    const int32_t subBucketIdx_i = int32_t(f_magnitude_i >> bucketIdx_i);
+    return uint32_t(((bucketIdx_i + 1) << m_subBucketHalfCountMagnitude_ui) +
+                    (subBucketIdx_i - int32_t(m_subBucketHalfCount_ui)));
+  }
+
+  int64_t lowestEquivalentValue(const uint32_t f_countsIdx_ui) const;
+  int64_t highestEquivalentValue(const uint32_t f_countsIdx_ui) const;
+
+  uint32_t              m_significantDigits_ui;
+  int64_t               m_highestTrackableNs_i;
+  uint32_t              m_subBucketHalfCountMagnitude_ui;
+  uint32_t              m_subBucketHalfCount_ui;
+  uint64_t              m_subBucketMask_ui;
+
+  std::vector<uint64_t> m_positiveCounts;
+  std::vector<uint64_t> m_negativeCounts;
+  uint64_t              m_count_ui;
+  uint64_t              m_numOverflows_ui;
+  int64_t               m_minNs_i;
+  int64_t               m_maxNs_i;
+  double                m_sumNs_d;
+};
+
+#endif /* HDR_HISTOGRAM_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -5,15 +5,14 @@
 
 MODULE_LICENSE("GPL");
 
-#if defined(ON_RASPBERRY_PI)
-  #define GPIO_PIN_INTTEST_IN 26
-  #define GPIO_PIN_ARDUINO_IN 4
-#elif defined(ON_ODROID_XU4)
-  #define GPIO_PIN_INTTEST_IN 22
-  #define GPIO_PIN_ARDUINO_IN 33
-#else
-  #error "No platform specified via define ON_RASPBERRY_PI or ON_ODROID_XU4"
-#endif
+/* The GPIO numbers of the board, e.g. from 'latencyTest --print-board' */
+static int inttest_gpio = -1;
+module_param(inttest_gpio, int, 0444);
+MODULE_PARM_DESC(inttest_gpio, "GPIO number of the input of the interrupt latency test");
+
+static int arduino_gpio = -1;
+module_param(arduino_gpio, int, 0444);
+MODULE_PARM_DESC(arduino_gpio, "GPIO number of the signal from the Arduino");
 
 
 static volatile u32 inttest_counter_ui = 0;
@@ -47,10 +46,10 @@ static irqreturn_t gpiotiming_arduino_irq_handler(int f_irq_ui,
 }
 
 
-static const int gpio_inttest_pin_i = GPIO_PIN_INTTEST_IN;
+static int gpio_inttest_pin_i = -1;
 static int irq_on_inttest_gpio_i = -1;
 
-static const int gpio_arduino_pin_i = GPIO_PIN_ARDUINO_IN;
+static int gpio_arduino_pin_i = -1;
 static int irq_on_arduino_gpio_i = -1;
 
 
@@ -202,6 +201,13 @@ void gpiotiming_sysfs_exit(void) {
 
 static int __init gpiotiming_init(void){
   printk(KERN_INFO "GPIOTiming: starting...\n");
+  if ((inttest_gpio < 0) || (arduino_gpio < 0)) {
+    printk(KERN_ERR "GPIOTiming: Please specify the module parameters inttest_gpio and arduino_gpio!\n");
+    return -EINVAL;
+  }
+  gpio_inttest_pin_i = inttest_gpio;
+  gpio_arduino_pin_i = arduino_gpio;
+
   gpiotiming_sysfs_init();
   inttest_counter_ui = 0;
   update_inttest_timestamp();
@@ -0,0 +1,730 @@
+/* ********************************* FILE ************************************/
+/** \file    latencyAnalyzer.cpp
+ *
+ * \brief    This file describes the main entry point of the latencyAnalyzer
+ *           tool, a native replacement of results/template/generateHistogram.py.
+ *
+ *           For a single file, the tool accepts the same options and writes
+ *           the same output (statistics on stdout, histogram data *.gpd,
+ *           plot script *.gpi and settings *.gps) as the Python script.
+ *           With --all, all time series below a directory are analyzed in
+ *           parallel using the bin settings of generateHistograms.sh.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "latencySeries.h"
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Options of the analysis, see generateHistogram.py
+struct AnalyzerOptions {
+  double scaleFactor_d;
+  double binWidth_d;
+  double binStart_d;
+  double minModeFrequency_d;
+};
+
+/// Analysis of a single time series
+struct AnalyzerJob {
+  std::string     inputFile;        ///< The gnuplot data input file
+  std::string     directory;        ///< Output directory ("" or ending with '/')
+  std::string     histogramFile;    ///< Base name of the output files
+  AnalyzerOptions options;
+  off_t           size_i;           ///< Size of the input file
+};
+
+/// Bin settings of a series differing from the defaults (generateHistograms.sh)
+struct AnalyzerSeriesDefaults {
+  const char* name_p;
+  double      binWidth_d;
+  double      binStart_d;
+};
+
+/// A mode of the histogram
+struct HistogramMode {
+  double value_d;
+  double frequency_d;
+};
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+static const AnalyzerSeriesDefaults g_seriesDefaults[] = {
+  { "startWrite_to_endRead",   10.0, 5.0 },
+  { "startWrite_to_interrupt", 10.0, 5.0 },
+  { NULL,                       0.0, 0.0 }
+};
+
+
+/*****************************************************************************
+ * CLASS
+ ******************************************************************************/
+/// Histogram with the mode detection of generateHistogram.py.
+class Histogram {
+ public:
+  Histogram(const double f_binWidth_d,
+            const double f_binStart_d)
+      : m_binWidth_d(f_binWidth_d),
+        m_binStart_d(f_binStart_d),
+        m_binIdxOffset_i(0),
+        m_sum_ui(0) {}
+
+  int64_t binIndex(const double f_value_d) const {
+    return int64_t(floor((f_value_d - m_binStart_d) / m_binWidth_d));
+  }
+
+  double binIdxToValue(const int64_t f_idx_i) const {
+    return m_binWidth_d * double(f_idx_i) + m_binWidth_d * 0.5 + m_binStart_d;
+  }
+
+  void calculate(const std::vector<double>& fr_data,
+                 const double               f_min_d,
+                 const double               f_max_d);
+  void getModes(const double                f_minFrequency_d,
+                std::vector<HistogramMode>& fr_modes) const;
+  bool save(const std::string& fr_fileName) const;
+
+ private:
+  double                m_binWidth_d;
+  double                m_binStart_d;
+  int64_t               m_binIdxOffset_i;
+  uint64_t              m_sum_ui;
+  std::vector<uint64_t> m_histogram;
+};
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Calculate the histogram.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_data - The data in any order.
+ * \param[in] f_min_d - The minimum of the data.
+ * \param[in] f_max_d - The maximum of the data.
+ *
+ *****************************************************************************/
+void Histogram::calculate(const std::vector<double>& fr_data,
+                          const double               f_min_d,
+                          const double               f_max_d)
+{
+    m_binIdxOffset_i = binIndex(f_min_d);
+    m_histogram.assign(binIndex(f_max_d) - m_binIdxOffset_i + 1, 0);
+    m_sum_ui = fr_data.size();
+
+    for (size_t i = 0; i < fr_data.size(); ++i)
+        ++m_histogram[binIndex(fr_data[i]) - m_binIdxOffset_i];
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the modes of the histogram.
+ *
+ *            A mode is a local maximum with a frequency of at least the
+ *            given minimum frequency and at least half the frequency of the
+ *            global maximum.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  f_minFrequency_d - Minimum frequency of a mode in percent.
+ * \param[out] fr_modes         - The modes sorted by their frequency in
+ *                                descending order.
+ *
+ *****************************************************************************/
+void Histogram::getModes(const double                f_minFrequency_d,
+                         std::vector<HistogramMode>& fr_modes) const
+{
+    const size_t numBins_ui = m_histogram.size();
+
+    // Non-maxima suppression
+    std::vector<uint64_t> filtered(numBins_ui, 0);
+    uint64_t              maxValue_ui = 0;
+    for (size_t i = 0; i < numBins_ui; ++i) {
+        if ((i == 0) || (m_histogram[i - 1] < m_histogram[i])) {
+            if ((i == numBins_ui - 1) || (m_histogram[i] > m_histogram[i + 1]))
+                filtered[i] = m_histogram[i];
+        }
+        maxValue_ui = std::max(maxValue_ui, filtered[i]);
+    }
+
+    const int64_t minValue1_i = int64_t(double(m_sum_ui) * f_minFrequency_d / 100.0);
+    const int64_t minValue2_i = int64_t(0.5 * double(maxValue_ui));
+    const int64_t minValue_i  = std::max(minValue1_i, minValue2_i);
+
+    fr_modes.clear();
+    for (size_t i = 0; i < numBins_ui; ++i) {
+        if (int64_t(filtered[i]) >= minValue_i) {
+            HistogramMode mode;
+            mode.value_d     = binIdxToValue(int64_t(i) + m_binIdxOffset_i);
+            mode.frequency_d = double(m_histogram[i]) * 100.0 / double(m_sum_ui);
+            fr_modes.push_back(mode);
+        }
+    }
+
+    std::stable_sort(fr_modes.begin(), fr_modes.end(),
+                     [](const HistogramMode& a, const HistogramMode& b) { return a.frequency_d > b.frequency_d; });
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Save the histogram as a gnuplot data file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_fileName - The output file name.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool Histogram::save(const std::string& fr_fileName) const
+{
+    FILE* file_p = fopen(fr_fileName.c_str(), "w");
+    if (!file_p) {
+        printf("Error: Can't create %s!\n", fr_fileName.c_str());
+        return false;
+    }
+
+    fprintf(file_p, "# Gnuplot histogram data.\n");
+    for (size_t i = 0; i < m_histogram.size(); ++i)
+        fprintf(file_p, "%f %f\n", binIdxToValue(int64_t(i) + m_binIdxOffset_i),
+                double(m_histogram[i]) * 100.0 / double(m_sum_ui));
+    fclose(file_p);
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the usage and exit.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_progName_p - Name of the program.
+ *
+ *****************************************************************************/
+void usage(const char* f_progName_p)
+{
+    printf("Usage: %s [<Options>] <inputfile> <histogramfile>\n"
+           "       %s [<Options>] --all <directory>\n"
+           "\n"
+           "Calculate the histogram from the collected values and other statistical\n"
+           "properties.\n"
+           "\n"
+           "Arguments:\n"
+           "  inputfile:     The gnuplot data input file.\n"
+           "  histogramfile: The gnuplot data output file to write the histogram to.\n"
+           "                 The data is stored in a file with the suffix .gpd. A\n"
+           "                 plot script to show the histogram is written to a file\n"
+           "                 with the suffix .gpi and settings are written to a file\n"
+           "                 with the suffix .gps.\n"
+           "\n"
+           "Options:\n"
+           "  -h|--help:      Print this help.\n"
+           "  -s|--scale-factor F: The scale factor applied to all input data items.\n"
+           "                  For example, values stored in the input file are in\n"
+           "                  nanoseconds, but the histogram is specified and\n"
+           "                  generated in microseconds. [default: 1000.0]\n"
+           "  -w|--bin-width W: The bin width. [default: 1.0]\n"
+           "  --bin-start S:  The bin start. [default: 0.5]\n"
+           "  --min-mode-frequency P: The minimum frequency of a bin in percent to\n"
+           "                  be used in the mode detection. [default: 10.0]\n"
+           "  --all DIR:      Analyze all time series (*.gpd except *_histogram.gpd)\n"
+           "                  below DIR in parallel. Each <name>.gpd is written to\n"
+           "                  <name>_histogram.* in its directory, using the bin\n"
+           "                  settings of generateHistograms.sh unless -w or\n"
+           "                  --bin-start is given. Only a summary is printed.\n"
+           "  -j|--jobs N:    Number of threads of --all [default: number of cores].\n",
+           f_progName_p, f_progName_p);
+    exit(1);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Select the values at the given ranks, as if the data was sorted.
+ *
+ *            Instead of sorting the data, the ranks are selected in
+ *            ascending order with std::nth_element(), each on the remaining
+ *            part of the data.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_data  - The data, reordered on return.
+ * \param[in]     fr_ranks - The ranks, sorted in ascending order.
+ *
+ *****************************************************************************/
+void selectRanks(std::vector<double>&       fr_data,
+                 const std::vector<size_t>& fr_ranks)
+{
+    size_t first_ui = 0;
+    for (size_t i = 0; i < fr_ranks.size(); ++i) {
+        if (fr_ranks[i] < first_ui)
+            continue;
+        std::nth_element(fr_data.begin() + first_ui, fr_data.begin() + fr_ranks[i], fr_data.end());
+        first_ui = fr_ranks[i] + 1;
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Analyze a time series like generateHistogram.py.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_job    - The input and output files and the options.
+ * \param[in] f_print_b - If \c true, print the statistics on stdout.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool analyze(const AnalyzerJob& fr_job,
+             const bool         f_print_b)
+{
+    std::vector<double> data;
+    if (!loadTimeSeries(fr_job.inputFile, data))
+        return false;
+    if (data.empty()) {
+        printf("Error: No data in %s!\n", fr_job.inputFile.c_str());
+        return false;
+    }
+
+    // Scale the data and determine the basic statistics
+    const size_t numRecords_ui = data.size();
+    double       minimum_d     = data[0] * fr_job.options.scaleFactor_d;
+    double       maximum_d     = minimum_d;
+    for (size_t i = 0; i < numRecords_ui; ++i) {
+        data[i] *= fr_job.options.scaleFactor_d;
+        minimum_d = std::min(minimum_d, data[i]);
+        maximum_d = std::max(maximum_d, data[i]);
+    }
+
+    // Quantiles (50% quantile is median). For an even number of elements,
+    // the mean of the element at the index and its successor is used.
+    const bool          evenRecords_b = ((numRecords_ui % 2) == 0);
+    std::vector<size_t> ranks;
+    for (size_t q = 5; q < 100; q += 5) {
+        const size_t idx_ui = (numRecords_ui - 1) * q / 100;
+        ranks.push_back(idx_ui);
+        if (evenRecords_b)
+            ranks.push_back(idx_ui + 1);
+    }
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+    selectRanks(data, ranks);
+
+    double quantiles_d[100];
+    for (size_t q = 5; q < 100; q += 5) {
+        const size_t idx_ui = (numRecords_ui - 1) * q / 100;
+        quantiles_d[q] = evenRecords_b ? (data[idx_ui] + data[idx_ui + 1]) / 2.0 : data[idx_ui];
+    }
+
+    // Histogram and modes. If no mode is found, the bin width is increased.
+    double                     binWidth_d = fr_job.options.binWidth_d;
+    Histogram                  histogram(binWidth_d, fr_job.options.binStart_d);
+    std::vector<HistogramMode> modes;
+    histogram.calculate(data, minimum_d, maximum_d);
+    histogram.getModes(fr_job.options.minModeFrequency_d, modes);
+
+    while (modes.empty()) {
+        binWidth_d += 1.0;
+        histogram = Histogram(binWidth_d, binWidth_d / 2.0);
+        histogram.calculate(data, minimum_d, maximum_d);
+        histogram.getModes(fr_job.options.minModeFrequency_d, modes);
+    }
+
+    if (f_print_b) {
+        printf("data_records = %zu\n", numRecords_ui);
+        printf("data_min = %f\n", minimum_d);
+        printf("data_max = %f\n", maximum_d);
+        for (size_t q = 5; q < 100; q += 5)
+            printf("data_quantile_%zu = %f\n", q, quantiles_d[q]);
+        printf("histogram_num_modes = %zu\n", modes.size());
+        for (size_t i = 0; i < modes.size(); ++i) {
+            printf("histogram_mode_%zu = %f\n", i, modes[i].value_d);
+            printf("histogram_mode_%zu_frequency = %f\n", i, modes[i].frequency_d);
+        }
+    }
+
+    const std::string outputBase = fr_job.directory + fr_job.histogramFile;
+    if (!histogram.save(outputBase + ".gpd"))
+        return false;
+
+    // Settings
+    FILE* file_p = fopen((outputBase + ".gps").c_str(), "w");
+    if (!file_p) {
+        printf("Error: Can't create %s.gps!\n", outputBase.c_str());
+        return false;
+    }
+    fprintf(file_p,
+            "# Settings of histogram\n"
+            "# Include this file using the gnuplot load command\n"
+            "bin_width = %f\n"
+            "data_records = %zu\n"
+            "data_min = %f\n"
+            "data_max = %f\n",
+            binWidth_d, numRecords_ui, minimum_d, maximum_d);
+    for (size_t q = 5; q < 100; q += 5)
+        fprintf(file_p, "data_quantile_%zu = %f\n", q, quantiles_d[q]);
+    fprintf(file_p, "histogram_num_modes = %zu\n", modes.size());
+    for (size_t i = 0; i < modes.size(); ++i) {
+        fprintf(file_p, "histogram_mode_%zu = %f\n", i, modes[i].value_d);
+        fprintf(file_p, "histogram_mode_%zu_frequency = %f\n", i, modes[i].frequency_d);
+    }
+    fclose(file_p);
+
+    // Plot script. It refers to the other files relative to its directory.
+    file_p = fopen((outputBase + ".gpi").c_str(), "w");
+    if (!file_p) {
+        printf("Error: Can't create %s.gpi!\n", outputBase.c_str());
+        return false;
+    }
+
+    char buffer[256];
+    std::string statsString;
+    snprintf(buffer, sizeof(buffer), "range     = [%.2f;%.2f]\\n", minimum_d, maximum_d);
+    statsString += buffer;
+    snprintf(buffer, sizeof(buffer), "80%% range = [%.2f;%.2f]\\n", quantiles_d[10], quantiles_d[90]);
+    statsString += buffer;
+    snprintf(buffer, sizeof(buffer), "median    = %.2f\\n", quantiles_d[50]);
+    statsString += buffer;
+    statsString += "modes     = ";
+    for (size_t i = 0; i < modes.size(); ++i) {
+        snprintf(buffer, sizeof(buffer), "%s%.1f (%.1f%%)", (i > 0) ? ", " : "",
+                 modes[i].value_d, modes[i].frequency_d);
+        statsString += buffer;
+    }
+
+    fprintf(file_p,
+            "\n"
+            "# Plot the histogram. Load this file with previously set up output and title, e.g.:\n"
+            "\n"
+            "# set title \"Interrupt latency (Write Start to Interrupt)\"\n"
+            "# set output \"interrupt_latency_write_start_to_interrupt.png\"\n"
+            "# load \"%s.gpi\"\n"
+            "\n"
+            "load \"%s.gps\"\n"
+            "\n"
+            "set boxwidth bin_width\n"
+            "set style fill solid 0.5 # fill style\n"
+            "\n"
+            "set xlabel \"Time [microseconds]\"\n"
+            "set ylabel \"Frequency [percent]\"\n"
+            "\n"
+            "set grid ytics lt 0 lw 1 lc rgb \"#bbbbbb\"\n"
+            "set grid xtics lt 0 lw 1 lc rgb \"#bbbbbb\"\n"
+            "\n"
+            "# Remove any previous arrows and labels\n"
+            "unset arrow\n"
+            "unset label\n"
+            "\n"
+            "# Show median\n"
+            "set arrow 1 from data_quantile_50, graph 0.90 to data_quantile_50, graph 0.0 fill front\n"
+            "set label 1 at data_quantile_50, graph 0.95 \"median\" center offset 0,1 front  rotate by 90\n"
+            "\n"
+            "# Show statistic info\n"
+            "set label 2 at graph 0.10, graph 0.90 \"%s\" left offset 0,1 front\n"
+            "\n"
+            "# Show modes\n",
+            fr_job.histogramFile.c_str(), fr_job.histogramFile.c_str(), statsString.c_str());
+
+    for (size_t i = 0; i < modes.size(); ++i) {
+        fprintf(file_p, "set arrow %zu from %f, graph 0.90 to %f, graph 0.0 fill front\n",
+                i + 3, modes[i].value_d, modes[i].value_d);
+        fprintf(file_p, "set label %zu at %f, graph 0.95 \"%zu. mode\" center offset 0,1 front rotate by 90\n",
+                i + 3, modes[i].value_d, i + 1);
+    }
+
+    fprintf(file_p,
+            "\n"
+            "# Calculate plot width\n"
+            "data_width=data_quantile_90-data_quantile_10   # 80%% of all points\n"
+            "min_data_width=(data_width<bin_width)?bin_width:data_width # ensure it is at least the bin_width\n"
+            "full_width=min_data_width*10.0/8.0             # 100%% of all points\n"
+            "min_full_width=(full_width<10.0*bin_width)?10.0*bin_width:full_width\n"
+            "extended_plot_width=(min_full_width-data_width)/2.0\n"
+            "plot_start=data_quantile_10-extended_plot_width\n"
+            "plot_end=data_quantile_90+extended_plot_width\n"
+            "\n"
+            "# Plot data\n"
+            "plot [plot_start:plot_end] '%s.gpd' using 1:2 with boxes lc rgb\"red\" notitle\n",
+            fr_job.histogramFile.c_str());
+    fclose(file_p);
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Collect the analysis jobs of all time series below a directory.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_directory - The directory.
+ * \param[in]  fr_options   - The options of the command line.
+ * \param[in]  f_binSet_b   - If \c true, the bin width and start of the
+ *                            options are used for all series.
+ * \param[out] fr_jobs      - The jobs are appended to this list.
+ *
+ *****************************************************************************/
+void collectJobs(const std::string&        fr_directory,
+                 const AnalyzerOptions&    fr_options,
+                 const bool                f_binSet_b,
+                 std::vector<AnalyzerJob>& fr_jobs)
+{
+    DIR* dir_p = opendir(fr_directory.c_str());
+    if (!dir_p) {
+        printf("Warning: Can't read directory %s!\n", fr_directory.c_str());
+        return;
+    }
+
+    const std::string prefix = (fr_directory[fr_directory.size() - 1] == '/') ? fr_directory : fr_directory + "/";
+    const std::string suffix = ".gpd";
+    const std::string histogramSuffix = "_histogram.gpd";
+
+    struct dirent* entry_p;
+    while ((entry_p = readdir(dir_p)) != NULL) {
+        const std::string name = entry_p->d_name;
+        if (name[0] == '.')
+            continue;
+
+        struct stat fileStat;
+        if (stat((prefix + name).c_str(), &fileStat) != 0)
+            continue;
+
+        if (S_ISDIR(fileStat.st_mode)) {
+            collectJobs(prefix + name, fr_options, f_binSet_b, fr_jobs);
+            continue;
+        }
+
+        if ((name.size() <= suffix.size()) ||
+            (name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) ||
+            ((name.size() >= histogramSuffix.size()) &&
+             (name.compare(name.size() - histogramSuffix.size(), histogramSuffix.size(), histogramSuffix) == 0)))
+            continue;
+
+        AnalyzerJob job;
+        const std::string series = name.substr(0, name.size() - suffix.size());
+        job.inputFile     = prefix + name;
+        job.directory     = prefix;
+        job.histogramFile = series + "_histogram";
+        job.options       = fr_options;
+        job.size_i        = fileStat.st_size;
+        if (!f_binSet_b) {
+            for (uint32_t i = 0; g_seriesDefaults[i].name_p != NULL; ++i) {
+                if (series == g_seriesDefaults[i].name_p) {
+                    job.options.binWidth_d = g_seriesDefaults[i].binWidth_d;
+                    job.options.binStart_d = g_seriesDefaults[i].binStart_d;
+                }
+            }
+        }
+        fr_jobs.push_back(job);
+    }
+
+    closedir(dir_p);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Run the jobs in parallel.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_jobs        - The jobs, sorted by their size on return.
+ * \param[in]     f_numThreads_ui - Number of threads.
+ * \return    Returns the number of failed jobs.
+ *
+ *****************************************************************************/
+uint32_t runJobs(std::vector<AnalyzerJob>& fr_jobs,
+                 const uint32_t            f_numThreads_ui)
+{
+    // Start with the largest files, so the threads finish at the same time
+    std::sort(fr_jobs.begin(), fr_jobs.end(),
+              [](const AnalyzerJob& a, const AnalyzerJob& b) { return a.size_i > b.size_i; });
+
+    std::atomic<size_t>   nextJob(0);
+    std::atomic<uint32_t> numFailed(0);
+    std::vector<std::thread> threads;
+
+    for (uint32_t t = 0; t < f_numThreads_ui; ++t) {
+        threads.push_back(std::thread([&]() {
+            size_t job_ui;
+            while ((job_ui = nextJob++) < fr_jobs.size()) {
+                if (!analyze(fr_jobs[job_ui], false))
+                    ++numFailed;
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    return numFailed;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Main entry point.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_argc_i - Number of arguments.
+ * \param[in] f_argv_p - Arguments.
+ * \return    Return code of the application.
+ *
+ *****************************************************************************/
+int main(int f_argc_i, char** f_argv_p) {
+    const char* progName_p = f_argv_p[0];
+    AnalyzerOptions options;
+    options.scaleFactor_d      = 1000.0;
+    options.binWidth_d         = 1.0;
+    options.binStart_d         = 0.5;
+    options.minModeFrequency_d = 10.0;
+    bool binSet_b = false;
+    std::string allDirectory = "";
+    uint32_t numThreads_ui = std::thread::hardware_concurrency();
+    std::vector<std::string> arguments;
+
+    // Parse command line arguments
+    for (int i=1; i < f_argc_i; ++i) {
+        if ((strcmp(f_argv_p[i], "-h") == 0) ||
+            (strcmp(f_argv_p[i], "--help") == 0)) {
+            usage(progName_p);
+        }
+        else if ((strcmp(f_argv_p[i], "-s") == 0) ||
+                 (strcmp(f_argv_p[i], "--scale-factor") == 0)) {
+          if (++i < f_argc_i) {
+            options.scaleFactor_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --scale-factor option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "-w") == 0) ||
+                 (strcmp(f_argv_p[i], "--bin-width") == 0)) {
+          if (++i < f_argc_i) {
+            options.binWidth_d = atof(f_argv_p[i]);
+            binSet_b = true;
+          } else {
+            printf("Error: Expected argument after --bin-width option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--bin-start") == 0)) {
+          if (++i < f_argc_i) {
+            options.binStart_d = atof(f_argv_p[i]);
+            binSet_b = true;
+          } else {
+            printf("Error: Expected argument after --bin-start option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--min-mode-frequency") == 0)) {
+          if (++i < f_argc_i) {
+            options.minModeFrequency_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --min-mode-frequency option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--all") == 0)) {
+          if (++i < f_argc_i) {
+            allDirectory = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --all option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "-j") == 0) ||
+                 (strcmp(f_argv_p[i], "--jobs") == 0)) {
+          if (++i < f_argc_i) {
+            numThreads_ui = atoi(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --jobs option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((f_argv_p[i][0] == '-') && (f_argv_p[i][1] != '\0')) {
+            printf("Error: Unknown option %s! Please see usage for available options!\n\n",
+                   f_argv_p[i]);
+            usage(progName_p);
+        }
+        else {
+            arguments.push_back(f_argv_p[i]);
+        }
+    }
+
+    if (options.binWidth_d <= 0.0) {
+        printf("Error: The bin width must be positive!\n");
+        usage(progName_p);
+    }
+
+    if (!allDirectory.empty()) {
+        if (!arguments.empty()) {
+            printf("Error: No input file expected with --all! Please see usage for syntax!\n\n");
+            usage(progName_p);
+        }
+
+        std::vector<AnalyzerJob> jobs;
+        collectJobs(allDirectory, options, binSet_b, jobs);
+        if (numThreads_ui == 0)
+            numThreads_ui = 1;
+        numThreads_ui = std::min(numThreads_ui, uint32_t(std::max(jobs.size(), size_t(1))));
+
+        const uint32_t numFailed_ui = runJobs(jobs, numThreads_ui);
+        printf("Info: Analyzed %zu time series using %u threads.\n", jobs.size() - numFailed_ui, numThreads_ui);
+        return (numFailed_ui > 0) ? 2 : 0;
+    }
+
+    if (arguments.size() != 2) {
+        printf("Error: Expected an input file and a histogram file! Please see usage for syntax!\n\n");
+        usage(progName_p);
+    }
+
+    AnalyzerJob job;
+    job.inputFile     = arguments[0];
+    job.histogramFile = arguments[1];
+    job.options       = options;
+    job.size_i        = 0;
+
+    return analyze(job, true) ? 0 : 2;
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,767 @@
+/* ********************************* FILE ************************************/
+/** \file    latencyBench.cpp
+ *
+ * \brief    This file describes the main entry point of the latencyBench
+ *           microbenchmarks of the hot paths of latencyTest.
+ *
+ *           The timestamps, their conversion, the recording and statistics
+ *           of the series, saving the time series, the sysfs reads of the
+ *           kernel driver and the serial write/read path (against a pty
+ *           loopback) are measured, using the functions of latencyTest. The
+ *           results are saved as JSON and can be compared with a previous
+ *           run to detect added overhead. Each benchmark is repeated, so the
+ *           comparison uses the median of the repetitions and tolerates
+ *           their spread.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "hdrHistogram.h"
+#include "latencySeries.h"
+#include "serialTiming.h"
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+/// Minimum duration of a batch of iterations
+#define BENCH_MIN_BATCH_NS       2000000ULL
+
+/// Minimum and maximum number of timed batches
+#define BENCH_MIN_ROUNDS         10
+#define BENCH_MAX_ROUNDS         1000
+
+/// Number of samples of a series as recorded by the default serial test
+#define BENCH_SERIES_SIZE        1200
+
+/// Number of raw samples after which the recorded series is replaced
+#define BENCH_MAX_RECORDED       1000000
+
+/// Default number of repetitions of each benchmark
+#define BENCH_DEFAULT_REPEATS    5
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// A benchmark runs its operation the given number of times
+typedef void (*BenchFunction_t)(const uint64_t f_iterations_ui);
+
+/// Description of a benchmark
+struct Benchmark {
+  const char*     name_p;
+  const char*     description_p;
+  BenchFunction_t function_p;
+};
+
+/// Result of a benchmark, times per operation in nanoseconds
+struct BenchResult {
+  std::string name;
+  uint64_t    iterations_ui;
+  uint32_t    rounds_ui;
+  double      minNs_d;
+  double      medianNs_d;
+  double      p90Ns_d;
+  double      meanNs_d;
+  uint32_t    repeats_ui;
+  double      spreadPct_d;  ///< Largest deviation of the median of a repetition in percent
+};
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// Keeps the compiler from removing the benchmarked operations
+static volatile uint64_t g_benchSink_ui = 0;
+
+/// Fixtures of the benchmarks
+static std::string          g_benchCounterFile;
+static std::string          g_benchTimestampFile;
+static std::string          g_benchSeriesFile;
+static TimeSeries_t         g_benchTimeSeries;
+static HdrHistogram         g_benchHistogram;
+static LatencySeries*       g_benchSeries_p = NULL;
+static int                  g_benchPtyMaster_i = -1;
+static int                  g_benchPtySlave_i  = -1;
+static std::atomic<bool>    g_benchEchoStop_b(false);
+static std::thread          g_benchEchoThread;
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the usage and exit.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_progName_p - Name of the program.
+ *
+ *****************************************************************************/
+static void usage(const char* f_progName_p)
+{
+    printf("Usage: %s [<Options>]\n"
+           "\n"
+           "Run the microbenchmarks of the hot paths of latencyTest and save\n"
+           "the times per operation as JSON.\n"
+           "\n"
+           "Options:\n"
+           "  -h|--help:          Print this help.\n"
+           "  -o|--output FILE:   Save the results to FILE [default: bench.json].\n"
+           "  --filter PATTERN:   Run only the matching benchmarks [default: *].\n"
+           "  --min-time S:       Minimum duration of each benchmark in seconds\n"
+           "                      [default: 0.5].\n"
+           "  --repeat N:         Repetitions of each benchmark within its\n"
+           "                      minimum duration [default: 5]. The median of\n"
+           "                      the repetitions is the result, the largest\n"
+           "                      deviation of a repetition from it the spread.\n"
+           "  --baseline FILE:    Compare the medians with the results of a\n"
+           "                      previous run.\n"
+           "  --tolerance PCT:    Tolerated slowdown compared to the baseline in\n"
+           "                      percent [default: 10]. Widened to the sum of\n"
+           "                      the spreads of both runs for noisy benchmarks.\n"
+           "  --sysfs DIR:        Directory of the sysfs files of the kernel\n"
+           "                      driver [default: /sys/gpiotiming]. Temporary\n"
+           "                      files are used if it does not exist.\n"
+           "\n"
+           "Returns 0 on success, 3 if a benchmark is slower than the baseline\n"
+           "plus the tolerance and 2 on errors.\n",
+           f_progName_p);
+    exit(1);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the current time of the clock used by RECORD_TIME.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns the current time in nanoseconds.
+ *
+ *****************************************************************************/
+static uint64_t benchNowNs()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &t);
+    return uint64_t(t.tv_sec) * 1000000000ULL + uint64_t(t.tv_nsec);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     The benchmarks. Each one performs its operation the given
+ *            number of times.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_iterations_ui - Number of operations.
+ *
+ *****************************************************************************/
+static void benchRecordTime(const uint64_t f_iterations_ui)
+{
+    uint64_t sum_ui = 0;
+    for (uint64_t i = 0; i < f_iterations_ui; ++i)
+        sum_ui += getTimeStampNs();
+    g_benchSink_ui = sum_ui;
+}
+
+static void benchGetMilliseconds(const uint64_t f_iterations_ui)
+{
+    const uint64_t startNs_ui = g_benchSink_ui;
+    float sum_f = 0.0f;
+    for (uint64_t i = 0; i < f_iterations_ui; ++i)
+        sum_f += getMilliseconds(startNs_ui, startNs_ui + i);
+    g_benchSink_ui = uint64_t(sum_f);
+}
+
+static void benchGetMillisecondsTimespec(const uint64_t f_iterations_ui)
+{
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+    end = start;
+    float sum_f = 0.0f;
+    for (uint64_t i = 0; i < f_iterations_ui; ++i) {
+        end.tv_nsec = long(i % 1000000000);
+        sum_f += getMilliseconds(start, end);
+    }
+    g_benchSink_ui = uint64_t(sum_f);
+}
+
+static void benchGetNanoseconds(const uint64_t f_iterations_ui)
+{
+    const uint64_t startNs_ui = g_benchSink_ui;
+    int64_t sum_i = 0;
+    for (uint64_t i = 0; i < f_iterations_ui; ++i)
+        sum_i += getNanoseconds(startNs_ui, startNs_ui + i);
+    g_benchSink_ui = uint64_t(sum_i);
+}
+
+static void benchSeriesRecord(const uint64_t f_iterations_ui)
+{
+    // Limit the memory of the raw samples, this affects only a single batch
+    if (g_benchSeries_p->histogram().count() > BENCH_MAX_RECORDED) {
+        delete g_benchSeries_p;
+        g_benchSeries_p = new LatencySeries("bench", "Benchmark:", BENCH_MAX_RECORDED);
+    }
+    for (uint64_t i = 0; i < f_iterations_ui; ++i)
+        g_benchSeries_p->record(int64_t(2000000 + (i * 7919) % 300000));
+}
+
+static void benchStatistics(const uint64_t f_iterations_ui)
+{
+    // The statistics printed by LatencySeries::report()
+    int64_t sum_i = 0;
+    for (uint64_t i = 0; i < f_iterations_ui; ++i) {
+        sum_i += g_benchHistogram.percentile(50.0) + g_benchHistogram.percentile(90.0) +
+                 g_benchHistogram.percentile(99.0) + g_benchHistogram.percentile(99.9) +
+                 g_benchHistogram.percentile(99.99) + g_benchHistogram.min() + g_benchHistogram.max() +
+                 int64_t(g_benchHistogram.mean());
+    }
+    g_benchSink_ui = uint64_t(sum_i);
+}
+
+static void benchSaveTimeSeries(const uint64_t f_iterations_ui)
+{
+    for (uint64_t i = 0; i < f_iterations_ui; ++i)
+        saveTimeSeries(g_benchTimeSeries, g_benchSeriesFile);
+}
+
+static void benchGetSysfsCounter(const uint64_t f_iterations_ui)
+{
+    int64_t sum_i = 0;
+    for (uint64_t i = 0; i < f_iterations_ui; ++i)
+        sum_i += getSysfsCounter(g_benchCounterFile);
+    g_benchSink_ui = uint64_t(sum_i);
+}
+
+static void benchGetSysfsTimestamp(const uint64_t f_iterations_ui)
+{
+    uint64_t sum_ui = 0;
+    for (uint64_t i = 0; i < f_iterations_ui; ++i)
+        sum_ui += getSysfsTimestamp(g_benchTimestampFile);
+    g_benchSink_ui = sum_ui;
+}
+
+static void benchTimeWriteRead(const uint64_t f_iterations_ui)
+{
+    uint64_t before_ui, afterWrite_ui, afterRead_ui, sum_ui = 0;
+    for (uint64_t i = 0; i < f_iterations_ui; ++i) {
+        if (!timeWriteRead(g_benchPtySlave_i, uint8_t(i), before_ui, afterWrite_ui, afterRead_ui)) {
+            printf("Error: Write/Read over the pty loopback failed!\n");
+            exit(2);
+        }
+        sum_ui += afterRead_ui - before_ui;
+    }
+    g_benchSink_ui = sum_ui;
+}
+
+
+/// All benchmarks
+static const Benchmark g_benchmarks[] = {
+  { "RECORD_TIME",                 "Timestamp (clock_gettime) as used by RECORD_TIME", &benchRecordTime },
+  { "getMilliseconds",             "Difference of two timestamps in ms",               &benchGetMilliseconds },
+  { "getMilliseconds_timespec",    "Difference of two timespecs in ms",                &benchGetMillisecondsTimespec },
+  { "getNanoseconds",              "Difference of two timestamps in ns",               &benchGetNanoseconds },
+  { "LatencySeries_record",        "Record a sample (histograms and raw sample)",      &benchSeriesRecord },
+  { "statistics",                  "Statistics of a series with 1200 samples",         &benchStatistics },
+  { "saveTimeSeries",              "Save a series with 1200 samples",                  &benchSaveTimeSeries },
+  { "getSysfsCounter",             "Read a counter of the kernel driver",              &benchGetSysfsCounter },
+  { "getSysfsTimestamp",           "Read a timestamp of the kernel driver",            &benchGetSysfsTimestamp },
+  { "timeWriteRead_pty",           "Serial write/read of one byte over a pty loopback", &benchTimeWriteRead },
+};
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Echo all bytes written to the slave of the pty, like the
+ *            Arduino sketch does.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+static void echoLoop()
+{
+    uint8_t buffer[256];
+    while (!g_benchEchoStop_b) {
+        struct pollfd handle;
+        handle.fd     = g_benchPtyMaster_i;
+        handle.events = POLLIN;
+        if (poll(&handle, 1, 100) <= 0)
+            continue;
+        const ssize_t size_i = read(g_benchPtyMaster_i, buffer, sizeof(buffer));
+        if ((size_i > 0) && (write(g_benchPtyMaster_i, buffer, size_t(size_i)) != size_i))
+            break;
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Create the fixtures of the benchmarks.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_sysfsDirectory - Directory of the sysfs files.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool setupFixtures(const std::string& fr_sysfsDirectory)
+{
+    char directory[] = "/tmp/latencyBench.XXXXXX";
+    if (!mkdtemp(directory)) {
+        printf("Error: Can't create a temporary directory!\n");
+        return false;
+    }
+    g_benchSeriesFile = std::string(directory) + "/series.gpd";
+
+    if (access((fr_sysfsDirectory + "/inttest_counter").c_str(), R_OK) == 0) {
+        g_benchCounterFile   = fr_sysfsDirectory + "/inttest_counter";
+        g_benchTimestampFile = fr_sysfsDirectory + "/inttest_timestamp_ns";
+    }
+    else {
+        printf("Info: %s not found, reading temporary files instead.\n", fr_sysfsDirectory.c_str());
+        g_benchCounterFile   = std::string(directory) + "/inttest_counter";
+        g_benchTimestampFile = std::string(directory) + "/inttest_timestamp_ns";
+        FILE* file_p = fopen(g_benchCounterFile.c_str(), "w");
+        if (file_p) {
+            fprintf(file_p, "123456\n");
+            fclose(file_p);
+        }
+        file_p = fopen(g_benchTimestampFile.c_str(), "w");
+        if (file_p) {
+            fprintf(file_p, "%llu\n", (unsigned long long)getTimeStampNs());
+            fclose(file_p);
+        }
+    }
+
+    // Series like the default serial test
+    latencySeriesConfigure(true, 3, 0.0f);
+    g_benchSeries_p = new LatencySeries("bench", "Benchmark:", BENCH_MAX_RECORDED);
+    for (uint32_t i = 0; i < BENCH_SERIES_SIZE; ++i) {
+        const int64_t valueNs_i = 2000000 + int64_t(i * 7919) % 300000;
+        g_benchTimeSeries.push_back(float(valueNs_i) / 1000000.0f);
+        g_benchHistogram.record(valueNs_i);
+    }
+
+    // The pty replaces the serial port, the echo thread the Arduino
+    g_benchPtyMaster_i = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((g_benchPtyMaster_i < 0) || (grantpt(g_benchPtyMaster_i) != 0) || (unlockpt(g_benchPtyMaster_i) != 0)) {
+        printf("Error: Can't create a pty!\n");
+        return false;
+    }
+    g_benchPtySlave_i = open(ptsname(g_benchPtyMaster_i), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if ((g_benchPtySlave_i < 0) || !initializeSerialPort(g_benchPtySlave_i, 1)) {
+        printf("Error: Can't open the pty %s!\n", ptsname(g_benchPtyMaster_i));
+        return false;
+    }
+    g_benchEchoThread = std::thread(&echoLoop);
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Remove the fixtures of the benchmarks.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+static void teardownFixtures()
+{
+    if (g_benchEchoThread.joinable()) {
+        g_benchEchoStop_b = true;
+        g_benchEchoThread.join();
+    }
+    if (g_benchPtySlave_i >= 0)
+        close(g_benchPtySlave_i);
+    if (g_benchPtyMaster_i >= 0)
+        close(g_benchPtyMaster_i);
+    delete g_benchSeries_p;
+
+    const std::string directory = g_benchSeriesFile.substr(0, g_benchSeriesFile.rfind('/'));
+    unlink(g_benchSeriesFile.c_str());
+    if (g_benchCounterFile.compare(0, directory.size(), directory) == 0) {
+        unlink(g_benchCounterFile.c_str());
+        unlink(g_benchTimestampFile.c_str());
+    }
+    rmdir(directory.c_str());
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Run a benchmark.
+ *
+ *            The number of iterations per batch is doubled until a batch
+ *            takes at least 2 ms, then batches are timed until the minimum
+ *            time has elapsed. The statistics are taken over the times per
+ *            operation of the batches.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_benchmark - The benchmark.
+ * \param[in]  f_minTimeS_d - Minimum duration in seconds.
+ * \param[out] fr_result    - The result.
+ *
+ *****************************************************************************/
+static void runBenchmark(const Benchmark& fr_benchmark,
+                         const double     f_minTimeS_d,
+                         BenchResult&     fr_result)
+{
+    uint64_t batch_ui   = 1;
+    uint64_t elapsed_ui = 0;
+    while (true) {
+        const uint64_t startNs_ui = benchNowNs();
+        fr_benchmark.function_p(batch_ui);
+        elapsed_ui = benchNowNs() - startNs_ui;
+        if ((elapsed_ui >= BENCH_MIN_BATCH_NS) || (batch_ui >= (1ULL << 30)))
+            break;
+        batch_ui *= 2;
+    }
+
+    const uint64_t minTimeNs_ui = uint64_t(f_minTimeS_d * 1.0e9);
+    std::vector<double> nsPerOp;
+    uint64_t totalNs_ui = 0;
+    while ((nsPerOp.size() < BENCH_MIN_ROUNDS) ||
+           ((totalNs_ui < minTimeNs_ui) && (nsPerOp.size() < BENCH_MAX_ROUNDS))) {
+        const uint64_t startNs_ui = benchNowNs();
+        fr_benchmark.function_p(batch_ui);
+        const uint64_t durationNs_ui = benchNowNs() - startNs_ui;
+        nsPerOp.push_back(double(durationNs_ui) / double(batch_ui));
+        totalNs_ui += durationNs_ui;
+    }
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+
+    double sum_d = 0.0;
+    for (size_t i = 0; i < nsPerOp.size(); ++i)
+        sum_d += nsPerOp[i];
+
+    fr_result.name          = fr_benchmark.name_p;
+    fr_result.iterations_ui = batch_ui * nsPerOp.size();
+    fr_result.rounds_ui     = uint32_t(nsPerOp.size());
+    fr_result.minNs_d       = nsPerOp.front();
+    fr_result.medianNs_d    = nsPerOp[nsPerOp.size() / 2];
+    fr_result.p90Ns_d       = nsPerOp[std::min(nsPerOp.size() - 1, size_t(ceil(0.9 * nsPerOp.size())) - 1)];
+    fr_result.meanNs_d      = sum_d / double(nsPerOp.size());
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Run the repetitions of a benchmark.
+ *
+ *            The minimum duration is split among the repetitions. The
+ *            repetition with the median of the medians gives the result,
+ *            so a single disturbed repetition does not shift it.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_benchmark  - The benchmark.
+ * \param[in]  f_minTimeS_d  - Minimum duration in seconds.
+ * \param[in]  f_repeats_ui  - Number of repetitions.
+ * \param[out] fr_result     - The result.
+ *
+ *****************************************************************************/
+static void runRepeated(const Benchmark& fr_benchmark,
+                        const double     f_minTimeS_d,
+                        const uint32_t   f_repeats_ui,
+                        BenchResult&     fr_result)
+{
+    std::vector<BenchResult> repeats(f_repeats_ui);
+    std::vector<std::pair<double, size_t> > medians;
+    uint64_t iterations_ui = 0;
+    uint32_t rounds_ui     = 0;
+    for (uint32_t r = 0; r < f_repeats_ui; ++r) {
+        runBenchmark(fr_benchmark, f_minTimeS_d / f_repeats_ui, repeats[r]);
+        medians.push_back(std::make_pair(repeats[r].medianNs_d, size_t(r)));
+        iterations_ui += repeats[r].iterations_ui;
+        rounds_ui     += repeats[r].rounds_ui;
+    }
+    std::sort(medians.begin(), medians.end());
+
+    const double medianNs_d = medians[medians.size() / 2].first;
+    fr_result               = repeats[medians[medians.size() / 2].second];
+    fr_result.iterations_ui = iterations_ui;
+    fr_result.rounds_ui     = rounds_ui;
+    fr_result.repeats_ui    = f_repeats_ui;
+    fr_result.spreadPct_d   = 0.0;
+    if (medianNs_d > 0.0)
+        fr_result.spreadPct_d = std::max(medianNs_d - medians.front().first,
+                                         medians.back().first - medianNs_d) / medianNs_d * 100.0;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Save the results as JSON, one benchmark per line.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_fileName - The output file name.
+ * \param[in] fr_results  - The results.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool saveResults(const std::string&              fr_fileName,
+                        const std::vector<BenchResult>& fr_results)
+{
+    FILE* file_p = fopen(fr_fileName.c_str(), "w");
+    if (!file_p) {
+        printf("Error: Can't write %s!\n", fr_fileName.c_str());
+        return false;
+    }
+
+    struct utsname system;
+    uname(&system);
+    char date[32];
+    const time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    fprintf(file_p,
+            "{\n"
+            "  \"hostname\": \"%s\",\n"
+            "  \"kernel\": \"%s\",\n"
+            "  \"machine\": \"%s\",\n"
+            "  \"compiler\": \"%s\",\n"
+            "  \"date\": \"%s\",\n"
+            "  \"unit\": \"ns/op\",\n"
+            "  \"benchmarks\": [\n",
+            system.nodename, system.release, system.machine, __VERSION__, date);
+    for (size_t i = 0; i < fr_results.size(); ++i) {
+        const BenchResult& result = fr_results[i];
+        fprintf(file_p, "    {\"name\": \"%s\", \"iterations\": %llu, \"rounds\": %u, \"repeats\": %u, "
+                "\"min\": %.3f, \"median\": %.3f, \"p90\": %.3f, \"mean\": %.3f, \"spread\": %.3f}%s\n",
+                result.name.c_str(), (unsigned long long)result.iterations_ui, result.rounds_ui, result.repeats_ui,
+                result.minNs_d, result.medianNs_d, result.p90Ns_d, result.meanNs_d, result.spreadPct_d,
+                (i + 1 < fr_results.size()) ? "," : "");
+    }
+    fprintf(file_p, "  ]\n}\n");
+    fclose(file_p);
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Load the medians and spreads of a previous run saved by
+ *            saveResults(). Results without a spread get a spread of 0.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_fileName - The file name.
+ * \param[out] fr_results  - The results per benchmark name.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool loadBaseline(const std::string&                  fr_fileName,
+                         std::map<std::string, BenchResult>& fr_results)
+{
+    FILE* file_p = fopen(fr_fileName.c_str(), "r");
+    if (!file_p) {
+        printf("Error: Can't read %s!\n", fr_fileName.c_str());
+        return false;
+    }
+
+    char line[1024];
+    while (fgets(line, sizeof(line), file_p)) {
+        const char* name_p   = strstr(line, "\"name\": \"");
+        const char* median_p = strstr(line, "\"median\": ");
+        if (!name_p || !median_p)
+            continue;
+        name_p += strlen("\"name\": \"");
+        const char* end_p = strchr(name_p, '"');
+        if (!end_p)
+            continue;
+
+        BenchResult& result = fr_results[std::string(name_p, end_p - name_p)];
+        result.medianNs_d  = atof(median_p + strlen("\"median\": "));
+        const char* spread_p = strstr(line, "\"spread\": ");
+        result.spreadPct_d = spread_p ? atof(spread_p + strlen("\"spread\": ")) : 0.0;
+    }
+    fclose(file_p);
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Main entry point.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_argc_i - Number of arguments.
+ * \param[in] f_argv_p - Arguments.
+ * \return    Return code of the application.
+ *
+ *****************************************************************************/
+int main(int f_argc_i, char** f_argv_p) {
+    const char* progName_p = f_argv_p[0];
+    std::string outputFileName = "bench.json";
+    std::string filter = "*";
+    std::string baselineFileName = "";
+    std::string sysfsDirectory = "/sys/gpiotiming";
+    double minTimeS_d = 0.5;
+    double tolerancePct_d = 10.0;
+    uint32_t repeats_ui = BENCH_DEFAULT_REPEATS;
+
+    // Parse command line arguments
+    for (int i=1; i < f_argc_i; ++i) {
+        if ((strcmp(f_argv_p[i], "-h") == 0) ||
+            (strcmp(f_argv_p[i], "--help") == 0)) {
+            usage(progName_p);
+        }
+        else if ((strcmp(f_argv_p[i], "-o") == 0) ||
+                 (strcmp(f_argv_p[i], "--output") == 0)) {
+          if (++i < f_argc_i) {
+            outputFileName = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --output option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--filter") == 0)) {
+          if (++i < f_argc_i) {
+            filter = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --filter option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--min-time") == 0)) {
+          if (++i < f_argc_i) {
+            minTimeS_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --min-time option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--repeat") == 0)) {
+          if (++i < f_argc_i) {
+            repeats_ui = uint32_t(atoi(f_argv_p[i]));
+            if (repeats_ui == 0) {
+              printf("Error: Expected a positive number after --repeat option!\n");
+              usage(progName_p);
+            }
+          } else {
+            printf("Error: Expected argument after --repeat option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--baseline") == 0)) {
+          if (++i < f_argc_i) {
+            baselineFileName = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --baseline option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--tolerance") == 0)) {
+          if (++i < f_argc_i) {
+            tolerancePct_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --tolerance option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--sysfs") == 0)) {
+          if (++i < f_argc_i) {
+            sysfsDirectory = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --sysfs option!\n");
+            usage(progName_p);
+          }
+        }
+        else {
+            printf("Error: Unknown option %s! Please see usage for available options!\n\n",
+                   f_argv_p[i]);
+            usage(progName_p);
+        }
+    }
+
+    std::map<std::string, BenchResult> baseline;
+    if (!baselineFileName.empty() && !loadBaseline(baselineFileName, baseline))
+        return 2;
+
+    if (!setupFixtures(sysfsDirectory)) {
+        teardownFixtures();
+        return 2;
+    }
+
+    std::vector<BenchResult> results;
+    uint32_t numSlower_ui = 0;
+    printf("%-26s %12s %12s %12s %12s %8s\n", "Benchmark [ns/op]", "min", "median", "p90", "mean", "spread");
+    for (size_t b = 0; b < sizeof(g_benchmarks) / sizeof(g_benchmarks[0]); ++b) {
+        if (fnmatch(filter.c_str(), g_benchmarks[b].name_p, 0) != 0)
+            continue;
+
+        BenchResult result;
+        runRepeated(g_benchmarks[b], minTimeS_d, repeats_ui, result);
+        results.push_back(result);
+        printf("%-26s %12.1f %12.1f %12.1f %12.1f %7.1f%%", result.name.c_str(), result.minNs_d, result.medianNs_d,
+               result.p90Ns_d, result.meanNs_d, result.spreadPct_d);
+
+        // A change within the run-to-run spread of both runs is noise
+        std::map<std::string, BenchResult>::const_iterator previous = baseline.find(result.name);
+        if ((previous != baseline.end()) && (previous->second.medianNs_d > 0.0)) {
+            const double changePct_d    = (result.medianNs_d / previous->second.medianNs_d - 1.0) * 100.0;
+            const double toleratedPct_d = std::max(tolerancePct_d, result.spreadPct_d + previous->second.spreadPct_d);
+            const bool   slower_b       = (changePct_d > toleratedPct_d);
+            printf("  %+6.1f%% (tolerance %.1f%%)%s", changePct_d, toleratedPct_d, slower_b ? "  SLOWER" : "");
+            if (slower_b)
+                ++numSlower_ui;
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+    teardownFixtures();
+
+    if (!saveResults(outputFileName, results))
+        return 2;
+    printf("Info: Saved results to %s.\n", outputFileName.c_str());
+
+    if (numSlower_ui > 0) {
+        printf("Result: %u benchmark(s) slower than the baseline by more than their tolerance.\n", numSlower_ui);
+        return 3;
+    }
+    return 0;
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,194 @@
+/* ********************************* FILE ************************************/
+/** \file    latencyCapture.cpp
+ *
+ * \brief    This file describes the main entry point of the latencyCapture
+ *           tool to inspect and export capture files of latencyTest.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+
+#include "captureFile.h"
+#include "hdrHistogram.h"
+#include "latencySeries.h"
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the usage and exit.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_progName_p - Name of the program.
+ *
+ *****************************************************************************/
+void usage(const char* f_progName_p)
+{
+    printf("Usage: %s info <capture file>\n"
+           "       %s export <capture file> [<series> ...]\n"
+           "\n"
+           "Inspect or export a capture file written by latencyTest --capture.\n"
+           "\n"
+           "Commands:\n"
+           "  info:   Print the metadata of the run and the statistics of all\n"
+           "          series contained in the capture file.\n"
+           "  export: Save the given (default: all non-empty) series as gnuplot\n"
+           "          data files <series>.gpd in the current directory.\n"
+           "\n"
+           "Series:\n",
+           f_progName_p, f_progName_p);
+    for (const char* const* name_p = CaptureReader::seriesNames(); *name_p != NULL; ++name_p)
+        printf("  %s\n", *name_p);
+    exit(1);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the metadata and the statistics of a capture file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_reader - The opened capture file.
+ *
+ *****************************************************************************/
+void printInfo(CaptureReader& fr_reader)
+{
+    const CaptureHeader& header = fr_reader.header();
+    const time_t startTime = time_t(header.startRealtimeNs_ui / 1000000000);
+    char startTimeStr[64];
+    strftime(startTimeStr, sizeof(startTimeStr), "%Y-%m-%d %H:%M:%S", localtime(&startTime));
+
+    printf("Version:      %u\n", header.version_ui);
+    printf("Start:        %s\n", startTimeStr);
+    printf("Host:         %s (%s, kernel %s)\n", header.hostname, header.machine, header.kernel);
+    printf("Board:        %s\n", header.board);
+    printf("GPIO driver:  %s\n", header.driver);
+    printf("Device:       %s\n", header.device);
+    printf("FTDI latency: %d ms\n", header.ftdiLatencyMs_i);
+    printf("Payload size: %u bytes\n", header.payloadSize_ui);
+    printf("Rate:         %u Hz\n", header.rateHz_ui);
+    if (header.comment[0] != '\0')
+        printf("Comment:      %s\n", header.comment);
+    printf("Records:      %llu\n", (unsigned long long) fr_reader.numRecords());
+    printf("\n");
+
+    for (const char* const* name_p = CaptureReader::seriesNames(); *name_p != NULL; ++name_p) {
+        const std::vector<int64_t>* series_p = fr_reader.series(*name_p);
+        if (series_p->empty())
+            continue;
+
+        HdrHistogram histogram;
+        for (size_t i = 0; i < series_p->size(); ++i)
+            histogram.record((*series_p)[i]);
+
+        printf("%-30s %8llu samples, min = %.3f, p50 = %.3f, p99 = %.3f, p99.9 = %.3f, max = %.3f ms\n",
+               *name_p, (unsigned long long) histogram.count(),
+               double(histogram.min()) / 1000000.0,
+               double(histogram.percentile(50.0)) / 1000000.0,
+               double(histogram.percentile(99.0)) / 1000000.0,
+               double(histogram.percentile(99.9)) / 1000000.0,
+               double(histogram.max()) / 1000000.0);
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Export a series as a gnuplot data file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_reader - The opened capture file.
+ * \param[in] f_name_p  - Name of the series.
+ * \param[in] f_force_b - If \c true, export the series even if it is empty.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool exportSeries(CaptureReader& fr_reader,
+                  const char*    f_name_p,
+                  const bool     f_force_b)
+{
+    const std::vector<int64_t>* series_p = fr_reader.series(f_name_p);
+    if (!series_p) {
+        printf("Error: Unknown series %s!\n", f_name_p);
+        return false;
+    }
+    if (series_p->empty() && !f_force_b)
+        return true;
+
+    TimeSeries_t timeSeries;
+    timeSeries.reserve(series_p->size());
+    for (size_t i = 0; i < series_p->size(); ++i)
+        timeSeries.push_back(float((*series_p)[i]) / 1000000.0f);
+
+    saveTimeSeries(timeSeries, std::string(f_name_p) + ".gpd");
+    printf("Info: Exported %zu samples to %s.gpd.\n", timeSeries.size(), f_name_p);
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Main entry point.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_argc_i - Number of arguments.
+ * \param[in] f_argv_p - Arguments.
+ * \return    Return code of the application.
+ *
+ *****************************************************************************/
+int main(int f_argc_i, char** f_argv_p) {
+    const char* progName_p = f_argv_p[0];
+
+    if ((f_argc_i < 3) || (strcmp(f_argv_p[1], "-h") == 0) || (strcmp(f_argv_p[1], "--help") == 0))
+        usage(progName_p);
+
+    CaptureReader reader;
+    if (!reader.open(f_argv_p[2]))
+        return 2;
+
+    if (strcmp(f_argv_p[1], "info") == 0) {
+        printInfo(reader);
+    }
+    else if (strcmp(f_argv_p[1], "export") == 0) {
+        if (f_argc_i == 3) {
+            for (const char* const* name_p = CaptureReader::seriesNames(); *name_p != NULL; ++name_p)
+                exportSeries(reader, *name_p, false);
+        } else {
+            for (int i = 3; i < f_argc_i; ++i) {
+                if (!exportSeries(reader, f_argv_p[i], true))
+                    return 3;
+            }
+        }
+    }
+    else {
+        printf("Error: Unknown command %s! Please see usage for available commands!\n\n", f_argv_p[1]);
+        usage(progName_p);
+    }
+
+    return 0;
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
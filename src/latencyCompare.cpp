@@ -0,0 +1,748 @@
+/* ********************************* FILE ************************************/
+/** \file    latencyCompare.cpp
+ *
+ * \brief    This file describes the main entry point of the latencyCompare
+ *           tool to detect latency regressions between two runs.
+ *
+ *           For each series contained in both runs, the differences of the
+ *           quantiles (candidate - baseline) are estimated with bootstrap
+ *           confidence intervals and the distributions are compared with the
+ *           two-sample Kolmogorov-Smirnov and Anderson-Darling tests. The
+ *           exit code is non-zero if a quantile got significantly worse, so
+ *           the tool can gate kernel or adapter rollouts.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fnmatch.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "captureFile.h"
+#include "latencySeries.h"
+#include "resultsStore.h"
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// The series of a run in nanoseconds
+typedef std::map<std::string, std::vector<int64_t> > RunSeries_t;
+
+/// Options of the comparison
+struct CompareOptions {
+  std::vector<double> quantiles;        ///< Compared quantiles in percent
+  uint32_t            numResamples_ui;  ///< Number of bootstrap resamples
+  double              confidence_d;     ///< Confidence level in percent
+  double              tolerancePct_d;   ///< Tolerated increase relative to the baseline
+  double              toleranceMs_d;    ///< Tolerated absolute increase
+  bool                gateTests_b;      ///< Also fail on a significant KS and AD test
+  uint32_t            numThreads_ui;
+  uint64_t            seed_ui;
+};
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the usage and exit.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_progName_p - Name of the program.
+ *
+ *****************************************************************************/
+void usage(const char* f_progName_p)
+{
+    printf("Usage: %s [<Options>] <baseline> <candidate>\n"
+           "\n"
+           "Compare the latencies of a candidate run with a baseline run and\n"
+           "detect regressions. A run is a gnuplot data file (*.gpd), a results\n"
+           "directory containing *.gpd files or a capture file of\n"
+           "latencyTest --capture. All series contained in both runs are\n"
+           "compared. Two single *.gpd files are compared even if their names\n"
+           "differ.\n"
+           "\n"
+           "For each series, the differences of the quantiles (candidate -\n"
+           "baseline) are given with bootstrap confidence intervals, and the\n"
+           "distributions are compared with the two-sample Kolmogorov-Smirnov\n"
+           "and Anderson-Darling tests. A quantile regressed if the lower bound\n"
+           "of its confidence interval exceeds the tolerance.\n"
+           "\n"
+           "Options:\n"
+           "  -h|--help:           Print this help.\n"
+           "  --series PATTERN:    Compare only the matching series [default: *].\n"
+           "  -q|--quantiles LIST: Comma separated quantiles in percent\n"
+           "                       [default: 50,99,99.9].\n"
+           "  -b|--bootstrap N:    Number of bootstrap resamples [default: 1000].\n"
+           "  -c|--confidence P:   Confidence level in percent of the intervals\n"
+           "                       and the tests [default: 95].\n"
+           "  --tolerance PCT:     Tolerated increase in percent of the baseline\n"
+           "                       quantile [default: 1.0].\n"
+           "  --tolerance-ms MS:   Tolerated absolute increase [default: 0.0].\n"
+           "                       The larger of both tolerances is used.\n"
+           "  --gate-tests:        Also report a regression if both distribution\n"
+           "                       tests are significant and the candidate is\n"
+           "                       shifted to larger latencies.\n"
+           "  -j|--jobs N:         Number of threads [default: number of cores].\n"
+           "  --seed N:            Seed of the resampling [default: 1].\n"
+           "\n"
+           "Returns 0 if no regression was found, 3 on a regression and 2 on\n"
+           "errors.\n",
+           f_progName_p);
+    exit(1);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if a file name has a given suffix.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_name   - The file name.
+ * \param[in] f_suffix_p - The suffix.
+ * \return    Returns \c true if the name ends with the suffix.
+ *
+ *****************************************************************************/
+bool hasSuffix(const std::string& fr_name,
+               const char*        f_suffix_p)
+{
+    const size_t size_ui = strlen(f_suffix_p);
+    return (fr_name.size() >= size_ui) && (fr_name.compare(fr_name.size() - size_ui, size_ui, f_suffix_p) == 0);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Load a gnuplot data file in nanoseconds.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_fileName - The file name.
+ * \param[out] fr_values   - The values in nanoseconds.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool loadSeriesNs(const std::string&    fr_fileName,
+                  std::vector<int64_t>& fr_values)
+{
+    std::vector<double> values;
+    if (!loadTimeSeries(fr_fileName, values))
+        return false;
+
+    // The files store milliseconds with six decimals, i.e., nanoseconds
+    fr_values.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        fr_values[i] = llround(values[i] * 1000000.0);
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Load the series of a run.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_path   - A *.gpd file, a directory or a capture file.
+ * \param[out] fr_series - The non-empty series of the run.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool loadRun(const std::string& fr_path,
+             RunSeries_t&       fr_series)
+{
+    struct stat fileStat;
+    if (stat(fr_path.c_str(), &fileStat) != 0) {
+        printf("Error: %s does not exist!\n", fr_path.c_str());
+        return false;
+    }
+
+    if (S_ISDIR(fileStat.st_mode)) {
+        DIR* dir_p = opendir(fr_path.c_str());
+        if (!dir_p) {
+            printf("Error: Can't read directory %s!\n", fr_path.c_str());
+            return false;
+        }
+        struct dirent* entry_p;
+        while ((entry_p = readdir(dir_p)) != NULL) {
+            const std::string name = entry_p->d_name;
+            if (!hasSuffix(name, ".gpd") || hasSuffix(name, "_histogram.gpd"))
+                continue;
+            if (!loadSeriesNs(fr_path + "/" + name, fr_series[name.substr(0, name.size() - 4)])) {
+                closedir(dir_p);
+                return false;
+            }
+        }
+        closedir(dir_p);
+    }
+    else {
+        // Capture files are detected by their magic
+        char  magic[sizeof(CAPTURE_MAGIC)] = "";
+        FILE* file_p = fopen(fr_path.c_str(), "rb");
+        if (file_p) {
+            if (fread(magic, sizeof(magic), 1, file_p) != 1)
+                magic[0] = '\0';
+            fclose(file_p);
+        }
+
+        if (memcmp(magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) == 0) {
+            CaptureReader reader;
+            if (!reader.open(fr_path))
+                return false;
+            for (const char* const* name_p = CaptureReader::seriesNames(); *name_p != NULL; ++name_p)
+                fr_series[*name_p] = *reader.series(*name_p);
+        }
+        else {
+            std::string name = fr_path.substr(fr_path.find_last_of('/') + 1);
+            if (hasSuffix(name, ".gpd"))
+                name.erase(name.size() - 4);
+            if (!loadSeriesNs(fr_path, fr_series[name]))
+                return false;
+        }
+    }
+
+    for (RunSeries_t::iterator i = fr_series.begin(); i != fr_series.end(); ) {
+        if (i->second.empty())
+            fr_series.erase(i++);
+        else
+            ++i;
+    }
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Random number generator (splitmix64) of the resampling.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_state_ui - The state.
+ * \return    Returns the next random number.
+ *
+ *****************************************************************************/
+static inline uint64_t nextRandom(uint64_t& fr_state_ui)
+{
+    uint64_t z_ui = (fr_state_ui += 0x9e3779b97f4a7c15ULL);
+    z_ui = (z_ui ^ (z_ui >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z_ui = (z_ui ^ (z_ui >> 27)) * 0x94d049bb133111ebULL;
+    return z_ui ^ (z_ui >> 31);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Draw a sample with replacement.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]     fr_values   - The original sample.
+ * \param[in,out] fr_state_ui - State of the random number generator.
+ * \param[out]    fr_resample - The resample of the same size.
+ *
+ *****************************************************************************/
+static void resample(const std::vector<int64_t>& fr_values,
+                     uint64_t&                   fr_state_ui,
+                     std::vector<int64_t>&       fr_resample)
+{
+    const uint64_t size_ui = fr_values.size();
+    fr_resample.resize(size_ui);
+    for (uint64_t i = 0; i < size_ui; ++i)
+        fr_resample[i] = fr_values[((nextRandom(fr_state_ui) >> 32) * size_ui) >> 32];
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Bootstrap the differences of the quantiles.
+ *
+ *            Each resample has its own random number generator derived from
+ *            the seed and its index, so the result does not depend on the
+ *            number of threads.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_baseline  - The baseline sample.
+ * \param[in]  fr_candidate - The candidate sample.
+ * \param[in]  fr_options   - The options.
+ * \param[out] fr_diffs     - The differences in ns per quantile, sorted.
+ *
+ *****************************************************************************/
+void bootstrapDifferences(const std::vector<int64_t>&         fr_baseline,
+                          const std::vector<int64_t>&         fr_candidate,
+                          const CompareOptions&               fr_options,
+                          std::vector<std::vector<int64_t> >& fr_diffs)
+{
+    const size_t numQuantiles_ui = fr_options.quantiles.size();
+    fr_diffs.assign(numQuantiles_ui, std::vector<int64_t>(fr_options.numResamples_ui, 0));
+
+    std::atomic<uint32_t>    nextResample(0);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < fr_options.numThreads_ui; ++t) {
+        threads.push_back(std::thread([&]() {
+            std::vector<int64_t> baseline, candidate, baselineQuantiles, candidateQuantiles;
+            uint32_t b_ui;
+            while ((b_ui = nextResample++) < fr_options.numResamples_ui) {
+                uint64_t state_ui = fr_options.seed_ui * 0x2545f4914f6cdd1dULL + b_ui;
+                nextRandom(state_ui);
+                resample(fr_baseline, state_ui, baseline);
+                resample(fr_candidate, state_ui, candidate);
+                resultsPercentiles(baseline, fr_options.quantiles, baselineQuantiles);
+                resultsPercentiles(candidate, fr_options.quantiles, candidateQuantiles);
+                for (size_t q = 0; q < numQuantiles_ui; ++q)
+                    fr_diffs[q][b_ui] = candidateQuantiles[q] - baselineQuantiles[q];
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    for (size_t q = 0; q < numQuantiles_ui; ++q)
+        std::sort(fr_diffs[q].begin(), fr_diffs[q].end());
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Two-sample Kolmogorov-Smirnov test.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_baseline   - The sorted baseline sample.
+ * \param[in]  fr_candidate  - The sorted candidate sample.
+ * \param[out] fr_d_d        - The two-sided statistic D = max(D+, D-).
+ * \param[out] fr_dPlus_d    - Largest amount by which the distribution
+ *                             function of the baseline exceeds the one of the
+ *                             candidate, i.e., the candidate is slower.
+ * \return    Returns the asymptotic p-value of the two-sided statistic.
+ *
+ *****************************************************************************/
+double kolmogorovSmirnov(const std::vector<int64_t>& fr_baseline,
+                         const std::vector<int64_t>& fr_candidate,
+                         double&                     fr_d_d,
+                         double&                     fr_dPlus_d)
+{
+    const double n1_d = double(fr_baseline.size());
+    const double n2_d = double(fr_candidate.size());
+    size_t i1_ui = 0, i2_ui = 0;
+    double dPlus_d = 0.0, dMinus_d = 0.0;
+
+    while ((i1_ui < fr_baseline.size()) && (i2_ui < fr_candidate.size())) {
+        const int64_t value_i = std::min(fr_baseline[i1_ui], fr_candidate[i2_ui]);
+        while ((i1_ui < fr_baseline.size()) && (fr_baseline[i1_ui] == value_i))
+            ++i1_ui;
+        while ((i2_ui < fr_candidate.size()) && (fr_candidate[i2_ui] == value_i))
+            ++i2_ui;
+        const double diff_d = double(i1_ui) / n1_d - double(i2_ui) / n2_d;
+        dPlus_d  = std::max(dPlus_d, diff_d);
+        dMinus_d = std::max(dMinus_d, -diff_d);
+    }
+
+    fr_dPlus_d = dPlus_d;
+    fr_d_d     = std::max(dPlus_d, dMinus_d);
+
+    // Asymptotic distribution with the small sample correction of Stephens
+    const double en_d     = sqrt(n1_d * n2_d / (n1_d + n2_d));
+    const double lambda_d = (en_d + 0.12 + 0.11 / en_d) * fr_d_d;
+    if (lambda_d < 1.0e-3)
+        return 1.0;
+
+    double sum_d = 0.0, sign_d = 2.0;
+    for (uint32_t k = 1; k <= 100; ++k) {
+        const double term_d = sign_d * exp(-2.0 * k * k * lambda_d * lambda_d);
+        sum_d += term_d;
+        if (fabs(term_d) < 1.0e-10 * fabs(sum_d))
+            break;
+        sign_d = -sign_d;
+    }
+    return std::min(1.0, std::max(0.0, sum_d));
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Two-sample Anderson-Darling test of Scholz and Stephens (1987).
+ *
+ *            The statistic A2akN allows ties. The standardized statistic is
+ *            mapped to a p-value by interpolating the tabulated critical
+ *            values, so the p-value is limited to [0.001, 0.25].
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_baseline  - The sorted baseline sample.
+ * \param[in]  fr_candidate - The sorted candidate sample.
+ * \param[out] fr_t_d       - The standardized statistic.
+ * \return    Returns the approximate p-value.
+ *
+ *****************************************************************************/
+double andersonDarling(const std::vector<int64_t>& fr_baseline,
+                       const std::vector<int64_t>& fr_candidate,
+                       double&                     fr_t_d)
+{
+    const std::vector<int64_t>* samples_p[2] = { &fr_baseline, &fr_candidate };
+    const double n_d[2] = { double(fr_baseline.size()), double(fr_candidate.size()) };
+    const double N_d    = n_d[0] + n_d[1];
+
+    // Walk over the distinct values of the pooled sample
+    double sum_d[2] = { 0.0, 0.0 };
+    size_t idx_ui[2] = { 0, 0 };
+    double numBelow_d = 0.0;
+    while ((idx_ui[0] < fr_baseline.size()) || (idx_ui[1] < fr_candidate.size())) {
+        int64_t value_i = INT64_MAX;
+        for (uint32_t s = 0; s < 2; ++s) {
+            if (idx_ui[s] < samples_p[s]->size())
+                value_i = std::min(value_i, (*samples_p[s])[idx_ui[s]]);
+        }
+
+        double below_d[2], equal_d[2];
+        for (uint32_t s = 0; s < 2; ++s) {
+            below_d[s] = double(idx_ui[s]);
+            while ((idx_ui[s] < samples_p[s]->size()) && ((*samples_p[s])[idx_ui[s]] == value_i))
+                ++idx_ui[s];
+            equal_d[s] = double(idx_ui[s]) - below_d[s];
+        }
+
+        const double l_d     = equal_d[0] + equal_d[1];
+        const double B_d     = numBelow_d + l_d / 2.0;
+        const double denom_d = B_d * (N_d - B_d) - N_d * l_d / 4.0;
+        if (denom_d > 0.0) {
+            for (uint32_t s = 0; s < 2; ++s) {
+                const double M_d = below_d[s] + equal_d[s] / 2.0;
+                sum_d[s] += l_d / N_d * (N_d * M_d - B_d * n_d[s]) * (N_d * M_d - B_d * n_d[s]) / denom_d;
+            }
+        }
+        numBelow_d += l_d;
+    }
+    const double A2_d = (sum_d[0] / n_d[0] + sum_d[1] / n_d[1]) * (N_d - 1.0) / N_d;
+
+    // Variance of the statistic for k = 2 samples
+    const double k_d = 2.0;
+    const double H_d = 1.0 / n_d[0] + 1.0 / n_d[1];
+    double h_d = 0.0, g_d = 0.0, partial_d = 0.0;
+    for (double i_d = N_d - 1.0; i_d >= 2.0; i_d -= 1.0) {
+        partial_d += 1.0 / i_d;
+        g_d += partial_d / (N_d - i_d + 1.0);
+    }
+    h_d = partial_d + 1.0;
+    const double a_d = (4.0 * g_d - 6.0) * (k_d - 1.0) + (10.0 - 6.0 * g_d) * H_d;
+    const double b_d = (2.0 * g_d - 4.0) * k_d * k_d + 8.0 * h_d * k_d + (2.0 * g_d - 14.0 * h_d - 4.0) * H_d -
+                       8.0 * h_d + 4.0 * g_d - 6.0;
+    const double c_d = (6.0 * h_d + 2.0 * g_d - 2.0) * k_d * k_d + (4.0 * h_d - 4.0 * g_d + 6.0) * k_d +
+                       (2.0 * h_d - 6.0) * H_d + 4.0 * h_d;
+    const double d_d = (2.0 * h_d + 6.0) * k_d * k_d - 4.0 * h_d * k_d;
+    const double sigmaSq_d = (a_d * N_d * N_d * N_d + b_d * N_d * N_d + c_d * N_d + d_d) /
+                             ((N_d - 1.0) * (N_d - 2.0) * (N_d - 3.0));
+    fr_t_d = (A2_d - (k_d - 1.0)) / sqrt(sigmaSq_d);
+
+    // Critical values for k - 1 = 1 and a quadratic fit of log(significance)
+    static const double critical_d[7]     = { 0.325, 1.226, 1.961, 2.718, 3.752, 4.592, 6.546 };
+    static const double significance_d[7] = { 0.25, 0.1, 0.05, 0.025, 0.01, 0.005, 0.001 };
+    if (fr_t_d <= critical_d[0])
+        return 0.25;
+    if (fr_t_d >= critical_d[6])
+        return 0.001;
+
+    double S_d[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 }, T_d[3] = { 0.0, 0.0, 0.0 };
+    for (uint32_t i = 0; i < 7; ++i) {
+        double power_d = 1.0;
+        for (uint32_t p = 0; p < 5; ++p) {
+            S_d[p] += power_d;
+            if (p < 3)
+                T_d[p] += power_d * log(significance_d[i]);
+            power_d *= critical_d[i];
+        }
+    }
+    // Solve the normal equations with Cramer's rule
+    double M_d[3][3] = { { S_d[0], S_d[1], S_d[2] }, { S_d[1], S_d[2], S_d[3] }, { S_d[2], S_d[3], S_d[4] } };
+    const double det_d = M_d[0][0] * (M_d[1][1] * M_d[2][2] - M_d[1][2] * M_d[2][1]) -
+                         M_d[0][1] * (M_d[1][0] * M_d[2][2] - M_d[1][2] * M_d[2][0]) +
+                         M_d[0][2] * (M_d[1][0] * M_d[2][1] - M_d[1][1] * M_d[2][0]);
+    double coeff_d[3];
+    for (uint32_t c = 0; c < 3; ++c) {
+        double C_d[3][3];
+        memcpy(C_d, M_d, sizeof(C_d));
+        for (uint32_t r = 0; r < 3; ++r)
+            C_d[r][c] = T_d[r];
+        coeff_d[c] = (C_d[0][0] * (C_d[1][1] * C_d[2][2] - C_d[1][2] * C_d[2][1]) -
+                      C_d[0][1] * (C_d[1][0] * C_d[2][2] - C_d[1][2] * C_d[2][0]) +
+                      C_d[0][2] * (C_d[1][0] * C_d[2][1] - C_d[1][1] * C_d[2][0])) / det_d;
+    }
+    return exp(coeff_d[0] + coeff_d[1] * fr_t_d + coeff_d[2] * fr_t_d * fr_t_d);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Compare a series of two runs and print the result.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_name      - Name of the series.
+ * \param[in] fr_baseline  - The baseline sample.
+ * \param[in] fr_candidate - The candidate sample.
+ * \param[in] fr_options   - The options.
+ * \return    Returns \c true if the candidate regressed.
+ *
+ *****************************************************************************/
+bool compareSeries(const std::string&          fr_name,
+                   const std::vector<int64_t>& fr_baseline,
+                   const std::vector<int64_t>& fr_candidate,
+                   const CompareOptions&       fr_options)
+{
+    std::vector<int64_t> baseline(fr_baseline), candidate(fr_candidate);
+    std::vector<int64_t> baselineQuantiles, candidateQuantiles;
+    resultsPercentiles(baseline, fr_options.quantiles, baselineQuantiles);
+    resultsPercentiles(candidate, fr_options.quantiles, candidateQuantiles);
+
+    std::vector<std::vector<int64_t> > diffs;
+    bootstrapDifferences(fr_baseline, fr_candidate, fr_options, diffs);
+
+    const double alpha_d    = 1.0 - fr_options.confidence_d / 100.0;
+    const size_t lowIdx_ui  = size_t(floor(alpha_d / 2.0 * fr_options.numResamples_ui));
+    const size_t highIdx_ui = std::min(size_t(ceil((1.0 - alpha_d / 2.0) * fr_options.numResamples_ui)),
+                                       size_t(fr_options.numResamples_ui)) - 1;
+    bool regression_b = false;
+
+    printf("%s: %zu baseline, %zu candidate samples\n", fr_name.c_str(), fr_baseline.size(), fr_candidate.size());
+    printf("  quantile   baseline  candidate  difference [%g%% CI] (ms)\n", fr_options.confidence_d);
+    for (size_t q = 0; q < fr_options.quantiles.size(); ++q) {
+        const double baseline_d  = double(baselineQuantiles[q]) / 1000000.0;
+        const double candidate_d = double(candidateQuantiles[q]) / 1000000.0;
+        const double low_d       = double(diffs[q][lowIdx_ui]) / 1000000.0;
+        const double high_d      = double(diffs[q][highIdx_ui]) / 1000000.0;
+        const double tolerance_d = std::max(fr_options.toleranceMs_d, fabs(baseline_d) * fr_options.tolerancePct_d / 100.0);
+        const bool   regressed_b = (low_d > tolerance_d);
+        const bool   improved_b  = (high_d < -tolerance_d);
+        char quantile[16];
+        snprintf(quantile, sizeof(quantile), "p%g", fr_options.quantiles[q]);
+
+        printf("  %-8s %10.4f %10.4f  %+.4f [%+.4f, %+.4f]%s\n", quantile, baseline_d, candidate_d,
+               candidate_d - baseline_d, low_d, high_d,
+               regressed_b ? "  REGRESSION" : (improved_b ? "  improved" : ""));
+        regression_b = regression_b || regressed_b;
+    }
+
+    std::sort(baseline.begin(), baseline.end());
+    std::sort(candidate.begin(), candidate.end());
+    double d_d, dPlus_d, t_d;
+    const double ksP_d = kolmogorovSmirnov(baseline, candidate, d_d, dPlus_d);
+    const double adP_d = andersonDarling(baseline, candidate, t_d);
+    const bool   distributionsDiffer_b = (ksP_d < alpha_d) && (adP_d < alpha_d);
+    const bool   slower_b = (dPlus_d >= d_d);
+
+    printf("  Kolmogorov-Smirnov: D = %.4f (D+ = %.4f), p = %.3g\n", d_d, dPlus_d, ksP_d);
+    printf("  Anderson-Darling:   T = %.3f, p %s %.3g\n", t_d,
+           (adP_d <= 0.001) ? "<=" : ((adP_d >= 0.25) ? ">=" : "="), adP_d);
+    if (distributionsDiffer_b) {
+        printf("  The distributions differ significantly, the candidate is mostly %s.\n",
+               slower_b ? "slower" : "faster");
+        if (fr_options.gateTests_b && slower_b)
+            regression_b = true;
+    }
+    printf("\n");
+
+    return regression_b;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Main entry point.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_argc_i - Number of arguments.
+ * \param[in] f_argv_p - Arguments.
+ * \return    Return code of the application.
+ *
+ *****************************************************************************/
+int main(int f_argc_i, char** f_argv_p) {
+    const char* progName_p = f_argv_p[0];
+    CompareOptions options;
+    options.numResamples_ui = 1000;
+    options.confidence_d    = 95.0;
+    options.tolerancePct_d  = 1.0;
+    options.toleranceMs_d   = 0.0;
+    options.gateTests_b     = false;
+    options.numThreads_ui   = std::thread::hardware_concurrency();
+    options.seed_ui         = 1;
+    std::string quantilesStr  = "50,99,99.9";
+    std::string seriesPattern = "*";
+    std::vector<std::string> arguments;
+
+    // Parse command line arguments
+    for (int i=1; i < f_argc_i; ++i) {
+        if ((strcmp(f_argv_p[i], "-h") == 0) ||
+            (strcmp(f_argv_p[i], "--help") == 0)) {
+            usage(progName_p);
+        }
+        else if ((strcmp(f_argv_p[i], "--series") == 0)) {
+          if (++i < f_argc_i) {
+            seriesPattern = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --series option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "-q") == 0) ||
+                 (strcmp(f_argv_p[i], "--quantiles") == 0)) {
+          if (++i < f_argc_i) {
+            quantilesStr = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --quantiles option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "-b") == 0) ||
+                 (strcmp(f_argv_p[i], "--bootstrap") == 0)) {
+          if (++i < f_argc_i) {
+            options.numResamples_ui = atoi(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --bootstrap option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "-c") == 0) ||
+                 (strcmp(f_argv_p[i], "--confidence") == 0)) {
+          if (++i < f_argc_i) {
+            options.confidence_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --confidence option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--tolerance") == 0)) {
+          if (++i < f_argc_i) {
+            options.tolerancePct_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --tolerance option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--tolerance-ms") == 0)) {
+          if (++i < f_argc_i) {
+            options.toleranceMs_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --tolerance-ms option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--gate-tests") == 0)) {
+          options.gateTests_b = true;
+        }
+        else if ((strcmp(f_argv_p[i], "-j") == 0) ||
+                 (strcmp(f_argv_p[i], "--jobs") == 0)) {
+          if (++i < f_argc_i) {
+            options.numThreads_ui = atoi(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --jobs option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--seed") == 0)) {
+          if (++i < f_argc_i) {
+            options.seed_ui = strtoull(f_argv_p[i], NULL, 10);
+          } else {
+            printf("Error: Expected argument after --seed option!\n");
+            usage(progName_p);
+          }
+        }
+        else if (f_argv_p[i][0] == '-') {
+            printf("Error: Unknown option %s! Please see usage for available options!\n\n",
+                   f_argv_p[i]);
+            usage(progName_p);
+        }
+        else {
+            arguments.push_back(f_argv_p[i]);
+        }
+    }
+
+    if (arguments.size() != 2) {
+        printf("Error: Expected a baseline and a candidate run! Please see usage for syntax!\n\n");
+        usage(progName_p);
+    }
+    if ((options.numResamples_ui < 10) || (options.confidence_d <= 0.0) || (options.confidence_d >= 100.0)) {
+        printf("Error: At least 10 resamples and a confidence level between 0 and 100%% are required!\n\n");
+        usage(progName_p);
+    }
+    if (options.numThreads_ui == 0)
+        options.numThreads_ui = 1;
+
+    for (size_t start_ui = 0; start_ui < quantilesStr.size(); ) {
+        size_t end_ui = quantilesStr.find(',', start_ui);
+        if (end_ui == std::string::npos)
+            end_ui = quantilesStr.size();
+        options.quantiles.push_back(atof(quantilesStr.substr(start_ui, end_ui - start_ui).c_str()));
+        start_ui = end_ui + 1;
+    }
+
+    RunSeries_t baseline, candidate;
+    if (!loadRun(arguments[0], baseline) || !loadRun(arguments[1], candidate))
+        return 2;
+
+    // Two single series are compared even if their names differ
+    if ((baseline.size() == 1) && (candidate.size() == 1) &&
+        (baseline.begin()->first != candidate.begin()->first)) {
+        std::vector<int64_t> values;
+        values.swap(candidate.begin()->second);
+        candidate.clear();
+        candidate[baseline.begin()->first].swap(values);
+    }
+
+    uint32_t numCompared_ui = 0, numRegressions_ui = 0;
+    for (RunSeries_t::const_iterator i = baseline.begin(); i != baseline.end(); ++i) {
+        RunSeries_t::const_iterator other = candidate.find(i->first);
+        if ((other == candidate.end()) || (fnmatch(seriesPattern.c_str(), i->first.c_str(), 0) != 0))
+            continue;
+        ++numCompared_ui;
+        if (compareSeries(i->first, i->second, other->second, options))
+            ++numRegressions_ui;
+    }
+
+    if (numCompared_ui == 0) {
+        printf("Error: The runs have no series in common!\n");
+        return 2;
+    }
+
+    if (numRegressions_ui > 0) {
+        printf("Result: %u of %u series regressed.\n", numRegressions_ui, numCompared_ui);
+        return 3;
+    }
+    printf("Result: No regression in %u series.\n", numCompared_ui);
+    return 0;
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,537 @@
+/* ********************************* FILE ************************************/
+/** \file    latencyProbe.cpp
+ *
+ * \brief    This file describes the latency probe library to measure the
+ *           latencies of the real serial traffic of an application.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "latencyProbe.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <string>
+
+#include "captureFile.h"
+#include "latencySeries.h"
+#include "serialTiming.h"
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Send time of a message waiting for its receive
+struct LatencyProbeSlot {
+  std::atomic<uint64_t> tag_ui;     ///< Message id + 1, 0 if the slot is free
+  std::atomic<uint64_t> sendNs_ui;  ///< Time of the send
+};
+
+/// A marked message passed from the receiving thread to the collection
+struct LatencyProbeSample {
+  uint32_t messageId_ui;
+  uint64_t sendNs_ui;
+  uint64_t receiveNs_ui;
+};
+
+/// A probe of one measured path
+struct LatencyProbe {
+  LatencyProbe(const char* f_name_p, const uint32_t f_numSlots_ui, const uint32_t f_ringSize_ui)
+      : index_ui(0),
+        series(f_name_p, (std::string(f_name_p) + ":").c_str(), f_ringSize_ui),
+        slots_p(new LatencyProbeSlot[f_numSlots_ui]),
+        slotMask_ui(f_numSlots_ui - 1),
+        ring_p(new LatencyProbeSample[f_ringSize_ui]),
+        ringMask_ui(f_ringSize_ui - 1),
+        head_ui(0),
+        tail_ui(0),
+        numDropped_ui(0),
+        numUnmatched_ui(0) {
+    for (uint32_t i = 0; i < f_numSlots_ui; ++i) {
+      slots_p[i].tag_ui.store(0, std::memory_order_relaxed);
+      slots_p[i].sendNs_ui.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  ~LatencyProbe() {
+    delete[] slots_p;
+    delete[] ring_p;
+  }
+
+  uint32_t              index_ui;       ///< Index of the probe, used for the capture records
+  LatencySeries         series;
+  LatencyProbeSlot*     slots_p;
+  uint32_t              slotMask_ui;
+  LatencyProbeSample*   ring_p;
+  uint32_t              ringMask_ui;
+
+  // Written by the receiving thread
+  std::atomic<uint32_t> head_ui;
+  char                  padding1[64];
+  // Written by the collecting thread
+  std::atomic<uint32_t> tail_ui;
+  char                  padding2[64];
+  std::atomic<uint64_t> numDropped_ui;
+  std::atomic<uint64_t> numUnmatched_ui;
+};
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// Capture file of all probes
+static CaptureWriter g_probeCapture;
+
+/// Number of created probes
+static uint32_t g_numProbes_ui = 0;
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Round up to the next power of two.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_value_ui - The value.
+ * \return    Returns the smallest power of two not smaller than the value.
+ *
+ *****************************************************************************/
+static uint32_t latencyProbePowerOfTwo(const uint32_t f_value_ui)
+{
+    uint32_t value_ui = 1;
+    while ((value_ui < f_value_ui) && (value_ui < 0x80000000u))
+        value_ui <<= 1;
+    return value_ui;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Configure the statistics of the probes created afterwards.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_storeSamples_i       - Store the samples for the *.gpd files.
+ * \param[in] f_significantDigits_ui - Significant digits of the histograms.
+ * \param[in] f_intervalS_f          - Interval of the interval statistics in
+ *                                     seconds or 0 to disable them.
+ *
+ *****************************************************************************/
+void latencyProbeConfigure(int      f_storeSamples_i,
+                           uint32_t f_significantDigits_ui,
+                           float    f_intervalS_f)
+{
+    latencySeriesConfigure(f_storeSamples_i != 0, f_significantDigits_ui, f_intervalS_f);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Open the capture file of all probes.
+ *
+ *            The latencies of the probe with index N (in the order of
+ *            creation) are stored as records of type CAPTURE_PROBE + N with
+ *            the send time as the time before the write and the receive time
+ *            as the time after the read.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_fileName_p - Name of the capture file.
+ * \param[in] f_device_p   - Serial device for the header or \c NULL.
+ * \param[in] f_comment_p  - Comment for the header or \c NULL.
+ * \return    Returns 0 on success, otherwise -1.
+ *
+ *****************************************************************************/
+int latencyProbeOpenCapture(const char* f_fileName_p,
+                            const char* f_device_p,
+                            const char* f_comment_p)
+{
+    CaptureHeader header;
+    captureInitializeHeader(header);
+    snprintf(header.driver, sizeof(header.driver), "probe");
+    if (f_device_p)
+        snprintf(header.device, sizeof(header.device), "%s", f_device_p);
+    if (f_comment_p)
+        snprintf(header.comment, sizeof(header.comment), "%s", f_comment_p);
+
+    // The capture grows in latencyProbeCollect(), off the measurement path
+    return g_probeCapture.open(f_fileName_p, header, 0) ? 0 : -1;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Close the capture file of all probes.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void latencyProbeCloseCapture(void)
+{
+    g_probeCapture.close();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Create a probe.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_name_p         - Name of the probe, used for the file names.
+ * \param[in] f_maxInFlight_ui - Maximum number of messages waiting for their
+ *                               receive. The send of an older message is
+ *                               overwritten and its receive is counted as
+ *                               unmatched.
+ * \param[in] f_ringSize_ui    - Maximum number of latencies waiting for the
+ *                               collection. Further ones are counted as
+ *                               dropped.
+ * \return    Returns the probe or \c NULL on error.
+ *
+ *****************************************************************************/
+LatencyProbe* latencyProbeCreate(const char* f_name_p,
+                                 uint32_t    f_maxInFlight_ui,
+                                 uint32_t    f_ringSize_ui)
+{
+    if (!f_name_p || (f_name_p[0] == '\0')) {
+        printf("Error: A latency probe needs a name!\n");
+        return NULL;
+    }
+
+    LatencyProbe* probe_p = new LatencyProbe(f_name_p,
+                                             latencyProbePowerOfTwo(f_maxInFlight_ui),
+                                             latencyProbePowerOfTwo(f_ringSize_ui));
+    probe_p->index_ui = g_numProbes_ui++;
+    if (probe_p->index_ui >= CAPTURE_MAX_PROBES)
+        printf("Warning: Only the first %d latency probes are captured.\n", CAPTURE_MAX_PROBES);
+    return probe_p;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Destroy a probe.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p - The probe.
+ *
+ *****************************************************************************/
+void latencyProbeDestroy(LatencyProbe* f_probe_p)
+{
+    delete f_probe_p;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the current time of the CLOCK_MONOTONIC_RAW clock.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns the current time in nanoseconds.
+ *
+ *****************************************************************************/
+uint64_t latencyProbeNowNs(void)
+{
+    return getTimeStampNs();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Mark the send of a message now.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p      - The probe.
+ * \param[in] f_messageId_ui - Id of the message.
+ *
+ *****************************************************************************/
+void latencyProbeMarkSend(LatencyProbe* f_probe_p,
+                          uint32_t      f_messageId_ui)
+{
+    latencyProbeMarkSendAt(f_probe_p, f_messageId_ui, getTimeStampNs());
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Mark the receive of a message now.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p      - The probe.
+ * \param[in] f_messageId_ui - Id of the message.
+ *
+ *****************************************************************************/
+void latencyProbeMarkReceive(LatencyProbe* f_probe_p,
+                             uint32_t      f_messageId_ui)
+{
+    latencyProbeMarkReceiveAt(f_probe_p, f_messageId_ui, getTimeStampNs());
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Mark the send of a message at the given time.
+ *
+ *            The slot is freed before its time changes, so a late receive
+ *            of the previous message of the slot can't take the new time.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p      - The probe.
+ * \param[in] f_messageId_ui - Id of the message.
+ * \param[in] f_timeNs_ui    - Time of the send (CLOCK_MONOTONIC_RAW).
+ *
+ *****************************************************************************/
+void latencyProbeMarkSendAt(LatencyProbe* f_probe_p,
+                            uint32_t      f_messageId_ui,
+                            uint64_t      f_timeNs_ui)
+{
+    LatencyProbeSlot& slot = f_probe_p->slots_p[f_messageId_ui & f_probe_p->slotMask_ui];
+    slot.tag_ui.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.sendNs_ui.store(f_timeNs_ui, std::memory_order_relaxed);
+    slot.tag_ui.store(uint64_t(f_messageId_ui) + 1, std::memory_order_release);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Mark the receive of a message at the given time.
+ *
+ *            The slot of the message is released with a compare and swap, so
+ *            a message is counted once even if the receive is marked twice.
+ *            The swap also checks the tag again after the time was read: if
+ *            a send reused the slot in between, it fails.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p      - The probe.
+ * \param[in] f_messageId_ui - Id of the message.
+ * \param[in] f_timeNs_ui    - Time of the receive (CLOCK_MONOTONIC_RAW).
+ *
+ *****************************************************************************/
+void latencyProbeMarkReceiveAt(LatencyProbe* f_probe_p,
+                               uint32_t      f_messageId_ui,
+                               uint64_t      f_timeNs_ui)
+{
+    LatencyProbeSlot& slot   = f_probe_p->slots_p[f_messageId_ui & f_probe_p->slotMask_ui];
+    uint64_t          tag_ui = uint64_t(f_messageId_ui) + 1;
+    if (slot.tag_ui.load(std::memory_order_acquire) != tag_ui) {
+        f_probe_p->numUnmatched_ui.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    const uint64_t sendNs_ui = slot.sendNs_ui.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!slot.tag_ui.compare_exchange_strong(tag_ui, 0, std::memory_order_acq_rel)) {
+        f_probe_p->numUnmatched_ui.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const uint32_t head_ui = f_probe_p->head_ui.load(std::memory_order_relaxed);
+    if (head_ui - f_probe_p->tail_ui.load(std::memory_order_acquire) > f_probe_p->ringMask_ui) {
+        f_probe_p->numDropped_ui.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    LatencyProbeSample& sample = f_probe_p->ring_p[head_ui & f_probe_p->ringMask_ui];
+    sample.messageId_ui = f_messageId_ui;
+    sample.sendNs_ui    = sendNs_ui;
+    sample.receiveNs_ui = f_timeNs_ui;
+    f_probe_p->head_ui.store(head_ui + 1, std::memory_order_release);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Read the last interrupt of a pin of the gpiotiming kernel module.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  f_pin_p      - The pin, "arduino" or "inttest".
+ * \param[out] fr_counter_p - Number of interrupts.
+ * \param[out] fr_timeNs_p  - Time of the last interrupt (CLOCK_MONOTONIC_RAW).
+ * \return    Returns 0 on success, otherwise -1.
+ *
+ *****************************************************************************/
+int latencyProbeGpioTimestamp(const char* f_pin_p,
+                              uint32_t*   fr_counter_p,
+                              uint64_t*   fr_timeNs_p)
+{
+    const std::string prefix  = std::string("/sys/gpiotiming/") + f_pin_p;
+    const int32_t     counter_i = getSysfsCounter(prefix + "_counter");
+    if (counter_i < 0)
+        return -1;
+
+    *fr_counter_p = uint32_t(counter_i);
+    *fr_timeNs_p  = getSysfsTimestamp(prefix + "_timestamp_ns");
+    return 0;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Move the marked latencies into the statistics and the capture.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p - The probe.
+ * \return    Returns the number of collected latencies.
+ *
+ *****************************************************************************/
+uint32_t latencyProbeCollect(LatencyProbe* f_probe_p)
+{
+    const uint32_t head_ui = f_probe_p->head_ui.load(std::memory_order_acquire);
+    uint32_t       tail_ui = f_probe_p->tail_ui.load(std::memory_order_relaxed);
+    const bool     capture_b = g_probeCapture.isOpen() && (f_probe_p->index_ui < CAPTURE_MAX_PROBES);
+
+    const uint32_t numSamples_ui = head_ui - tail_ui;
+    if (capture_b)
+        g_probeCapture.reserve(numSamples_ui);
+    for (; tail_ui != head_ui; ++tail_ui) {
+        const LatencyProbeSample& sample = f_probe_p->ring_p[tail_ui & f_probe_p->ringMask_ui];
+        f_probe_p->series.record(getNanoseconds(sample.sendNs_ui, sample.receiveNs_ui));
+        if (capture_b)
+            g_probeCapture.append(CAPTURE_PROBE + f_probe_p->index_ui, sample.messageId_ui,
+                                  sample.sendNs_ui, 0, sample.receiveNs_ui, 0);
+    }
+    f_probe_p->tail_ui.store(tail_ui, std::memory_order_release);
+
+    latencySeriesUpdateIntervals(getTimeStampNs());
+    return numSamples_ui;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the number of collected latencies.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p - The probe.
+ * \return    Returns the number of collected latencies.
+ *
+ *****************************************************************************/
+uint64_t latencyProbeCount(const LatencyProbe* f_probe_p)
+{
+    return f_probe_p->series.histogram().count();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get a percentile of the collected latencies.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p      - The probe.
+ * \param[in] f_percentile_d - The percentile (0..100).
+ * \return    Returns the percentile in nanoseconds.
+ *
+ *****************************************************************************/
+int64_t latencyProbePercentileNs(const LatencyProbe* f_probe_p,
+                                 double              f_percentile_d)
+{
+    return f_probe_p->series.histogram().percentile(f_percentile_d);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the number of latencies dropped because the ring was full.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p - The probe.
+ * \return    Returns the number of dropped latencies.
+ *
+ *****************************************************************************/
+uint64_t latencyProbeDropped(const LatencyProbe* f_probe_p)
+{
+    return f_probe_p->numDropped_ui.load(std::memory_order_relaxed);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the number of receives without a marked send.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p - The probe.
+ * \return    Returns the number of unmatched receives.
+ *
+ *****************************************************************************/
+uint64_t latencyProbeUnmatched(const LatencyProbe* f_probe_p)
+{
+    return f_probe_p->numUnmatched_ui.load(std::memory_order_relaxed);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the statistics of the collected latencies.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p - The probe.
+ *
+ *****************************************************************************/
+void latencyProbeReport(const LatencyProbe* f_probe_p)
+{
+    f_probe_p->series.report();
+    const uint64_t numDropped_ui   = latencyProbeDropped(f_probe_p);
+    const uint64_t numUnmatched_ui = latencyProbeUnmatched(f_probe_p);
+    if ((numDropped_ui > 0) || (numUnmatched_ui > 0))
+        printf("Warning: %s: %llu latencies dropped, %llu receives unmatched.\n",
+               f_probe_p->series.name().c_str(), (unsigned long long) numDropped_ui,
+               (unsigned long long) numUnmatched_ui);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Save the collected latencies like latencyTest.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_probe_p - The probe.
+ *
+ *****************************************************************************/
+void latencyProbeSave(LatencyProbe* f_probe_p)
+{
+    f_probe_p->series.save();
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,119 @@
+/* ********************************* FILE ************************************/
+/** \file    latencyProbe.h
+ *
+ * \brief    This file describes the C API of the latency probe library
+ *           (liblatencyprobe.a) to measure the latencies of the real serial
+ *           traffic of an application.
+ *
+ *           The application creates a probe per measured path and marks the
+ *           send and the receive of each message with its message id, e.g.
+ *           a sequence number of its protocol. Marking is lock-free, wait-free
+ *           and does not allocate: the send time is stored in a slot of the
+ *           message id, the receive looks it up and pushes the latency into a
+ *           single-producer/single-consumer ring. latencyProbeCollect() drains
+ *           the ring into the HDR histogram and time series of the probe and
+ *           into the capture file, so the results have the formats of
+ *           latencyTest (*.gpd, *_percentiles.txt, capture files).
+ *
+ *           Threads: the sends of a probe may be marked by one thread and the
+ *           receives by one (possibly other) thread. All probes are collected,
+ *           reported and saved by one thread, e.g. a low priority one.
+ *
+ *           Link with: liblatencyprobe.a -lstdc++ -lm -lrt -pthread
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// A probe of one measured path
+typedef struct LatencyProbe LatencyProbe;
+
+
+/*****************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Configure the statistics of the probes created afterwards, see the
+/// --no-raw, --hdr-digits and --interval options of latencyTest.
+void          latencyProbeConfigure(int      f_storeSamples_i,
+                                    uint32_t f_significantDigits_ui,
+                                    float    f_intervalS_f);
+
+/// Open the capture file of all probes. Returns 0 on success.
+int           latencyProbeOpenCapture(const char* f_fileName_p,
+                                      const char* f_device_p,
+                                      const char* f_comment_p);
+void          latencyProbeCloseCapture(void);
+
+/// Create a probe. At most f_maxInFlight_ui messages may wait for their
+/// receive, f_ringSize_ui latencies may wait for the collection. Both are
+/// rounded up to powers of two. Returns NULL on error.
+LatencyProbe* latencyProbeCreate(const char* f_name_p,
+                                 uint32_t    f_maxInFlight_ui,
+                                 uint32_t    f_ringSize_ui);
+void          latencyProbeDestroy(LatencyProbe* f_probe_p);
+
+/// Current time of CLOCK_MONOTONIC_RAW in nanoseconds
+uint64_t      latencyProbeNowNs(void);
+
+/// Mark the send and the receive of a message now or at the given time.
+void          latencyProbeMarkSend(LatencyProbe* f_probe_p,
+                                   uint32_t      f_messageId_ui);
+void          latencyProbeMarkReceive(LatencyProbe* f_probe_p,
+                                      uint32_t      f_messageId_ui);
+void          latencyProbeMarkSendAt(LatencyProbe* f_probe_p,
+                                     uint32_t      f_messageId_ui,
+                                     uint64_t      f_timeNs_ui);
+void          latencyProbeMarkReceiveAt(LatencyProbe* f_probe_p,
+                                        uint32_t      f_messageId_ui,
+                                        uint64_t      f_timeNs_ui);
+
+/// Read the last interrupt of a pin ("arduino" or "inttest") of the
+/// gpiotiming kernel module, e.g. for latencyProbeMarkReceiveAt().
+/// Returns 0 on success.
+int           latencyProbeGpioTimestamp(const char* f_pin_p,
+                                        uint32_t*   fr_counter_p,
+                                        uint64_t*   fr_timeNs_p);
+
+/// Move the marked latencies into the statistics. Returns their number.
+uint32_t      latencyProbeCollect(LatencyProbe* f_probe_p);
+
+/// Statistics of the collected latencies
+uint64_t      latencyProbeCount(const LatencyProbe* f_probe_p);
+int64_t       latencyProbePercentileNs(const LatencyProbe* f_probe_p,
+                                       double              f_percentile_d);
+uint64_t      latencyProbeDropped(const LatencyProbe* f_probe_p);
+uint64_t      latencyProbeUnmatched(const LatencyProbe* f_probe_p);
+
+/// Print the statistics, and save them like latencyTest to the current
+/// directory (<name>.gpd, <name>_percentiles.txt).
+void          latencyProbeReport(const LatencyProbe* f_probe_p);
+void          latencyProbeSave(LatencyProbe* f_probe_p);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LATENCY_PROBE_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
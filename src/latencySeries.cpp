@@ -0,0 +1,504 @@
+/* ********************************* FILE ************************************/
+/** \file    latencySeries.cpp
+ *
+ * \brief    This file describes a series of measured latencies.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "latencySeries.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <mutex>
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+static bool                        g_latencyStoreSamples_b      = true;
+static uint32_t                    g_latencySignificantDigits_ui = 3;
+static uint64_t                    g_latencyIntervalNs_ui       = 0;
+static std::vector<LatencySeries*> g_latencySeries;
+static std::mutex                  g_latencySeriesMutex;
+static LatencySink*                 g_latencySink_p              = NULL;
+
+// The interval clock shared by all threads, and the one of a thread measuring
+// concurrently to others. A series uses the clock of the thread creating it,
+// and a thread updates only the series of its clock.
+static LatencyIntervalClock               g_latencyClock       = { 0, 0, 0 };
+static thread_local LatencyIntervalClock  g_latencyThreadClock = { 0, 0, 0 };
+static thread_local LatencyIntervalClock* g_latencyClock_p     = &g_latencyClock;
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Configure all series created afterwards.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_storeSamples_b       - If \c true, store the raw samples and
+ *                                     save them as a gnuplot data file.
+ *                                     Otherwise only the histograms are kept,
+ *                                     so the memory does not grow with the run.
+ * \param[in] f_significantDigits_ui - Significant digits of the histograms.
+ * \param[in] f_intervalS_f          - Interval in seconds of the interval
+ *                                     statistics, or 0 to disable them.
+ *
+ *****************************************************************************/
+void latencySeriesConfigure(const bool     f_storeSamples_b,
+                            const uint32_t f_significantDigits_ui,
+                            const float    f_intervalS_f)
+{
+    g_latencyStoreSamples_b       = f_storeSamples_b;
+    g_latencySignificantDigits_ui = f_significantDigits_ui;
+    g_latencyIntervalNs_ui        = uint64_t(f_intervalS_f * 1.0e9f);
+
+    std::lock_guard<std::mutex> lock(g_latencySeriesMutex);
+    g_latencyClock.startNs_ui = 0;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Set the receiver of the samples of all series created afterwards.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_sink_p - The receiver, or \c NULL to disable it.
+ *
+ *****************************************************************************/
+void latencySeriesSetSink(LatencySink* f_sink_p)
+{
+    g_latencySink_p = f_sink_p;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Take the interval statistics of all series if the interval has
+ *            elapsed.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_nowNs_ui - The current time in nanoseconds.
+ *
+ *****************************************************************************/
+void latencySeriesUpdateIntervals(const uint64_t f_nowNs_ui)
+{
+    if (g_latencyIntervalNs_ui == 0)
+        return;
+
+    LatencyIntervalClock& clock = *g_latencyClock_p;
+    clock.lastUpdateNs_ui = f_nowNs_ui;
+    if (clock.startNs_ui == 0) {
+        clock.startNs_ui        = f_nowNs_ui;
+        clock.lastIntervalNs_ui = f_nowNs_ui;
+        return;
+    }
+
+    if (f_nowNs_ui - clock.lastIntervalNs_ui >= g_latencyIntervalNs_ui) {
+        const double elapsedS_d = double(f_nowNs_ui - clock.startNs_ui) / 1.0e9;
+        std::lock_guard<std::mutex> lock(g_latencySeriesMutex);
+        for (size_t i = 0; i < g_latencySeries.size(); ++i) {
+            if (g_latencySeries[i]->clock() == &clock)
+                g_latencySeries[i]->snapshotInterval(elapsedS_d);
+        }
+        clock.lastIntervalNs_ui = f_nowNs_ui;
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Give the calling thread its own interval clock started at the
+ *            given time.
+ *
+ *            The series created afterwards by the thread are updated only
+ *            by its calls of latencySeriesUpdateIntervals(), so threads
+ *            measuring concurrently do not touch the series of each other.
+ *            Threads started at the same time get intervals on a common
+ *            time base.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_startNs_ui - Start of the first interval in nanoseconds.
+ *
+ *****************************************************************************/
+void latencySeriesStartThreadIntervals(const uint64_t f_startNs_ui)
+{
+    g_latencyThreadClock.startNs_ui        = f_startNs_ui;
+    g_latencyThreadClock.lastIntervalNs_ui = f_startNs_ui;
+    g_latencyThreadClock.lastUpdateNs_ui   = f_startNs_ui;
+    g_latencyClock_p = &g_latencyThreadClock;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Save a time series as a gnuplot data file.
+ *
+ * \author    Clemens Rabe
+ * \date      Apr 06, 2019
+ *
+ * \param[in] fr_timeSeries - The time series.
+ * \param[in] fr_fileName   - The output file name.
+ *
+ *****************************************************************************/
+void saveTimeSeries(const TimeSeries_t& fr_timeSeries,
+                    const std::string& fr_fileName) {
+  FILE* file_p = fopen(fr_fileName.c_str(), "w");
+
+  if (file_p) {
+    fprintf(file_p, "# Time series data. Unit is milliseconds.\n");
+    for (TimeSeries_t::const_iterator i = fr_timeSeries.begin(); i != fr_timeSeries.end(); ++i) {
+      fprintf(file_p, "%.6f\n", *i);
+    }
+    fclose(file_p);
+  }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Parse a decimal number as written by saveTimeSeries().
+ *
+ *            Plain decimals with up to 19 digits are accumulated as an
+ *            integer and divided once by an exact power of ten, which gives
+ *            the same correctly rounded result as strtod(). Anything else is
+ *            left to strtod().
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_pos_p - Position in the buffer, set to the end of the
+ *                           number.
+ * \param[out]    fr_value_d - The parsed value.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool parseDecimal(const char*& fr_pos_p,
+                         double&      fr_value_d)
+{
+    static const double powersOfTen_d[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19
+    };
+
+    const char* pos_p      = fr_pos_p;
+    const bool  negative_b = (*pos_p == '-');
+    if (negative_b)
+        ++pos_p;
+
+    uint64_t mantissa_ui    = 0;
+    uint32_t numDigits_ui   = 0;
+    uint32_t numFraction_ui = 0;
+    while ((unsigned char)(*pos_p - '0') < 10) {
+        mantissa_ui = mantissa_ui * 10 + uint64_t(*pos_p++ - '0');
+        ++numDigits_ui;
+    }
+    if (*pos_p == '.') {
+        ++pos_p;
+        while ((unsigned char)(*pos_p - '0') < 10) {
+            mantissa_ui = mantissa_ui * 10 + uint64_t(*pos_p++ - '0');
+            ++numFraction_ui;
+        }
+        numDigits_ui += numFraction_ui;
+    }
+
+    if ((numDigits_ui > 0) && (numDigits_ui <= 19) && (mantissa_ui < (uint64_t(1) << 53)) &&
+        ((*pos_p == '\n') || (*pos_p == '\0'))) {
+        fr_value_d = double(mantissa_ui) / powersOfTen_d[numFraction_ui];
+        if (negative_b)
+            fr_value_d = -fr_value_d;
+        fr_pos_p = pos_p;
+        return true;
+    }
+
+    char* end_p;
+    fr_value_d = strtod(fr_pos_p, &end_p);
+    if (end_p == fr_pos_p)
+        return false;
+    while ((*end_p == ' ') || (*end_p == '\t') || (*end_p == '\r'))
+        ++end_p;
+    fr_pos_p = end_p;
+    return ((*end_p == '\n') || (*end_p == '\0'));
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Load a time series from a gnuplot data file.
+ *
+ *            Comment lines (starting with '#') and empty lines are skipped.
+ *            The values are returned in the unit of the file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_fileName - The input file name.
+ * \param[out] fr_values   - The values.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool loadTimeSeries(const std::string&   fr_fileName,
+                    std::vector<double>& fr_values)
+{
+    fr_values.clear();
+
+    FILE* file_p = fopen(fr_fileName.c_str(), "rb");
+    if (!file_p) {
+        printf("Error: Can't open %s!\n", fr_fileName.c_str());
+        return false;
+    }
+
+    std::vector<char> buffer;
+    fseek(file_p, 0, SEEK_END);
+    const long size_i = ftell(file_p);
+    fseek(file_p, 0, SEEK_SET);
+    buffer.resize(size_i > 0 ? size_i + 1 : 1);
+    const size_t read_ui = fread(&buffer[0], 1, buffer.size() - 1, file_p);
+    fclose(file_p);
+    buffer[read_ui] = '\0';
+
+    // A line written by saveTimeSeries() has at least 9 bytes
+    fr_values.reserve(read_ui / 9 + 1);
+
+    const char* pos_p = &buffer[0];
+    uint32_t    line_ui = 1;
+    while (*pos_p != '\0') {
+        if ((*pos_p == '#') || (*pos_p == '\n')) {
+            while ((*pos_p != '\n') && (*pos_p != '\0'))
+                ++pos_p;
+        } else {
+            double value_d;
+            if (!parseDecimal(pos_p, value_d)) {
+                printf("Error: Invalid value in line %u of %s!\n", line_ui, fr_fileName.c_str());
+                return false;
+            }
+            fr_values.push_back(value_d);
+        }
+        if (*pos_p == '\n') {
+            ++pos_p;
+            ++line_ui;
+        }
+    }
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Constructor.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_name_p            - Name of the series, used as the base name
+ *                                  of the output files.
+ * \param[in] f_description_p     - Description printed with the statistics.
+ * \param[in] f_expectedSamples_ui - Expected number of samples to reserve.
+ *
+ *****************************************************************************/
+LatencySeries::LatencySeries(const char*    f_name_p,
+                             const char*    f_description_p,
+                             const uint32_t f_expectedSamples_ui)
+    : m_name(f_name_p),
+      m_description(f_description_p),
+      m_storeSamples_b(g_latencyStoreSamples_b),
+      m_total(g_latencySignificantDigits_ui),
+      m_interval(g_latencySignificantDigits_ui),
+      m_intervalFile_p(NULL),
+      m_numIntervals_ui(0),
+      m_clock_p(g_latencyClock_p),
+      m_sink_p(g_latencySink_p),
+      m_sinkId_ui(0)
+{
+    if (m_storeSamples_b)
+        m_samples.reserve(f_expectedSamples_ui);
+    memset(&m_worstInterval, 0, sizeof(m_worstInterval));
+    if (m_sink_p)
+        m_sinkId_ui = m_sink_p->registerSeries(m_name);
+
+    std::lock_guard<std::mutex> lock(g_latencySeriesMutex);
+
+    // The first series of a test on the shared clock restarts the intervals,
+    // so a test does not continue the interval phase of the previous one
+    bool clockInUse_b = false;
+    for (size_t i = 0; i < g_latencySeries.size(); ++i)
+        clockInUse_b = clockInUse_b || (g_latencySeries[i]->clock() == &g_latencyClock);
+    if ((m_clock_p == &g_latencyClock) && !clockInUse_b)
+        g_latencyClock.startNs_ui = 0;
+
+    g_latencySeries.push_back(this);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Destructor.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+LatencySeries::~LatencySeries()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_latencySeriesMutex);
+        g_latencySeries.erase(std::remove(g_latencySeries.begin(), g_latencySeries.end(), this),
+                              g_latencySeries.end());
+    }
+    if (m_intervalFile_p)
+        fclose(m_intervalFile_p);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the statistics of the series.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void LatencySeries::report() const
+{
+    printf("%s %.3f ms (mean = %.3f, min = %.3f, max=%.3f)\n",
+           m_description.c_str(),
+           double(m_total.percentile(50.0)) / 1000000.0, m_total.mean() / 1000000.0,
+           double(m_total.min()) / 1000000.0, double(m_total.max()) / 1000000.0);
+    printf("%*s p90 = %.3f, p99 = %.3f, p99.9 = %.3f, p99.99 = %.3f ms (%llu samples)\n",
+           int(m_description.size()), "",
+           double(m_total.percentile(90.0)) / 1000000.0, double(m_total.percentile(99.0)) / 1000000.0,
+           double(m_total.percentile(99.9)) / 1000000.0, double(m_total.percentile(99.99)) / 1000000.0,
+           (unsigned long long) m_total.count());
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Save the series.
+ *
+ *            The raw samples are saved to <name>.gpd and the cumulative
+ *            distribution to <name>_percentiles.txt. A remaining partial
+ *            interval is appended to <name>_intervals.txt.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void LatencySeries::save()
+{
+    if (m_storeSamples_b)
+        saveTimeSeries(m_samples, m_name + ".gpd");
+
+    FILE* file_p = fopen((m_name + "_percentiles.txt").c_str(), "w");
+    if (file_p) {
+        m_total.save(file_p);
+        fclose(file_p);
+    }
+
+    if ((g_latencyIntervalNs_ui > 0) && (m_clock_p->startNs_ui > 0)) {
+        snapshotInterval(double(m_clock_p->lastUpdateNs_ui - m_clock_p->startNs_ui) / 1.0e9);
+        closeIntervals();
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Keep the statistics of the current interval and start a new
+ *            interval.
+ *
+ *            The statistics are appended to <name>_intervals.txt, so a soak
+ *            run keeps a constant memory and the file is up to date after
+ *            each interval. Called between the iterations of the
+ *            measurement loop, once per interval.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_elapsedS_d - Elapsed time since the start in seconds.
+ *
+ *****************************************************************************/
+void LatencySeries::snapshotInterval(const double f_elapsedS_d)
+{
+    if (m_interval.count() == 0)
+        return;
+
+    LatencyInterval interval;
+    interval.elapsedS_d    = f_elapsedS_d;
+    interval.count_ui      = m_interval.count();
+    interval.valuesNs_i[0] = m_interval.min();
+    interval.valuesNs_i[1] = m_interval.percentile(50.0);
+    interval.valuesNs_i[2] = m_interval.percentile(90.0);
+    interval.valuesNs_i[3] = m_interval.percentile(99.0);
+    interval.valuesNs_i[4] = m_interval.percentile(99.9);
+    interval.valuesNs_i[5] = m_interval.percentile(99.99);
+    interval.valuesNs_i[6] = m_interval.max();
+    m_interval.reset();
+
+    if ((m_numIntervals_ui == 0) || (interval.valuesNs_i[3] > m_worstInterval.valuesNs_i[3]))
+        m_worstInterval = interval;
+    ++m_numIntervals_ui;
+
+    if (!m_intervalFile_p) {
+        if (m_numIntervals_ui > 1)
+            return;
+        m_intervalFile_p = fopen((m_name + "_intervals.txt").c_str(), "w");
+        if (!m_intervalFile_p) {
+            printf("Warning: Can't write %s_intervals.txt!\n", m_name.c_str());
+            return;
+        }
+        fprintf(m_intervalFile_p, "# Interval statistics. Columns: elapsed [s], count, min, p50, "
+                "p90, p99, p99.9, p99.99, max [ms]\n");
+    }
+
+    fprintf(m_intervalFile_p, "%.3f %llu", interval.elapsedS_d, (unsigned long long) interval.count_ui);
+    for (uint32_t v = 0; v < 7; ++v)
+        fprintf(m_intervalFile_p, " %.6f", double(interval.valuesNs_i[v]) / 1000000.0);
+    fprintf(m_intervalFile_p, "\n");
+    fflush(m_intervalFile_p);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Close <name>_intervals.txt and print the interval with the
+ *            highest 99% percentile.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void LatencySeries::closeIntervals()
+{
+    if (!m_intervalFile_p)
+        return;
+    fclose(m_intervalFile_p);
+    m_intervalFile_p = NULL;
+
+    const LatencyInterval& worst = m_worstInterval;
+    printf("%s: %u intervals, highest p99 = %.3f ms (p50 = %.3f, max = %.3f ms) in the interval "
+           "ending at %.1f s\n", m_name.c_str(), m_numIntervals_ui,
+           double(worst.valuesNs_i[3]) / 1000000.0, double(worst.valuesNs_i[1]) / 1000000.0,
+           double(worst.valuesNs_i[6]) / 1000000.0, worst.elapsedS_d);
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,132 @@
+/* ********************************* FILE ************************************/
+/** \file    latencySeries.h
+ *
+ * \brief    This file describes a series of measured latencies.
+ *
+ *           Each sample is recorded into a cumulative and an interval
+ *           histogram and - unless disabled for long soak runs - stored as
+ *           a raw time series, which is saved as a gnuplot data file.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef LATENCY_SERIES_H
+#define LATENCY_SERIES_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "hdrHistogram.h"
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Clock of the interval statistics
+struct LatencyIntervalClock {
+  uint64_t startNs_ui;         ///< Start of the first interval, 0 before the first update
+  uint64_t lastIntervalNs_ui;  ///< Start of the current interval
+  uint64_t lastUpdateNs_ui;    ///< Time of the last update
+};
+
+/// Statistics of an interval
+struct LatencyInterval {
+  double   elapsedS_d;         ///< End of the interval since the start in seconds
+  uint64_t count_ui;           ///< Number of samples
+  int64_t  valuesNs_i[7];      ///< min, p50, p90, p99, p99.9, p99.99 and max
+};
+
+/// A time series (milliseconds)
+typedef std::vector<float> TimeSeries_t;
+
+
+/*****************************************************************************
+ * CLASS
+ ******************************************************************************/
+/// Receiver of all recorded samples besides the series, e.g. the telemetry.
+class LatencySink {
+ public:
+  virtual ~LatencySink() {}
+
+  /// Register a series and get its identifier passed to record().
+  virtual uint32_t registerSeries(const std::string& fr_name) = 0;
+
+  /// Receive a sample. Called by the measurement thread, so it must not block.
+  virtual void record(const uint32_t f_seriesId_ui,
+                      const int64_t  f_valueNs_i) = 0;
+};
+
+
+/// A series of latencies of one measured path, e.g. start of write to interrupt.
+class LatencySeries {
+ public:
+  LatencySeries(const char*    f_name_p,
+                const char*    f_description_p,
+                const uint32_t f_expectedSamples_ui);
+  ~LatencySeries();
+
+  /// Record a latency in nanoseconds.
+  inline void record(const int64_t f_valueNs_i) {
+    if (m_storeSamples_b)
+      m_samples.push_back(float(f_valueNs_i) / 1000000.0f);
+    m_total.record(f_valueNs_i);
+    m_interval.record(f_valueNs_i);
+    if (m_sink_p)
+      m_sink_p->record(m_sinkId_ui, f_valueNs_i);
+  }
+
+  const std::string&          name() const      { return m_name; }
+  const HdrHistogram&         histogram() const { return m_total; }
+  const LatencyIntervalClock* clock() const     { return m_clock_p; }
+
+  void report() const;
+  void save();
+  void snapshotInterval(const double f_elapsedS_d);
+
+ private:
+  void closeIntervals();
+
+  std::string                  m_name;
+  std::string                  m_description;
+  bool                         m_storeSamples_b;
+  TimeSeries_t                 m_samples;
+  HdrHistogram                 m_total;
+  HdrHistogram                 m_interval;
+  FILE*                        m_intervalFile_p;   ///< <name>_intervals.txt, opened by the first interval
+  uint32_t                     m_numIntervals_ui;
+  LatencyInterval              m_worstInterval;    ///< Interval with the highest 99% percentile
+  LatencyIntervalClock*        m_clock_p;
+  LatencySink*                 m_sink_p;
+  uint32_t                     m_sinkId_ui;
+};
+
+
+/*****************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+void latencySeriesConfigure(const bool     f_storeSamples_b,
+                            const uint32_t f_significantDigits_ui,
+                            const float    f_intervalS_f);
+void latencySeriesSetSink(LatencySink* f_sink_p);
+void latencySeriesUpdateIntervals(const uint64_t f_nowNs_ui);
+void latencySeriesStartThreadIntervals(const uint64_t f_startNs_ui);
+
+void saveTimeSeries(const TimeSeries_t& fr_timeSeries,
+                    const std::string&  fr_fileName);
+bool loadTimeSeries(const std::string&   fr_fileName,
+                    std::vector<double>& fr_values);
+
+#endif /* LATENCY_SERIES_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,957 @@
+/* ********************************* FILE ************************************/
+/** \file    latencySim.cpp
+ *
+ * \brief    This file describes the main entry point of the latencySim tool
+ *           to predict the latencies of a workload from the measured ones.
+ *
+ *           The measured series of a results directory are taken as the
+ *           service times of a tandem of FIFO queues: the write on the host
+ *           (startWrite_to_endWrite), shared by all devices of the host, and
+ *           the path through the adapter and the Arduino back to the host
+ *           (endWrite_to_endRead), with a given number of servers per device.
+ *           The measurements of latencyTest run at a low rate without
+ *           queueing, so their samples are the service times. The model
+ *           resamples them or uses a shifted lognormal fitted to them.
+ *
+ *           Each load point is simulated as a stream of requests: the
+ *           departure of a request from a FIFO station follows from its
+ *           arrival and the free times of the servers (Lindley recursion),
+ *           so no event queue is needed and one core simulates tens of
+ *           millions of events per second. The load points run in parallel.
+ *           All points use the same random numbers, so the curves are smooth
+ *           and the rate meeting a latency limit is found by a search of the
+ *           interval between the load points passing and failing the limit.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "hdrHistogram.h"
+#include "latencySeries.h"
+#include "serialTiming.h"
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+/// Series of the service time of the host stage
+#define SIM_HOST_SERIES      "startWrite_to_endWrite"
+
+/// Series of the service time of the device stage
+#define SIM_DEVICE_SERIES    "endWrite_to_endRead"
+
+/// Series of the measured round trip, used if the stages are not measured
+#define SIM_TOTAL_SERIES     "startWrite_to_endRead"
+
+/// Fraction of the requests of a load point discarded as warm up
+#define SIM_WARMUP_FRACTION  0.1
+
+/// Number of rounds of the search for the rate meeting the limit. Each round
+/// divides the interval by the number of threads plus one.
+#define SIM_SEARCH_ROUNDS    8
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Model of the service time of a stage
+struct ServiceModel {
+  std::string          series;       ///< Name of the fitted series, empty if the stage takes no time
+  std::vector<int64_t> sortedNs;     ///< The measured samples, sorted
+  bool                 lognormal_b;  ///< Use the shifted lognormal instead of the samples
+  double               shiftNs_d;    ///< Shift of the lognormal
+  double               mu_d;         ///< Mean of the logarithm of the shifted samples
+  double               sigma_d;      ///< Standard deviation of the logarithm
+  double               meanNs_d;     ///< Mean of the samples
+};
+
+/// A simulated device
+struct SimDevice {
+  std::string  directory;      ///< The results directory of the model
+  double       weight_d;       ///< Rate of the device relative to the load point
+  bool         periodic_b;     ///< Periodic instead of Poisson arrivals
+  ServiceModel host;
+  ServiceModel device;
+  int64_t      recordedP50Ns_i;  ///< Measured round trip, for the validation
+  int64_t      recordedP99Ns_i;
+};
+
+/// Options of the simulation
+struct SimOptions {
+  uint64_t numRequests_ui;     ///< Requests per load point over all devices
+  uint32_t deviceServers_ui;   ///< Servers of the device stage, 0 for a pure delay
+  bool     hostPerDevice_b;    ///< Each device has its own host stage
+  double   limitMs_d;          ///< Latency limit of the search
+  double   limitPercentile_d;  ///< Percentile compared with the limit
+  uint32_t numThreads_ui;
+  uint64_t seed_ui;
+};
+
+/// Result of a load point
+struct SimResult {
+  double                    rate_d;               ///< Rate of a device of weight 1 in 1/s
+  HdrHistogram              total;                ///< Latencies of all devices
+  std::vector<HdrHistogram> devices;              ///< Latencies per device
+  double                    hostUtilization_d;    ///< Largest utilization of a host stage
+  double                    deviceUtilization_d;  ///< Largest utilization of a device stage
+  uint64_t                  numEvents_ui;
+};
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the usage and exit.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_progName_p - Name of the program.
+ *
+ *****************************************************************************/
+void usage(const char* f_progName_p)
+{
+    printf("Usage: %s [<Options>] <device> [<device> ...]\n"
+           "\n"
+           "Predict the latencies of a workload from measured latencies. Each\n"
+           "device is given as DIR[:WEIGHT[:periodic]]: a results directory of\n"
+           "latencyTest, the rate of the device relative to the load point\n"
+           "[default: 1] and its arrivals [default: Poisson].\n"
+           "\n"
+           "A request is written by the host (" SIM_HOST_SERIES ", one FIFO\n"
+           "server shared by all devices) and answered by the device\n"
+           "(" SIM_DEVICE_SERIES ", FIFO servers per device, see --servers).\n"
+           "The service times are resampled from the measured series or\n"
+           "drawn from a fitted shifted lognormal. Directories without these\n"
+           "series use " SIM_TOTAL_SERIES " for the device stage.\n"
+           "\n"
+           "For each load point, the percentiles of the round trip and the\n"
+           "utilizations are printed and saved, followed by the highest rate\n"
+           "whose percentile meets the limit.\n"
+           "\n"
+           "Options:\n"
+           "  -h|--help:           Print this help.\n"
+           "  -r|--rates LIST:     Rates of the load points in requests per\n"
+           "                       second of a device of weight 1, given as a\n"
+           "                       comma separated list or as FROM:TO[:N] for N\n"
+           "                       points [default: 5%% to 98%% of the capacity\n"
+           "                       in 20 points].\n"
+           "  -n|--requests N:     Requests per load point [default: 1000000].\n"
+           "  --servers N:         Servers of the device stage, i.e., requests\n"
+           "                       a device processes at the same time; 0 for a\n"
+           "                       pure delay (fully pipelined) [default: 1].\n"
+           "  --host-per-device:   Each device is written by its own thread, so\n"
+           "                       the host stage is not shared.\n"
+           "  --series NAME:       Use only the series NAME (e.g.\n"
+           "                       startWrite_to_interrupt) as device stage\n"
+           "                       without a host stage.\n"
+           "  --lognormal:         Draw the service times from a shifted\n"
+           "                       lognormal fitted to the series.\n"
+           "  --limit MS:          Latency limit of the search [default: 5].\n"
+           "  --limit-percentile P: Percentile compared with the limit\n"
+           "                       [default: 99].\n"
+           "  -o|--output FILE:    Gnuplot data file of the curves\n"
+           "                       [default: latencySim.txt].\n"
+           "  -j|--jobs N:         Number of threads [default: number of cores].\n"
+           "  --seed N:            Seed of the simulation [default: 1].\n",
+           f_progName_p);
+    exit(1);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if a file exists.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_fileName - The file name.
+ * \return    Returns \c true if the file exists.
+ *
+ *****************************************************************************/
+bool fileExists(const std::string& fr_fileName)
+{
+    struct stat fileStat;
+    return (stat(fr_fileName.c_str(), &fileStat) == 0);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Random number generator (splitmix64) of the simulation.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_state_ui - The state.
+ * \return    Returns the next random number.
+ *
+ *****************************************************************************/
+static inline uint64_t nextRandom(uint64_t& fr_state_ui)
+{
+    uint64_t z_ui = (fr_state_ui += 0x9e3779b97f4a7c15ULL);
+    z_ui = (z_ui ^ (z_ui >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z_ui = (z_ui ^ (z_ui >> 27)) * 0x94d049bb133111ebULL;
+    return z_ui ^ (z_ui >> 31);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Draw a uniform random number in (0, 1).
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_state_ui - State of the random number generator.
+ * \return    Returns the random number.
+ *
+ *****************************************************************************/
+static inline double nextUniform(uint64_t& fr_state_ui)
+{
+    return (double(nextRandom(fr_state_ui) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Draw a service time of a stage.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]     fr_model    - The model of the stage.
+ * \param[in,out] fr_state_ui - State of the random number generator.
+ * \return    Returns the service time in nanoseconds.
+ *
+ *****************************************************************************/
+static inline double sampleService(const ServiceModel& fr_model,
+                                   uint64_t&           fr_state_ui)
+{
+    if (fr_model.sortedNs.empty())
+        return 0.0;
+    if (fr_model.lognormal_b) {
+        // Box-Muller transform
+        const double normal_d = sqrt(-2.0 * log(nextUniform(fr_state_ui))) *
+                                cos(2.0 * M_PI * nextUniform(fr_state_ui));
+        return fr_model.shiftNs_d + exp(fr_model.mu_d + fr_model.sigma_d * normal_d);
+    }
+    const uint64_t size_ui = fr_model.sortedNs.size();
+    return double(fr_model.sortedNs[((nextRandom(fr_state_ui) >> 32) * size_ui) >> 32]);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Fit the model of a stage to a measured series.
+ *
+ *            Negative samples (e.g. by clock adjustments) are set to zero.
+ *            The shift of the lognormal is placed below the minimum by a
+ *            tenth of the distance between minimum and median, so the
+ *            logarithm of the shifted samples is finite.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_fileName  - The gnuplot data file of the series.
+ * \param[in]  f_lognormal_b - Use the shifted lognormal.
+ * \param[out] fr_model     - The model.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool fitServiceModel(const std::string& fr_fileName,
+                     const bool         f_lognormal_b,
+                     ServiceModel&      fr_model)
+{
+    std::vector<double> values;
+    if (!loadTimeSeries(fr_fileName, values))
+        return false;
+    if (values.empty()) {
+        printf("Error: %s has no samples!\n", fr_fileName.c_str());
+        return false;
+    }
+
+    // The files store milliseconds with six decimals, i.e., nanoseconds
+    double sumNs_d = 0.0;
+    fr_model.sortedNs.resize(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        fr_model.sortedNs[i] = std::max(0LL, llround(values[i] * 1000000.0));
+        sumNs_d += double(fr_model.sortedNs[i]);
+    }
+    std::sort(fr_model.sortedNs.begin(), fr_model.sortedNs.end());
+    fr_model.meanNs_d    = sumNs_d / double(values.size());
+    fr_model.lognormal_b = f_lognormal_b;
+
+    const double minNs_d    = double(fr_model.sortedNs.front());
+    const double medianNs_d = double(fr_model.sortedNs[fr_model.sortedNs.size() / 2]);
+    fr_model.shiftNs_d = std::max(0.0, minNs_d - std::max(1.0, 0.1 * (medianNs_d - minNs_d)));
+
+    double sum_d = 0.0, sumSquares_d = 0.0;
+    for (size_t i = 0; i < fr_model.sortedNs.size(); ++i) {
+        const double log_d = log(double(fr_model.sortedNs[i]) - fr_model.shiftNs_d);
+        sum_d        += log_d;
+        sumSquares_d += log_d * log_d;
+    }
+    const double count_d = double(fr_model.sortedNs.size());
+    fr_model.mu_d    = sum_d / count_d;
+    fr_model.sigma_d = sqrt(std::max(0.0, sumSquares_d / count_d - fr_model.mu_d * fr_model.mu_d));
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the model of a stage.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_stage_p - Name of the stage.
+ * \param[in] fr_model  - The model.
+ *
+ *****************************************************************************/
+void printServiceModel(const char*         f_stage_p,
+                       const ServiceModel& fr_model)
+{
+    if (fr_model.sortedNs.empty()) {
+        printf("  %-7s none\n", f_stage_p);
+        return;
+    }
+
+    const std::vector<int64_t>& sorted = fr_model.sortedNs;
+    printf("  %-7s %s: %llu samples, mean = %.3f, p50 = %.3f, p99 = %.3f ms",
+           f_stage_p, fr_model.series.c_str(), (unsigned long long) sorted.size(),
+           fr_model.meanNs_d / 1000000.0, double(sorted[sorted.size() / 2]) / 1000000.0,
+           double(sorted[size_t(0.99 * double(sorted.size() - 1))]) / 1000000.0);
+    if (fr_model.lognormal_b)
+        printf(", lognormal shift = %.3f ms, mu = %.3f, sigma = %.3f",
+               fr_model.shiftNs_d / 1000000.0, fr_model.mu_d, fr_model.sigma_d);
+    printf("\n");
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Load the models of a device.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_spec       - The device, DIR[:WEIGHT[:periodic]].
+ * \param[in]  fr_series     - The single series (--series), or empty.
+ * \param[in]  f_lognormal_b - Use the shifted lognormal.
+ * \param[out] fr_device     - The device.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool loadDevice(const std::string& fr_spec,
+                const std::string& fr_series,
+                const bool         f_lognormal_b,
+                SimDevice&         fr_device)
+{
+    fr_device.directory  = fr_spec;
+    fr_device.weight_d   = 1.0;
+    fr_device.periodic_b = false;
+
+    const size_t colon_ui = fr_spec.find(':');
+    if (colon_ui != std::string::npos) {
+        fr_device.directory = fr_spec.substr(0, colon_ui);
+        const std::string options = fr_spec.substr(colon_ui + 1);
+        const size_t      next_ui = options.find(':');
+        fr_device.weight_d = atof(options.substr(0, next_ui).c_str());
+        if (next_ui != std::string::npos) {
+            const std::string arrivals = options.substr(next_ui + 1);
+            if (arrivals == "periodic")
+                fr_device.periodic_b = true;
+            else if (arrivals != "poisson") {
+                printf("Error: Unknown arrivals '%s' of device %s!\n", arrivals.c_str(), fr_spec.c_str());
+                return false;
+            }
+        }
+        if (fr_device.weight_d <= 0.0) {
+            printf("Error: Expected a positive weight of device %s!\n", fr_spec.c_str());
+            return false;
+        }
+    }
+
+    const std::string prefix = fr_device.directory + "/";
+    if (!fr_series.empty())
+        fr_device.device.series = fr_series;
+    else if (fileExists(prefix + SIM_HOST_SERIES ".gpd") && fileExists(prefix + SIM_DEVICE_SERIES ".gpd")) {
+        fr_device.host.series   = SIM_HOST_SERIES;
+        fr_device.device.series = SIM_DEVICE_SERIES;
+    }
+    else {
+        printf("Info: %s has no %s series, using %s for the device stage.\n",
+               fr_device.directory.c_str(), SIM_HOST_SERIES, SIM_TOTAL_SERIES);
+        fr_device.device.series = SIM_TOTAL_SERIES;
+    }
+
+    if (!fr_device.host.series.empty() &&
+        !fitServiceModel(prefix + fr_device.host.series + ".gpd", f_lognormal_b, fr_device.host))
+        return false;
+    if (!fitServiceModel(prefix + fr_device.device.series + ".gpd", f_lognormal_b, fr_device.device))
+        return false;
+
+    // The measured round trip to validate the low load points
+    fr_device.recordedP50Ns_i = -1;
+    fr_device.recordedP99Ns_i = -1;
+    ServiceModel total;
+    if (fileExists(prefix + SIM_TOTAL_SERIES ".gpd") &&
+        fitServiceModel(prefix + SIM_TOTAL_SERIES ".gpd", false, total)) {
+        fr_device.recordedP50Ns_i = total.sortedNs[total.sortedNs.size() / 2];
+        fr_device.recordedP99Ns_i = total.sortedNs[size_t(0.99 * double(total.sortedNs.size() - 1))];
+    }
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Draw the time to the next arrival of a device.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]     fr_device   - The device.
+ * \param[in]     f_periodNs_d - The mean time between arrivals in ns.
+ * \param[in,out] fr_state_ui - State of the random number generator.
+ * \return    Returns the time in nanoseconds.
+ *
+ *****************************************************************************/
+static inline double nextInterArrival(const SimDevice& fr_device,
+                                      const double     f_periodNs_d,
+                                      uint64_t&        fr_state_ui)
+{
+    if (fr_device.periodic_b)
+        return f_periodNs_d;
+    return -log(nextUniform(fr_state_ui)) * f_periodNs_d;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Simulate a load point.
+ *
+ *            The arrivals of the devices are merged in time order. Since all
+ *            stations are FIFO, a request leaves a station at the service
+ *            time after the later of its arrival and the earliest free time
+ *            of the servers. The arrivals and the service times of each
+ *            device have their own random number generators derived from
+ *            the seed, so all load points see the same random numbers.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]     fr_devices - The devices.
+ * \param[in]     fr_options - The options.
+ * \param[in,out] fr_result  - The result, with the rate set.
+ *
+ *****************************************************************************/
+void simulate(const std::vector<SimDevice>& fr_devices,
+              const SimOptions&             fr_options,
+              SimResult&                    fr_result)
+{
+    const size_t   numDevices_ui  = fr_devices.size();
+    const size_t   numHosts_ui    = fr_options.hostPerDevice_b ? numDevices_ui : 1;
+    const uint32_t numServers_ui  = fr_options.deviceServers_ui;
+    const uint64_t numWarmup_ui   = uint64_t(SIM_WARMUP_FRACTION * double(fr_options.numRequests_ui));
+
+    std::vector<uint64_t> arrivalStates(numDevices_ui), serviceStates(numDevices_ui);
+    std::vector<double>   periodsNs(numDevices_ui), nextArrivalsNs(numDevices_ui);
+    std::vector<double>   hostFreeNs(numHosts_ui, 0.0), hostBusyNs(numHosts_ui, 0.0);
+    std::vector<double>   deviceFreeNs(numDevices_ui * std::max(numServers_ui, 1u), 0.0);
+    std::vector<double>   deviceBusyNs(numDevices_ui, 0.0);
+
+    fr_result.total.reset();
+    fr_result.devices.assign(numDevices_ui, HdrHistogram());
+    for (size_t d = 0; d < numDevices_ui; ++d) {
+        arrivalStates[d] = fr_options.seed_ui * 0x2545f4914f6cdd1dULL + 2 * d;
+        serviceStates[d] = fr_options.seed_ui * 0x2545f4914f6cdd1dULL + 2 * d + 1;
+        nextRandom(arrivalStates[d]);
+        nextRandom(serviceStates[d]);
+        periodsNs[d]      = 1000000000.0 / (fr_result.rate_d * fr_devices[d].weight_d);
+        nextArrivalsNs[d] = fr_devices[d].periodic_b ? nextUniform(arrivalStates[d]) * periodsNs[d]
+                                                     : nextInterArrival(fr_devices[d], periodsNs[d], arrivalStates[d]);
+    }
+
+    double warmupEndNs_d = 0.0, lastArrivalNs_d = 0.0;
+    for (uint64_t k = 0; k < fr_options.numRequests_ui; ++k) {
+        size_t d = 0;
+        for (size_t i = 1; i < numDevices_ui; ++i)
+            if (nextArrivalsNs[i] < nextArrivalsNs[d])
+                d = i;
+        const SimDevice& device = fr_devices[d];
+        const double arrivalNs_d = nextArrivalsNs[d];
+        nextArrivalsNs[d] += nextInterArrival(device, periodsNs[d], arrivalStates[d]);
+
+        if (k == numWarmup_ui) {
+            warmupEndNs_d = arrivalNs_d;
+            std::fill(hostBusyNs.begin(), hostBusyNs.end(), 0.0);
+            std::fill(deviceBusyNs.begin(), deviceBusyNs.end(), 0.0);
+        }
+        lastArrivalNs_d = arrivalNs_d;
+
+        // Host stage, a single server
+        const size_t h     = fr_options.hostPerDevice_b ? d : 0;
+        const double hostNs_d = sampleService(device.host, serviceStates[d]);
+        hostFreeNs[h]  = std::max(arrivalNs_d, hostFreeNs[h]) + hostNs_d;
+        hostBusyNs[h] += hostNs_d;
+
+        // Device stage, numServers_ui servers or a pure delay
+        const double deviceNs_d = sampleService(device.device, serviceStates[d]);
+        double departureNs_d;
+        if (numServers_ui == 0) {
+            departureNs_d = hostFreeNs[h] + deviceNs_d;
+        } else {
+            double* free_p = &deviceFreeNs[d * numServers_ui];
+            uint32_t s     = 0;
+            for (uint32_t i = 1; i < numServers_ui; ++i)
+                if (free_p[i] < free_p[s])
+                    s = i;
+            free_p[s]        = std::max(hostFreeNs[h], free_p[s]) + deviceNs_d;
+            departureNs_d    = free_p[s];
+        }
+        deviceBusyNs[d] += deviceNs_d;
+
+        if (k >= numWarmup_ui) {
+            const int64_t latencyNs_i = llround(departureNs_d - arrivalNs_d);
+            fr_result.total.record(latencyNs_i);
+            fr_result.devices[d].record(latencyNs_i);
+        }
+    }
+
+    // Utilizations over the measured requests
+    const double durationNs_d = std::max(1.0, lastArrivalNs_d - warmupEndNs_d);
+    fr_result.hostUtilization_d   = 0.0;
+    fr_result.deviceUtilization_d = 0.0;
+    for (size_t h = 0; h < numHosts_ui; ++h)
+        fr_result.hostUtilization_d = std::max(fr_result.hostUtilization_d, hostBusyNs[h] / durationNs_d);
+    for (size_t d = 0; d < numDevices_ui; ++d)
+        fr_result.deviceUtilization_d = std::max(fr_result.deviceUtilization_d,
+                                                 deviceBusyNs[d] / durationNs_d / double(std::max(numServers_ui, 1u)));
+    fr_result.numEvents_ui = 3 * fr_options.numRequests_ui;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Simulate load points in parallel.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_devices - The devices.
+ * \param[in]  fr_options - The options.
+ * \param[in]  fr_rates   - The rates of the load points.
+ * \param[out] fr_results - The results, one per rate.
+ *
+ *****************************************************************************/
+void simulatePoints(const std::vector<SimDevice>& fr_devices,
+                    const SimOptions&             fr_options,
+                    const std::vector<double>&    fr_rates,
+                    std::vector<SimResult>&       fr_results)
+{
+    fr_results.resize(fr_rates.size());
+    for (size_t i = 0; i < fr_rates.size(); ++i)
+        fr_results[i].rate_d = fr_rates[i];
+
+    std::atomic<uint32_t>    nextPoint(0);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < fr_options.numThreads_ui; ++t) {
+        threads.push_back(std::thread([&]() {
+            uint32_t p_ui;
+            while ((p_ui = nextPoint++) < fr_rates.size())
+                simulate(fr_devices, fr_options, fr_results[p_ui]);
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Estimate the capacity of the devices.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_devices - The devices.
+ * \param[in] fr_options - The options.
+ * \return    Returns the rate of a device of weight 1 at which the busiest
+ *            stage is fully utilized, or 0 if no stage takes time.
+ *
+ *****************************************************************************/
+double estimateCapacity(const std::vector<SimDevice>& fr_devices,
+                        const SimOptions&             fr_options)
+{
+    // Busy time per second at a rate of 1/s
+    double sharedHostS_d = 0.0, maxLoadS_d = 0.0;
+    for (size_t d = 0; d < fr_devices.size(); ++d) {
+        const SimDevice& device = fr_devices[d];
+        const double hostS_d = device.host.sortedNs.empty() ? 0.0 : device.weight_d * device.host.meanNs_d / 1e9;
+        sharedHostS_d += hostS_d;
+        maxLoadS_d     = std::max(maxLoadS_d, hostS_d);
+        if (fr_options.deviceServers_ui > 0)
+            maxLoadS_d = std::max(maxLoadS_d, device.weight_d * device.device.meanNs_d / 1e9 /
+                                              double(fr_options.deviceServers_ui));
+    }
+    if (!fr_options.hostPerDevice_b)
+        maxLoadS_d = std::max(maxLoadS_d, sharedHostS_d);
+    return (maxLoadS_d > 0.0) ? 1.0 / maxLoadS_d : 0.0;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if a load point meets the latency limit.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_result  - The result of the load point.
+ * \param[in] fr_options - The options.
+ * \return    Returns \c true if the percentile of all devices is within the
+ *            limit.
+ *
+ *****************************************************************************/
+bool meetsLimit(const SimResult&  fr_result,
+                const SimOptions& fr_options)
+{
+    const int64_t limitNs_i = llround(fr_options.limitMs_d * 1000000.0);
+    for (size_t d = 0; d < fr_result.devices.size(); ++d)
+        if (fr_result.devices[d].percentile(fr_options.limitPercentile_d) > limitNs_i)
+            return false;
+    return (fr_result.total.count() > 0);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Parse the rates of the load points.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_text  - The rates, a comma separated list or FROM:TO[:N].
+ * \param[out] fr_rates - The rates in 1/s.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool parseRates(const std::string&   fr_text,
+                std::vector<double>& fr_rates)
+{
+    fr_rates.clear();
+    if (fr_text.find(':') != std::string::npos) {
+        double   from_d = 0.0, to_d = 0.0;
+        uint32_t numPoints_ui = 20;
+        if (sscanf(fr_text.c_str(), "%lf:%lf:%u", &from_d, &to_d, &numPoints_ui) < 2)
+            return false;
+        if ((from_d <= 0.0) || (to_d < from_d) || (numPoints_ui == 0))
+            return false;
+        for (uint32_t i = 0; i < numPoints_ui; ++i)
+            fr_rates.push_back((numPoints_ui == 1) ? from_d
+                               : from_d + (to_d - from_d) * double(i) / double(numPoints_ui - 1));
+        return true;
+    }
+
+    for (size_t start_ui = 0; start_ui < fr_text.size(); ) {
+        size_t end_ui = fr_text.find(',', start_ui);
+        if (end_ui == std::string::npos)
+            end_ui = fr_text.size();
+        const double rate_d = atof(fr_text.substr(start_ui, end_ui - start_ui).c_str());
+        if (rate_d <= 0.0)
+            return false;
+        fr_rates.push_back(rate_d);
+        start_ui = end_ui + 1;
+    }
+    std::sort(fr_rates.begin(), fr_rates.end());
+    return !fr_rates.empty();
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Main entry point.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_argc_i - Number of arguments.
+ * \param[in] f_argv_p - Arguments.
+ * \return    Return code of the application.
+ *
+ *****************************************************************************/
+int main(int f_argc_i, char** f_argv_p) {
+    const char* progName_p = f_argv_p[0];
+    SimOptions options;
+    options.numRequests_ui    = 1000000;
+    options.deviceServers_ui  = 1;
+    options.hostPerDevice_b   = false;
+    options.limitMs_d         = 5.0;
+    options.limitPercentile_d = 99.0;
+    options.numThreads_ui     = std::thread::hardware_concurrency();
+    options.seed_ui           = 1;
+    std::string ratesStr   = "";
+    std::string series     = "";
+    std::string outputFile = "latencySim.txt";
+    bool        lognormal_b = false;
+    std::vector<std::string> arguments;
+
+    // Parse command line arguments
+    for (int i=1; i < f_argc_i; ++i) {
+        if ((strcmp(f_argv_p[i], "-h") == 0) ||
+            (strcmp(f_argv_p[i], "--help") == 0)) {
+            usage(progName_p);
+        }
+        else if ((strcmp(f_argv_p[i], "-r") == 0) ||
+                 (strcmp(f_argv_p[i], "--rates") == 0)) {
+          if (++i < f_argc_i) {
+            ratesStr = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --rates option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "-n") == 0) ||
+                 (strcmp(f_argv_p[i], "--requests") == 0)) {
+          if (++i < f_argc_i) {
+            options.numRequests_ui = strtoull(f_argv_p[i], NULL, 10);
+          } else {
+            printf("Error: Expected argument after --requests option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--servers") == 0)) {
+          if (++i < f_argc_i) {
+            options.deviceServers_ui = atoi(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --servers option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--host-per-device") == 0)) {
+          options.hostPerDevice_b = true;
+        }
+        else if ((strcmp(f_argv_p[i], "--series") == 0)) {
+          if (++i < f_argc_i) {
+            series = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --series option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--lognormal") == 0)) {
+          lognormal_b = true;
+        }
+        else if ((strcmp(f_argv_p[i], "--limit") == 0)) {
+          if (++i < f_argc_i) {
+            options.limitMs_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --limit option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--limit-percentile") == 0)) {
+          if (++i < f_argc_i) {
+            options.limitPercentile_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --limit-percentile option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "-o") == 0) ||
+                 (strcmp(f_argv_p[i], "--output") == 0)) {
+          if (++i < f_argc_i) {
+            outputFile = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --output option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "-j") == 0) ||
+                 (strcmp(f_argv_p[i], "--jobs") == 0)) {
+          if (++i < f_argc_i) {
+            options.numThreads_ui = atoi(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --jobs option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--seed") == 0)) {
+          if (++i < f_argc_i) {
+            options.seed_ui = strtoull(f_argv_p[i], NULL, 10);
+          } else {
+            printf("Error: Expected argument after --seed option!\n");
+            usage(progName_p);
+          }
+        }
+        else if (f_argv_p[i][0] == '-') {
+            printf("Error: Unknown option %s! Please see usage for available options!\n\n",
+                   f_argv_p[i]);
+            usage(progName_p);
+        }
+        else {
+            arguments.push_back(f_argv_p[i]);
+        }
+    }
+
+    if (arguments.empty()) {
+        printf("Error: Expected at least one device! Please see usage for syntax!\n\n");
+        usage(progName_p);
+    }
+    if ((options.numRequests_ui < 1000) || (options.limitMs_d <= 0.0) ||
+        (options.limitPercentile_d <= 0.0) || (options.limitPercentile_d > 100.0)) {
+        printf("Error: At least 1000 requests, a positive limit and a percentile up to 100 are required!\n\n");
+        usage(progName_p);
+    }
+    if (options.numThreads_ui == 0)
+        options.numThreads_ui = 1;
+
+    // Fit the models
+    std::vector<SimDevice> devices(arguments.size());
+    for (size_t d = 0; d < arguments.size(); ++d) {
+        if (!loadDevice(arguments[d], series, lognormal_b, devices[d]))
+            return 2;
+        printf("Device %zu: %s, weight %.3g, %s arrivals\n", d, devices[d].directory.c_str(),
+               devices[d].weight_d, devices[d].periodic_b ? "periodic" : "Poisson");
+        printServiceModel("host:", devices[d].host);
+        printServiceModel("device:", devices[d].device);
+        if (devices[d].recordedP50Ns_i >= 0)
+            printf("  measured round trip (" SIM_TOTAL_SERIES "): p50 = %.3f, p99 = %.3f ms\n",
+                   double(devices[d].recordedP50Ns_i) / 1000000.0, double(devices[d].recordedP99Ns_i) / 1000000.0);
+    }
+
+    const double capacity_d = estimateCapacity(devices, options);
+    std::vector<double> rates;
+    if (ratesStr.empty()) {
+        if (capacity_d <= 0.0) {
+            printf("Error: The model has no queueing, please give the rates with --rates!\n");
+            return 2;
+        }
+        for (uint32_t i = 0; i < 20; ++i)
+            rates.push_back(capacity_d * (0.05 + 0.93 * double(i) / 19.0));
+    }
+    else if (!parseRates(ratesStr, rates)) {
+        printf("Error: Invalid rates '%s'!\n\n", ratesStr.c_str());
+        usage(progName_p);
+    }
+    if (capacity_d > 0.0)
+        printf("Capacity: %.1f requests/s per device of weight 1\n", capacity_d);
+
+    // Simulate the load points
+    const uint64_t startNs_ui = getTimeStampNs();
+    std::vector<SimResult> results;
+    simulatePoints(devices, options, rates, results);
+    uint64_t numEvents_ui = 0;
+    for (size_t i = 0; i < results.size(); ++i)
+        numEvents_ui += results[i].numEvents_ui;
+
+    FILE* file_p = fopen(outputFile.c_str(), "w");
+    if (!file_p) {
+        printf("Error: Can't create %s!\n", outputFile.c_str());
+        return 2;
+    }
+    fprintf(file_p, "# Predicted latencies in ms of %zu device(s), %llu requests per load point, %u server(s) per device\n",
+            devices.size(), (unsigned long long) options.numRequests_ui, options.deviceServers_ui);
+    for (size_t d = 0; d < devices.size(); ++d)
+        fprintf(file_p, "# device %zu: %s, weight %.3g, %s arrivals\n", d, devices[d].directory.c_str(),
+                devices[d].weight_d, devices[d].periodic_b ? "periodic" : "Poisson");
+    fprintf(file_p, "# rate total_rate host_utilization device_utilization p50 p90 p99 p99.9 max");
+    for (size_t d = 0; d < devices.size(); ++d)
+        fprintf(file_p, " device%zu_p%g", d, options.limitPercentile_d);
+    fprintf(file_p, "\n");
+
+    double weights_d = 0.0;
+    for (size_t d = 0; d < devices.size(); ++d)
+        weights_d += devices[d].weight_d;
+
+    printf("\n%10s %9s %9s %9s %9s %9s %9s %9s\n", "rate [1/s]", "host", "device",
+           "p50", "p90", "p99", "p99.9", "max [ms]");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const SimResult&    result = results[i];
+        const HdrHistogram& total  = result.total;
+        printf("%10.1f %8.1f%% %8.1f%% %9.3f %9.3f %9.3f %9.3f %9.3f%s\n",
+               result.rate_d, 100.0 * result.hostUtilization_d, 100.0 * result.deviceUtilization_d,
+               double(total.percentile(50.0)) / 1000000.0, double(total.percentile(90.0)) / 1000000.0,
+               double(total.percentile(99.0)) / 1000000.0, double(total.percentile(99.9)) / 1000000.0,
+               double(total.max()) / 1000000.0,
+               ((result.hostUtilization_d >= 0.99) || (result.deviceUtilization_d >= 0.99)) ? " (saturated)" : "");
+        fprintf(file_p, "%.3f %.3f %.4f %.4f %.6f %.6f %.6f %.6f %.6f",
+                result.rate_d, result.rate_d * weights_d, result.hostUtilization_d, result.deviceUtilization_d,
+                double(total.percentile(50.0)) / 1000000.0, double(total.percentile(90.0)) / 1000000.0,
+                double(total.percentile(99.0)) / 1000000.0, double(total.percentile(99.9)) / 1000000.0,
+                double(total.max()) / 1000000.0);
+        for (size_t d = 0; d < result.devices.size(); ++d)
+            fprintf(file_p, " %.6f", double(result.devices[d].percentile(options.limitPercentile_d)) / 1000000.0);
+        fprintf(file_p, "\n");
+    }
+    fclose(file_p);
+
+    // Search the highest rate meeting the limit between the load points
+    size_t numPassed_ui = 0;
+    while ((numPassed_ui < results.size()) && meetsLimit(results[numPassed_ui], options))
+        ++numPassed_ui;
+
+    printf("\n");
+    if (numPassed_ui == 0) {
+        printf("Result: The p%g limit of %.3f ms is exceeded already at %.1f requests/s.\n",
+               options.limitPercentile_d, options.limitMs_d, rates.front());
+    }
+    else if (numPassed_ui == results.size()) {
+        printf("Result: The p%g limit of %.3f ms is met up to %.1f requests/s, the highest simulated rate.\n",
+               options.limitPercentile_d, options.limitMs_d, rates.back());
+    }
+    else {
+        double passRate_d = rates[numPassed_ui - 1], failRate_d = rates[numPassed_ui];
+        for (uint32_t round_ui = 0; round_ui < SIM_SEARCH_ROUNDS; ++round_ui) {
+            std::vector<double> searchRates;
+            for (uint32_t i = 1; i <= options.numThreads_ui; ++i)
+                searchRates.push_back(passRate_d + (failRate_d - passRate_d) * double(i) /
+                                                   double(options.numThreads_ui + 1));
+            std::vector<SimResult> searchResults;
+            simulatePoints(devices, options, searchRates, searchResults);
+            for (size_t i = 0; i < searchResults.size(); ++i) {
+                numEvents_ui += searchResults[i].numEvents_ui;
+                if (!meetsLimit(searchResults[i], options)) {
+                    failRate_d = searchRates[i];
+                    break;
+                }
+                passRate_d = searchRates[i];
+            }
+        }
+        printf("Result: The p%g limit of %.3f ms is met up to %.1f requests/s per device of weight 1 "
+               "(%.1f requests/s in total).\n",
+               options.limitPercentile_d, options.limitMs_d, passRate_d, passRate_d * weights_d);
+    }
+
+    const float durationMs_f = getMilliseconds(startNs_ui, getTimeStampNs());
+    printf("Info: Simulated %.1f million events in %.2f s (%.1f million events/s) on %u threads.\n",
+           double(numEvents_ui) / 1e6, durationMs_f / 1000.0, double(numEvents_ui) / 1e3 / durationMs_f,
+           options.numThreads_ui);
+    printf("Info: Curves saved to %s.\n", outputFile.c_str());
+    return 0;
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
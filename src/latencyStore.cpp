@@ -0,0 +1,670 @@
+/* ********************************* FILE ************************************/
+/** \file    latencyStore.cpp
+ *
+ * \brief    This file describes the main entry point of the latencyStore
+ *           tool to import results into the compact results archive and to
+ *           query percentile tables across runs.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <fnmatch.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include "latencySeries.h"
+#include "resultsStore.h"
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// A table of strings, the first row is the title
+typedef std::vector<std::vector<std::string> > Table_t;
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// Metadata keys shown first by the list command
+static const char* g_preferredKeys_p[] = {
+  "path", "board", "kernel", "driver", "device", "adapter", "latency", "payload", "load", "date", NULL
+};
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the usage and exit.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_progName_p - Name of the program.
+ *
+ *****************************************************************************/
+void usage(const char* f_progName_p)
+{
+    printf("Usage: %s [--store FILE] import <directory> [key=value ...]\n"
+           "       %s [--store FILE] list [key=pattern ...]\n"
+           "       %s [--store FILE] query [key=pattern ...] [<Options>]\n"
+           "\n"
+           "Maintain a compact archive of measured time series and query\n"
+           "percentile tables across runs.\n"
+           "\n"
+           "Commands:\n"
+           "  import: Import all directories below <directory> containing time\n"
+           "          series (*.gpd except *_histogram.gpd) as runs. The metadata\n"
+           "          of a run is taken from its path <board>/<driver>[_<device>]/<adapter>,\n"
+           "          from a run.info file (key = value lines) written by\n"
+           "          latencyTest and from the key=value arguments. A run with\n"
+           "          the same path (the last three directory names) is replaced.\n"
+           "  list:   List the runs matching the filters.\n"
+           "  query:  Print the percentiles in milliseconds of the series of all\n"
+           "          runs matching the filters. The filter patterns are shell\n"
+           "          wildcards, e.g. board=odroid* adapter=nano_*.\n"
+           "\n"
+           "Options:\n"
+           "  -h|--help:        Print this help.\n"
+           "  --store FILE:     The archive [default: results.lst].\n"
+           "  --series PATTERN: Query only the matching series [default: *].\n"
+           "  -p|--percentiles LIST: Comma separated percentiles, 'min' and 'max'\n"
+           "                    [default: min,10,50,90,99,99.9,max].\n"
+           "  --group-by KEYS:  Comma separated metadata keys. The series of all\n"
+           "                    runs with the same values are combined. Use 'none'\n"
+           "                    to combine all matching runs [default: path].\n",
+           f_progName_p, f_progName_p, f_progName_p);
+    exit(1);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Split a string at a separator.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_string    - The string.
+ * \param[in] f_separator_c - The separator.
+ * \return    Returns the non-empty parts.
+ *
+ *****************************************************************************/
+std::vector<std::string> split(const std::string& fr_string,
+                               const char         f_separator_c)
+{
+    std::vector<std::string> parts;
+    size_t start_ui = 0;
+    while (start_ui <= fr_string.size()) {
+        size_t end_ui = fr_string.find(f_separator_c, start_ui);
+        if (end_ui == std::string::npos)
+            end_ui = fr_string.size();
+        if (end_ui > start_ui)
+            parts.push_back(fr_string.substr(start_ui, end_ui - start_ui));
+        start_ui = end_ui + 1;
+    }
+    return parts;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Trim white space at the beginning and the end of a string.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_string - The string.
+ * \return    Returns the trimmed string.
+ *
+ *****************************************************************************/
+std::string trim(const std::string& fr_string)
+{
+    const size_t start_ui = fr_string.find_first_not_of(" \t\r\n");
+    if (start_ui == std::string::npos)
+        return "";
+    return fr_string.substr(start_ui, fr_string.find_last_not_of(" \t\r\n") - start_ui + 1);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Parse key=value arguments.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_arguments - The arguments.
+ * \param[out] fr_pairs     - The keys and values.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool parseKeyValues(const std::vector<std::string>& fr_arguments,
+                    RunMetadata_t&                  fr_pairs)
+{
+    for (size_t i = 0; i < fr_arguments.size(); ++i) {
+        const size_t pos_ui = fr_arguments[i].find('=');
+        if ((pos_ui == std::string::npos) || (pos_ui == 0)) {
+            printf("Error: Expected key=value instead of %s!\n", fr_arguments[i].c_str());
+            return false;
+        }
+        fr_pairs[fr_arguments[i].substr(0, pos_ui)] = fr_arguments[i].substr(pos_ui + 1);
+    }
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if the metadata of a run matches all filters.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_run     - The run.
+ * \param[in] fr_filters - The filters (key -> shell wildcard pattern).
+ * \return    Returns \c true if the run matches.
+ *
+ *****************************************************************************/
+bool matches(const StoredRun&     fr_run,
+             const RunMetadata_t& fr_filters)
+{
+    for (RunMetadata_t::const_iterator i = fr_filters.begin(); i != fr_filters.end(); ++i) {
+        RunMetadata_t::const_iterator value = fr_run.metadata.find(i->first);
+        const std::string valueStr = (value != fr_run.metadata.end()) ? value->second : "";
+        if (fnmatch(i->second.c_str(), valueStr.c_str(), 0) != 0)
+            return false;
+    }
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print a table with aligned columns.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_table         - The table, the first row is the title.
+ * \param[in] f_numTextCols_ui - Number of left aligned columns. All other
+ *                               columns are right aligned.
+ *
+ *****************************************************************************/
+void printTable(const Table_t& fr_table,
+                const size_t   f_numTextCols_ui)
+{
+    std::vector<size_t> widths;
+    for (size_t r = 0; r < fr_table.size(); ++r) {
+        widths.resize(std::max(widths.size(), fr_table[r].size()), 0);
+        for (size_t c = 0; c < fr_table[r].size(); ++c)
+            widths[c] = std::max(widths[c], fr_table[r][c].size());
+    }
+
+    for (size_t r = 0; r < fr_table.size(); ++r) {
+        for (size_t c = 0; c < fr_table[r].size(); ++c) {
+            if (c < f_numTextCols_ui)
+                printf("%s%-*s", (c > 0) ? "  " : "", int(widths[c]), fr_table[r][c].c_str());
+            else
+                printf("  %*s", int(widths[c]), fr_table[r][c].c_str());
+        }
+        printf("\n");
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Read the metadata of a run.info file.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]     fr_fileName - The file name.
+ * \param[in,out] fr_metadata - The metadata.
+ *
+ *****************************************************************************/
+void readRunInfo(const std::string& fr_fileName,
+                 RunMetadata_t&     fr_metadata)
+{
+    FILE* file_p = fopen(fr_fileName.c_str(), "r");
+    if (!file_p)
+        return;
+
+    char line[512];
+    while (fgets(line, sizeof(line), file_p)) {
+        const std::string lineStr = trim(line);
+        const size_t      pos_ui  = lineStr.find('=');
+        if (lineStr.empty() || (lineStr[0] == '#') || (pos_ui == std::string::npos))
+            continue;
+        fr_metadata[trim(lineStr.substr(0, pos_ui))] = trim(lineStr.substr(pos_ui + 1));
+    }
+    fclose(file_p);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Import all runs below a directory.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_store    - The archive.
+ * \param[in]     fr_root     - The directory given on the command line.
+ * \param[in]     fr_path     - Path of the current directory relative to the
+ *                              root.
+ * \param[in]     fr_metadata - Metadata given on the command line.
+ * \param[in,out] fr_textSize_ui - Size of the imported text files.
+ * \return    Returns the number of imported runs or -1 on error.
+ *
+ *****************************************************************************/
+int32_t importDirectory(ResultsStore&        fr_store,
+                        const std::string&   fr_root,
+                        const std::string&   fr_path,
+                        const RunMetadata_t& fr_metadata,
+                        uint64_t&            fr_textSize_ui)
+{
+    const std::string directory = fr_path.empty() ? fr_root : fr_root + "/" + fr_path;
+    DIR* dir_p = opendir(directory.c_str());
+    if (!dir_p) {
+        printf("Error: Can't read directory %s!\n", directory.c_str());
+        return -1;
+    }
+
+    std::vector<std::string> subDirectories, seriesFiles;
+    struct dirent* entry_p;
+    while ((entry_p = readdir(dir_p)) != NULL) {
+        const std::string name = entry_p->d_name;
+        if (name[0] == '.')
+            continue;
+
+        struct stat fileStat;
+        if (stat((directory + "/" + name).c_str(), &fileStat) != 0)
+            continue;
+
+        if (S_ISDIR(fileStat.st_mode)) {
+            subDirectories.push_back(name);
+        } else if ((name.size() > 4) && (name.compare(name.size() - 4, 4, ".gpd") == 0) &&
+                   ((name.size() < 14) || (name.compare(name.size() - 14, 14, "_histogram.gpd") != 0))) {
+            seriesFiles.push_back(name);
+            fr_textSize_ui += fileStat.st_size;
+        }
+    }
+    closedir(dir_p);
+
+    int32_t numRuns_i = 0;
+    if (!seriesFiles.empty()) {
+        // Layout of results/: <board>/<driver>[_<device>]/<adapter>. The
+        // path of the run does not depend on the imported directory.
+        RunMetadata_t metadata;
+        char          realPath[PATH_MAX];
+        const std::vector<std::string> components = split(realpath(directory.c_str(), realPath) ? realPath : directory, '/');
+        metadata["path"] = directory;
+        if (components.size() >= 3) {
+            metadata["path"] = components[components.size() - 3] + "/" + components[components.size() - 2] + "/" +
+                               components[components.size() - 1];
+            const std::string driver = components[components.size() - 2];
+            const size_t      pos_ui = driver.find('_');
+            metadata["board"]   = components[components.size() - 3];
+            metadata["driver"]  = driver.substr(0, pos_ui);
+            metadata["adapter"] = components[components.size() - 1];
+            if (pos_ui != std::string::npos)
+                metadata["device"] = driver.substr(pos_ui + 1);
+        }
+        readRunInfo(directory + "/run.info", metadata);
+        for (RunMetadata_t::const_iterator i = fr_metadata.begin(); i != fr_metadata.end(); ++i)
+            metadata[i->first] = i->second;
+
+        std::map<std::string, std::vector<int64_t> > series;
+        uint64_t numSamples_ui = 0;
+        for (size_t i = 0; i < seriesFiles.size(); ++i) {
+            std::vector<double> values;
+            if (!loadTimeSeries(directory + "/" + seriesFiles[i], values))
+                return -1;
+
+            // The files store milliseconds with six decimals, i.e., nanoseconds
+            std::vector<int64_t>& valuesNs = series[seriesFiles[i].substr(0, seriesFiles[i].size() - 4)];
+            valuesNs.reserve(values.size());
+            for (size_t j = 0; j < values.size(); ++j)
+                valuesNs.push_back(llround(values[j] * 1000000.0));
+            numSamples_ui += values.size();
+        }
+
+        fr_store.addRun(metadata, series);
+        printf("Info: Imported %s (%zu series, %llu samples).\n", metadata["path"].c_str(),
+               series.size(), (unsigned long long) numSamples_ui);
+        ++numRuns_i;
+    }
+
+    std::sort(subDirectories.begin(), subDirectories.end());
+    for (size_t i = 0; i < subDirectories.size(); ++i) {
+        const int32_t numSubRuns_i = importDirectory(fr_store, fr_root,
+                                                     fr_path.empty() ? subDirectories[i] : fr_path + "/" + subDirectories[i],
+                                                     fr_metadata, fr_textSize_ui);
+        if (numSubRuns_i < 0)
+            return -1;
+        numRuns_i += numSubRuns_i;
+    }
+
+    return numRuns_i;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     List the runs matching the filters.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_store   - The archive.
+ * \param[in] fr_filters - The filters.
+ *
+ *****************************************************************************/
+void listRuns(const ResultsStore&  fr_store,
+              const RunMetadata_t& fr_filters)
+{
+    const std::vector<StoredRun>& runs = fr_store.runs();
+
+    // Columns: preferred keys, then all other keys in alphabetical order
+    std::vector<std::string> keys;
+    for (uint32_t i = 0; g_preferredKeys_p[i] != NULL; ++i)
+        keys.push_back(g_preferredKeys_p[i]);
+    for (size_t r = 0; r < runs.size(); ++r) {
+        for (RunMetadata_t::const_iterator i = runs[r].metadata.begin(); i != runs[r].metadata.end(); ++i) {
+            if (std::find(keys.begin(), keys.end(), i->first) == keys.end())
+                keys.push_back(i->first);
+        }
+    }
+
+    Table_t table(1, keys);
+    table[0].push_back("series");
+    table[0].push_back("samples");
+    for (size_t r = 0; r < runs.size(); ++r) {
+        if (!matches(runs[r], fr_filters))
+            continue;
+
+        std::vector<std::string> row;
+        for (size_t k = 0; k < keys.size(); ++k) {
+            RunMetadata_t::const_iterator value = runs[r].metadata.find(keys[k]);
+            row.push_back(((value != runs[r].metadata.end()) && !value->second.empty()) ? value->second : "-");
+        }
+        uint64_t numSamples_ui = 0;
+        for (size_t s = 0; s < runs[r].series.size(); ++s)
+            numSamples_ui += runs[r].series[s].count_ui;
+        row.push_back(std::to_string(runs[r].series.size()));
+        row.push_back(std::to_string(numSamples_ui));
+        table.push_back(row);
+    }
+
+    printTable(table, keys.size());
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print the percentiles of the series of all runs matching the
+ *            filters.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_store         - The archive.
+ * \param[in] fr_filters       - The filters.
+ * \param[in] fr_seriesPattern - Pattern of the series names.
+ * \param[in] fr_percentiles   - The percentiles.
+ * \param[in] fr_groupBy       - The metadata keys to group the runs by.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool queryRuns(const ResultsStore&             fr_store,
+               const RunMetadata_t&            fr_filters,
+               const std::string&              fr_seriesPattern,
+               const std::vector<double>&      fr_percentiles,
+               const std::vector<std::string>& fr_groupBy)
+{
+    const std::vector<StoredRun>& runs = fr_store.runs();
+
+    // Group the matching series by the values of the group keys and the series name
+    typedef std::pair<std::vector<std::string>, std::string> GroupKey_t;
+    std::map<GroupKey_t, std::vector<const StoredSeries*> > groups;
+    for (size_t r = 0; r < runs.size(); ++r) {
+        if (!matches(runs[r], fr_filters))
+            continue;
+
+        GroupKey_t key;
+        for (size_t k = 0; k < fr_groupBy.size(); ++k) {
+            RunMetadata_t::const_iterator value = runs[r].metadata.find(fr_groupBy[k]);
+            key.first.push_back(((value != runs[r].metadata.end()) && !value->second.empty()) ? value->second : "-");
+        }
+        for (size_t s = 0; s < runs[r].series.size(); ++s) {
+            if (fnmatch(fr_seriesPattern.c_str(), runs[r].series[s].name.c_str(), 0) != 0)
+                continue;
+            key.second = runs[r].series[s].name;
+            groups[key].push_back(&runs[r].series[s]);
+        }
+    }
+
+    // Map the percentiles to the summary, if possible
+    const double*        summary_p = ResultsStore::summaryPercentiles();
+    std::vector<int32_t> summaryIdx;
+    bool                 useSummary_b = true;
+    for (size_t p = 0; p < fr_percentiles.size(); ++p) {
+        const double* found_p = std::find(summary_p, summary_p + RESULTS_NUM_SUMMARY, fr_percentiles[p]);
+        summaryIdx.push_back(int32_t(found_p - summary_p));
+        useSummary_b = useSummary_b && (found_p != summary_p + RESULTS_NUM_SUMMARY);
+    }
+
+    Table_t table(1, fr_groupBy);
+    table[0].push_back("series");
+    table[0].push_back("samples");
+    for (size_t p = 0; p < fr_percentiles.size(); ++p) {
+        char title[32];
+        if (fr_percentiles[p] <= 0.0)
+            snprintf(title, sizeof(title), "min");
+        else if (fr_percentiles[p] >= 100.0)
+            snprintf(title, sizeof(title), "max");
+        else
+            snprintf(title, sizeof(title), "p%g", fr_percentiles[p]);
+        table[0].push_back(title);
+    }
+
+    for (std::map<GroupKey_t, std::vector<const StoredSeries*> >::const_iterator g = groups.begin();
+         g != groups.end(); ++g) {
+        const std::vector<const StoredSeries*>& series = g->second;
+        std::vector<int64_t> results;
+        uint64_t             numSamples_ui = 0;
+
+        if ((series.size() == 1) && useSummary_b) {
+            for (size_t p = 0; p < fr_percentiles.size(); ++p)
+                results.push_back(series[0]->summaryNs_i[summaryIdx[p]]);
+            numSamples_ui = series[0]->count_ui;
+        } else {
+            std::vector<int64_t> values;
+            for (size_t s = 0; s < series.size(); ++s) {
+                if (!fr_store.decode(*series[s], values))
+                    return false;
+            }
+            numSamples_ui = values.size();
+            resultsPercentiles(values, fr_percentiles, results);
+        }
+
+        std::vector<std::string> row(g->first.first);
+        row.push_back(g->first.second);
+        row.push_back(std::to_string(numSamples_ui));
+        for (size_t p = 0; p < results.size(); ++p) {
+            char value[32];
+            snprintf(value, sizeof(value), "%.4f", double(results[p]) / 1000000.0);
+            row.push_back(value);
+        }
+        table.push_back(row);
+    }
+
+    printTable(table, fr_groupBy.size() + 1);
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Main entry point.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_argc_i - Number of arguments.
+ * \param[in] f_argv_p - Arguments.
+ * \return    Return code of the application.
+ *
+ *****************************************************************************/
+int main(int f_argc_i, char** f_argv_p) {
+    const char* progName_p = f_argv_p[0];
+    std::string storeFileName = "results.lst";
+    std::string seriesPattern = "*";
+    std::string percentilesStr = "min,10,50,90,99,99.9,max";
+    std::string groupByStr = "path";
+    std::vector<std::string> arguments;
+
+    // Parse command line arguments
+    for (int i=1; i < f_argc_i; ++i) {
+        if ((strcmp(f_argv_p[i], "-h") == 0) ||
+            (strcmp(f_argv_p[i], "--help") == 0)) {
+            usage(progName_p);
+        }
+        else if ((strcmp(f_argv_p[i], "--store") == 0)) {
+          if (++i < f_argc_i) {
+            storeFileName = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --store option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--series") == 0)) {
+          if (++i < f_argc_i) {
+            seriesPattern = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --series option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "-p") == 0) ||
+                 (strcmp(f_argv_p[i], "--percentiles") == 0)) {
+          if (++i < f_argc_i) {
+            percentilesStr = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --percentiles option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--group-by") == 0)) {
+          if (++i < f_argc_i) {
+            groupByStr = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --group-by option!\n");
+            usage(progName_p);
+          }
+        }
+        else if (f_argv_p[i][0] == '-') {
+            printf("Error: Unknown option %s! Please see usage for available options!\n\n",
+                   f_argv_p[i]);
+            usage(progName_p);
+        }
+        else {
+            arguments.push_back(f_argv_p[i]);
+        }
+    }
+
+    if (arguments.empty()) {
+        printf("Error: Expected a command! Please see usage for syntax!\n\n");
+        usage(progName_p);
+    }
+
+    const std::string command = arguments[0];
+    arguments.erase(arguments.begin());
+
+    ResultsStore store;
+    if (!store.load(storeFileName))
+        return 2;
+
+    if (command == "import") {
+        if (arguments.empty()) {
+            printf("Error: Expected a directory to import! Please see usage for syntax!\n\n");
+            usage(progName_p);
+        }
+        std::string root = arguments[0];
+        while ((root.size() > 1) && (root[root.size() - 1] == '/'))
+            root.erase(root.size() - 1);
+        arguments.erase(arguments.begin());
+
+        RunMetadata_t metadata;
+        if (!parseKeyValues(arguments, metadata))
+            usage(progName_p);
+
+        uint64_t textSize_ui = 0;
+        const int32_t numRuns_i = importDirectory(store, root, "", metadata, textSize_ui);
+        if (numRuns_i < 0)
+            return 3;
+        if (!store.save(storeFileName))
+            return 4;
+
+        struct stat fileStat;
+        if ((numRuns_i > 0) && (stat(storeFileName.c_str(), &fileStat) == 0)) {
+            printf("Info: Imported %d runs (%llu bytes of text), %s has %llu bytes.\n", numRuns_i,
+                   (unsigned long long) textSize_ui, storeFileName.c_str(), (unsigned long long) fileStat.st_size);
+        }
+    }
+    else if ((command == "list") || (command == "query")) {
+        RunMetadata_t filters;
+        if (!parseKeyValues(arguments, filters))
+            usage(progName_p);
+
+        if (command == "list") {
+            listRuns(store, filters);
+        } else {
+            std::vector<double>            percentiles;
+            const std::vector<std::string> percentileStrs = split(percentilesStr, ',');
+            for (size_t i = 0; i < percentileStrs.size(); ++i) {
+                if (percentileStrs[i] == "min")
+                    percentiles.push_back(0.0);
+                else if (percentileStrs[i] == "max")
+                    percentiles.push_back(100.0);
+                else
+                    percentiles.push_back(atof(percentileStrs[i].c_str()));
+            }
+
+            std::vector<std::string> groupBy = split(groupByStr, ',');
+            if ((groupBy.size() == 1) && (groupBy[0] == "none"))
+                groupBy.clear();
+
+            if (!queryRuns(store, filters, seriesPattern, percentiles, groupBy))
+                return 3;
+        }
+    }
+    else {
+        printf("Error: Unknown command %s! Please see usage for available commands!\n\n", command.c_str());
+        usage(progName_p);
+    }
+
+    return 0;
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
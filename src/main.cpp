@@ -12,15 +12,23 @@
 /*****************************************************************************
  * SETTINGS
  ******************************************************************************/
-#ifdef ON_RASPBERRY_PI
-  #define GPIO_ARDUINO       7
-  #define GPIO_INTTEST_OUT  24
-  #define GPIO_INTTEST_IN   25
-#else
-  #define GPIO_ARDUINO      27
-  #define GPIO_INTTEST_OUT   2
-  #define GPIO_INTTEST_IN    3
-#endif
+/// Banner sent by the Arduino at the end of setup()
+#define ARDUINO_READY_BANNER     "LATENCY_READY\n"
+
+/// Byte sent to check if a running Arduino echoes
+#define ARDUINO_PROBE_BYTE       0x00
+
+/// Time to wait for the echo of the probe byte in milliseconds
+#define ARDUINO_PROBE_TIMEOUT_MS 200
+
+/// Time to wait for trailing bytes before the input is flushed in milliseconds
+#define ARDUINO_SETTLE_TIME_MS   20
+
+/// Default payload sizes of the payload test, around the 64 byte USB packets
+#define PAYLOAD_DEFAULT_SIZES    "1,8,32,63,64,65,127,128,129,256,512,1024,2048,4096"
+
+/// Maximum time without data from the Arduino during a payload transfer in ms
+#define PAYLOAD_TIMEOUT_MS       500
 
 
 /*****************************************************************************
@@ -31,20 +39,96 @@
 #include <string.h>
 #include <string>
 #include <stdlib.h>
+#include <math.h>
 #include <sys/stat.h>
 #include <errno.h>
 #include <termios.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sched.h>
+#include <poll.h>
+#include <sys/ioctl.h>
 #include <time.h>
+#include <sys/timerfd.h>
+#include <sys/utsname.h>
 #include <vector>
 #include <algorithm>
-
-#if defined(ON_RASPBERRY_PI) or defined(ON_ODROID_XU4)
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "backgroundLoad.h"
+#include "board.h"
+#include "captureFile.h"
+#include "ftraceSnapshot.h"
+#include "latencySeries.h"
+#include "payload.h"
+#include "sampleTarget.h"
+#include "serialTiming.h"
+#include "telemetry.h"
+
+#ifdef HAVE_WIRINGPI
   #include <wiringPi.h>
 #endif
 
 
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+/// Time between two iterations of the interrupt test
+#define INTERRUPT_TEST_PERIOD_US 2000
+
+/// Longest sleep period of the wakeup latency test
+#define WAKEUP_MAX_PERIOD_US     1000000
+
+/// Largest number of bytes sent at once by the bulk test
+#define BULK_MAX_SIZE            (1024 * 1024)
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Backends of the GPIO interrupts, see the GpioBackend classes below
+enum GpioBackend_t {
+  GPIO_BACKEND_NONE,       ///< No GPIO connections, only the serial tests
+  GPIO_BACKEND_USERSPACE,  ///< Interrupt handlers of wiringPi
+  GPIO_BACKEND_KMOD        ///< Interrupt handlers of the gpiotiming kernel module
+};
+
+/// Settings of the concurrent test (--concurrent option)
+struct ConcurrentSettings {
+  int32_t  interruptCore_i;       ///< Core of the interrupt test, -1 keeps the affinity
+  int32_t  serialCore_i;          ///< Core of the serial test, -1 keeps the affinity
+  uint32_t numInterruptLoops_ui;  ///< Loops of the interrupt test
+  uint32_t numSerialLoops_ui;     ///< Loops of the serial test
+  uint32_t rateHz_ui;             ///< Rate of the serial test in Hz
+  bool     baseline_b;            ///< Run each test alone first
+};
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// Capture of the raw timestamps of all tests (--capture option)
+CaptureWriter g_capture;
+
+/// Live telemetry of the measurement (--telemetry and --prometheus options)
+Telemetry g_telemetry;
+
+/// Background load during the tests (--load option)
+static BackgroundLoad g_load;
+
+/// The board (--board option or detected from the device tree)
+static BoardDescriptor g_board;
+
+/// The backend of the GPIO interrupts (--kmod option)
+static GpioBackend_t g_gpioBackend = GPIO_BACKEND_NONE;
+
+/// Names of the GPIO backends as used for the directories in results/
+static const char* g_gpioBackendNames_p[] = { "none", "userspace", "kmod" };
+
+
 /* ********************************* METHOD **********************************/
 /**
  * \brief     Print the usage and exit.
@@ -61,29 +145,14 @@ void usage(const char* f_progName_p)
            "\n"
            "Measure the times from writing a single byte on the serial port\n"
            "and the response from the Arduino.\n"
-#ifdef ON_RASPBERRY_PI
-           "In addition, the signal from the Arduino is received over the\n"
-           "GPIO (Physical Pin 7/WiringPi Pin 7/BCM Pin 4) and the time\n"
-           "is measured using an interrupt handler.\n"
-           "To determine the latency of the interrupt handler, we use a\n"
-           "connection between the Physical Pin 35/Wiring Pi Pin 24/BCM Pin 19\n"
-           "and the Physical Pin 37/Wiring Pi Pin 25/BCM Pin 26 where we use\n"
-           "the first pin as an output and the second one as an input.\n"
-           "Then we measure the time between setting the output pin to HIGH\n"
-           "and the interrupt handler call.\n"
-#endif
-
-#ifdef ON_ODROID_XU4
-           "In addition, the signal from the Arduino is received over the\n"
-           "GPIO (Physical Pin 27/WiringPi Pin 27/GPIO 33) and the time\n"
-           "is measured using an interrupt handler.\n"
+           "On boards with GPIOs (see --board), the signal from the Arduino\n"
+           "is received over a GPIO in addition and the time is measured\n"
+           "using an interrupt handler.\n"
            "To determine the latency of the interrupt handler, we use a\n"
-           "connection between the Physical Pin 13/Wiring Pi Pin 2/GPIO 21\n"
-           "and the Physical Pin 17/Wiring Pi Pin 3/GPIO 22 where we use\n"
-           "the first pin as an output and the second one as an input.\n"
+           "connection between two pins of the board where we use the first\n"
+           "pin as an output and the second one as an input.\n"
            "Then we measure the time between setting the output pin to HIGH\n"
            "and the interrupt handler call.\n"
-#endif
            "\n"
            "Arguments:\n"
            "  device: The serial device, e.g., 'ttyUSB0'.\n"
@@ -92,21 +161,173 @@ void usage(const char* f_progName_p)
            "  -h|--help:      Print this help.\n"
            "  -l|--latency N: Set the FTDI read latency timer to the given\n"
            "                  value in milliseconds [default: 1ms].\n"
-           "  -s|--size N:    Send N bytes at once [default: 1].\n"
-#if defined(ON_RASPBERRY_PI) or defined(ON_ODROID_XU4)
+           "  -s|--size N:    Send N bytes at once, 1 to 1048576 [default: 1].\n"
+           "  --board B:      The board, given by the name of a built-in board\n"
+           "                  or by a board file (see --print-board)\n"
+           "                  [default: detected from the device tree].\n"
+           "  --print-board:  Print the board in the format of a board file\n"
+           "                  and exit.\n"
+           "  --kmod:         Use the interrupt handlers of the gpiotiming kernel\n"
+           "                  module instead of the ones of wiringPi.\n"
+           "  --core N:       Run the measurement on core N, -1 keeps the\n"
+           "                  affinity [default: the core of the board, unless\n"
+           "                  the affinity is already restricted].\n"
            "  -i|--interrupt: Perform only the interrupt latency test.\n"
 	   "  --iloops N:     Number of loops for interrupt latency test [default: 10000].\n"
-#endif
+           "  -w|--wakeup:    Perform only the timer wakeup latency test.\n"
+           "  --wloops N:     Number of wakeups per timer in the wakeup latency\n"
+           "                  test [default: 1000].\n"
+           "  --wperiod N:    Sleep period of the wakeup latency test in\n"
+           "                  microseconds, 1 to 1000000 [default: 1000].\n"
            "  -b|--bulk:      Perform only the bulk serial write/read test.\n"
+           "  --bloops N:     Number of loops for bulk serial write/read test\n"
+           "                  [default: 1200].\n"
            "  -t|--timed:     Perform only the serial write/read test at a\n"
            "                  fixed frequency (on Raspberry Pi with interrupt\n"
            "                  based signal set latency test).\n"
-	   "  --tloops N:     Number of loops for serial write/read test [default: 1200]\n",
+	   "  --tloops N:     Number of loops for serial write/read test [default: 1200]\n"
+           "  --rate N:       Frequency of the serial write/read test in Hz\n"
+           "                  [default: 20].\n"
+           "  -p|--payload:   Perform only the payload write/read test, which\n"
+           "                  verifies the echo of payloads of different sizes\n"
+           "                  and saves their latency and throughput to\n"
+           "                  payload_summary.txt.\n"
+           "  --psizes LIST:  Comma separated payload sizes in bytes\n"
+           "                  [default: " PAYLOAD_DEFAULT_SIZES "].\n"
+           "  --ploops N:     Number of loops per payload size [default: 50].\n"
+           "  --ppattern P:   Payload pattern: sequence, prbs or both in turn\n"
+           "                  [default: both].\n"
+           "  --concurrent:   Perform only the concurrent test: the interrupt\n"
+           "                  latency test and the serial write/read test at a\n"
+           "                  fixed frequency run at the same time on their own\n"
+           "                  cores, after a solo run of each on the same core.\n"
+           "                  The degradation is saved to concurrent_summary.txt.\n"
+           "                  Needs the GPIO interrupts of the board.\n"
+           "  --concurrent-cores A,B: Cores of the interrupt test and of the\n"
+           "                  serial test of --concurrent [default: the core\n"
+           "                  of --core and the next one].\n"
+           "  --no-baseline:  Skip the solo runs of --concurrent.\n"
+           "  --load SPEC:    Run background load in separate processes during\n"
+           "                  the tests. The load profile is stored in run.info\n"
+           "                  and in the capture file, the throughput of the\n"
+           "                  load in load_summary.txt. May be given repeatedly:\n"
+           "                    cpu:CORES       busy loop on each core\n"
+           "                    mem:CORES[:MB]  memory copy of MB on each core\n"
+           "                                    [default: 64]\n"
+           "                    io:DIR[:MB]     write, sync and read a file of MB\n"
+           "                                    in DIR [default: 64]\n"
+           "                    usb:DEV[:BYTES[:BAUD]] bulk write/read of blocks\n"
+           "                                    of BYTES on a second serial device,\n"
+           "                                    e.g. a loopback gadget, at BAUD\n"
+           "                                    [default: 4096, 115200]\n"
+           "                  CORES is a list like 1,3 or 1-3.\n"
+           "  --no-raw:       Do not store the raw samples (*.gpd files), only\n"
+           "                  the histograms. Use this for long soak runs.\n"
+           "  --hdr-digits N: Significant digits of the histograms, 1 to 5\n"
+           "                  [default: 3].\n"
+           "  --interval S:   Append the statistics of every interval of S seconds\n"
+           "                  to *_intervals.txt when the interval ends.\n"
+           "  --target-ci W:  Adaptive sample size: instead of the fixed number\n"
+           "                  of loops, each test samples until the confidence\n"
+           "                  intervals of the target percentiles of all its\n"
+           "                  series are narrower than W, given in percent of\n"
+           "                  the percentile (e.g. 2%%) or in milliseconds\n"
+           "                  (e.g. 0.05), or until the time budget is exhausted.\n"
+           "  --target-percentiles LIST: Comma separated percentiles for\n"
+           "                  --target-ci [default: 50,99].\n"
+           "  --target-confidence P: Confidence level in percent of the\n"
+           "                  intervals for --target-ci [default: 95].\n"
+           "  --time-budget S: Maximum duration of each test in seconds for\n"
+           "                  --target-ci [default: 600].\n"
+           "  --telemetry PATH: Publish the cumulative and rolling window\n"
+           "                  percentiles, sample rates, error counts and\n"
+           "                  isolation violations of the running measurement as\n"
+           "                  JSON on the Unix socket PATH, e.g. with\n"
+           "                  'socat - UNIX-CONNECT:PATH'.\n"
+           "  --prometheus PORT: Publish the same statistics in the Prometheus\n"
+           "                  text format on http://127.0.0.1:PORT/metrics.\n"
+           "  --telemetry-window S: Length of the rolling window of the\n"
+           "                  telemetry in seconds [default: 10].\n"
+           "  --ready-timeout MS: Maximum time to wait for the ready banner of\n"
+           "                  the Arduino after opening the serial port. Without\n"
+           "                  the banner, the echo of a probe byte is checked.\n"
+           "                  Must be positive [default: 5000].\n"
+           "  --no-reset:     Do not toggle DTR when opening and closing the\n"
+           "                  serial port, so the Arduino is not reset and is\n"
+           "                  ready immediately (after the first run).\n"
+           "  --capture FILE: Store the raw timestamps of all iterations in the\n"
+           "                  binary capture file FILE. Use latencyCapture to\n"
+           "                  inspect it or to export the *.gpd files.\n"
+           "  --ftrace-percentile P: Write iteration markers into the ftrace\n"
+           "                  trace_marker and save a trace snapshot whenever a\n"
+           "                  sample exceeds the P-th percentile of its series.\n"
+           "  --ftrace-limit MS: Save a trace snapshot whenever a sample exceeds\n"
+           "                  MS milliseconds. The snapshots are listed in\n"
+           "                  ftrace_snapshots.txt with their sample index.\n"
+           "\n",
            f_progName_p);
+    boardPrintTable();
     exit(1);
 }
 
 
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Parse the integer argument of an option. Prints an error and
+ *            the usage on an invalid number or one out of range.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_progName_p - Name of the program.
+ * \param[in] f_option_p   - Name of the option.
+ * \param[in] f_value_p    - The argument of the option.
+ * \param[in] f_min_i      - The smallest valid value.
+ * \param[in] f_max_i      - The largest valid value.
+ * \return    Returns the value.
+ *
+ *****************************************************************************/
+int64_t parseInteger(const char*   f_progName_p,
+                     const char*   f_option_p,
+                     const char*   f_value_p,
+                     const int64_t f_min_i,
+                     const int64_t f_max_i)
+{
+  char* end_p = NULL;
+  errno = 0;
+  const long long value_i = strtoll(f_value_p, &end_p, 10);
+  if ((errno != 0) || (end_p == f_value_p) || (*end_p != '\0') ||
+      (value_i < f_min_i) || (value_i > f_max_i)) {
+    printf("Error: Invalid value '%s' for %s option, expected %lld to %lld!\n", f_value_p, f_option_p,
+           (long long) f_min_i, (long long) f_max_i);
+    usage(f_progName_p);
+  }
+  return int64_t(value_i);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Parse the number of loops of a test option. Prints an error and
+ *            the usage on an invalid number.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_progName_p - Name of the program.
+ * \param[in] f_option_p   - Name of the option.
+ * \param[in] f_value_p    - The argument of the option.
+ * \return    Returns the number of loops.
+ *
+ *****************************************************************************/
+uint32_t parseLoops(const char* f_progName_p,
+                    const char* f_option_p,
+                    const char* f_value_p)
+{
+  return uint32_t(parseInteger(f_progName_p, f_option_p, f_value_p, 1, UINT32_MAX));
+}
+
+
 /* ********************************* METHOD **********************************/
 /**
  * \brief     Check if a file exists.
@@ -125,6 +346,28 @@ bool fileExists(const std::string& fr_fileName)
 }
 
 
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if the affinity of the process is restricted, e.g. by
+ *            taskset, so that it is kept instead of using the default core
+ *            of the board.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns \c true if the process may not run on all online cores.
+ *
+ *****************************************************************************/
+bool affinityRestricted()
+{
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+        return false;
+    return (CPU_COUNT(&cpuSet) < sysconf(_SC_NPROCESSORS_ONLN));
+}
+
+
 /* ********************************* METHOD **********************************/
 /**
  * \brief     Get the latency in milliseconds of an FTDI adapter with a given
@@ -157,30 +400,6 @@ int32_t getFtdiLatency(const std::string& fr_serialDevice)
 }
 
 
-int32_t getSysfsCounter(const std::string& fr_fileName) {
-  int32_t counter_i = -1;
-  FILE* file_p = fopen(fr_fileName.c_str(), "r");
-  if (file_p) {
-    if (fscanf(file_p, "%d", &counter_i) != 1) {
-      counter_i = -1;
-    }
-    fclose(file_p);
-  }
-  return counter_i;
-}
-
-uint64_t getSysfsTimestamp(const std::string& fr_fileName) {
-  uint64_t timestamp_ui = 0;
-  FILE* file_p = fopen(fr_fileName.c_str(), "r");
-  if (file_p) {
-    if (fscanf(file_p, "%llu", &timestamp_ui) != 1) {
-      timestamp_ui = 0;
-    }
-    fclose(file_p);
-  }
-  return timestamp_ui;
-}
-
 /* ********************************* METHOD **********************************/
 /**
  * \brief     Set the latency in milliseconds of a FTDI device.
@@ -211,231 +430,219 @@ bool setFtdiLatency(const std::string& fr_serialDevice,
 
 /* ********************************* METHOD **********************************/
 /**
- * \brief     Initialize the serial port.
+ * \brief     Write the metadata of the run to run.info, so latencyStore can
+ *            index the results.
  *
  * \author    Clemens Rabe
- * \date      Apr 06, 2019
+ * \date      Oct 18, 2026
  *
- * \param[in] f_serialPortHandle_i - The serial port handle.
- * \return    Returns \c true on success, otherwise \c false.
+ * \param[in] fr_serialDevice  - The serial device name, e.g., "ttyUSB0".
+ * \param[in] f_numBytes_ui    - Number of bytes sent at once.
+ * \param[in] f_rateHz_ui      - Frequency of the timed serial test.
+ * \param[in] fr_loadProfile   - The background load, or "none".
  *
  *****************************************************************************/
-bool initializeSerialPort(int f_serialPortHandle_i, const uint32_t f_numBytes_ui)
+void writeRunInfo(const std::string& fr_serialDevice,
+                  const uint32_t     f_numBytes_ui,
+                  const uint32_t     f_rateHz_ui,
+                  const std::string& fr_loadProfile)
 {
-    struct termios newtio;
-    memset( &newtio, 0, sizeof( newtio ) );
-
-    // No processing
-    cfmakeraw( &newtio );
-
-    cfsetspeed( &newtio, B115200 );
-
-    // Ignore control lines
-    newtio.c_cflag |= CLOCAL;
-    newtio.c_cflag &= ~CRTSCTS;
-
-    // set to 8N1
-    newtio.c_cflag &= ~( PARENB | PARODD );
-    newtio.c_cflag &= ~CSTOPB;
-    newtio.c_cflag &= ~CSIZE;
-    newtio.c_cflag |= CS8;
-
-    // Enable read
-    newtio.c_cflag |= CREAD;
-
-    // Input flags (ignore parity errors)
-    newtio.c_iflag = IGNPAR;
-
-    // Raw output
-    newtio.c_oflag = 0;
+    FILE* file_p = fopen("run.info", "w");
+    if (!file_p) {
+        printf("Warning: Can't write run.info!\n");
+        return;
+    }
 
-    // Disable canonical input
-    newtio.c_lflag = 0;
+    struct utsname name;
+    if (uname(&name) != 0)
+        memset(&name, 0, sizeof(name));
+
+    char date[32];
+    const time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", localtime(&now));
+
+    // The USB serial driver identifies the adapter chip, e.g., ftdi_sio or ch341-uart
+    char usbDriver[256];
+    const std::string driverLink = "/sys/class/tty/" + fr_serialDevice + "/device/driver";
+    const ssize_t     length_i   = readlink(driverLink.c_str(), usbDriver, sizeof(usbDriver) - 1);
+    usbDriver[(length_i > 0) ? length_i : 0] = '\0';
+    const char* usbDriver_p = strrchr(usbDriver, '/');
+
+    fprintf(file_p, "# Metadata of the run written by latencyTest\n");
+    fprintf(file_p, "board = %s\n", g_board.name.c_str());
+    fprintf(file_p, "driver = %s\n", g_gpioBackendNames_p[g_gpioBackend]);
+    fprintf(file_p, "device = %s\n", fr_serialDevice.c_str());
+    fprintf(file_p, "usbdriver = %s\n", usbDriver_p ? usbDriver_p + 1 : usbDriver);
+    fprintf(file_p, "latency = %d\n", getFtdiLatency(fr_serialDevice));
+    fprintf(file_p, "payload = %u\n", f_numBytes_ui);
+    fprintf(file_p, "rate = %u\n", f_rateHz_ui);
+    fprintf(file_p, "load = %s\n", fr_loadProfile.c_str());
+    fprintf(file_p, "hostname = %s\n", name.nodename);
+    fprintf(file_p, "kernel = %s\n", name.release);
+    fprintf(file_p, "machine = %s\n", name.machine);
+    fprintf(file_p, "date = %s\n", date);
+    fclose(file_p);
+}
 
-    // Read parameters (block read until 1 character arrives)
-    newtio.c_cc[VTIME]    = 0;     /* inter-character timer unused */
-    newtio.c_cc[VMIN]     = f_numBytes_ui;     /* blocking read until 1 character arrives */
 
-    if ( tcsetattr( f_serialPortHandle_i, TCSANOW, &newtio ) != 0 )
-    {
-        printf("Error: Can't setup serial port!\n");
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Configure the modem control lines of the serial port.
+ *
+ *            The Arduino resets on a rising edge of DTR. Linux raises DTR
+ *            and RTS on every open() and drops them on the last close() if
+ *            HUPCL is set. By default, HUPCL is set so that the next run
+ *            starts with a freshly reset Arduino. With \c f_noReset_b, HUPCL
+ *            is cleared and DTR/RTS are kept asserted, so the lines never
+ *            toggle and the Arduino keeps running between the runs. The
+ *            first run after a close with HUPCL set still resets it.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_serialPortHandle_i - The serial port handle.
+ * \param[in] f_noReset_b          - Avoid the auto-reset of the Arduino.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool configureModemLines(int f_serialPortHandle_i, const bool f_noReset_b)
+{
+    struct termios tio;
+    if (tcgetattr(f_serialPortHandle_i, &tio) != 0) {
+        printf("Error: Can't get the serial port settings!\n");
         return false;
     }
 
-    // Set serial port to blocking mode again. This is required, since
-    // a blocking open() may block until a carrier is present, depending
-    // on the serial port configuration. To be sure, we open with non-blocking
-    // and reset to blocking here.
-    int flags_i = fcntl( f_serialPortHandle_i, F_GETFL );
-    flags_i    &= ~O_NONBLOCK;
+    if (f_noReset_b)
+        tio.c_cflag &= ~HUPCL;
+    else
+        tio.c_cflag |= HUPCL;
 
-    if ( fcntl( f_serialPortHandle_i, F_SETFL, flags_i ) < 0 )
-    {
-        printf("Error: Can't disable non-blocking mode of the serial port!\n");
+    if (tcsetattr(f_serialPortHandle_i, TCSANOW, &tio) != 0) {
+        printf("Error: Can't setup serial port!\n");
         return false;
     }
 
-    // Remove any content waiting on the serial port
-    tcflush(f_serialPortHandle_i, TCIOFLUSH);
-
+    if (f_noReset_b) {
+        int lines_i = TIOCM_DTR | TIOCM_RTS;
+        if (ioctl(f_serialPortHandle_i, TIOCMBIS, &lines_i) != 0)
+            printf("Warning: Can't assert the DTR and RTS lines of the serial port!\n");
+    }
     return true;
 }
 
 
-bool writeChars(int f_serialPortHandle_i,
-                const uint32_t f_numChars_ui,
-                const uint8_t* f_chars_p)
-{
-    const ssize_t written_i = write(f_serialPortHandle_i, f_chars_p, f_numChars_ui);
-    return (written_i == f_numChars_ui);
-}
-
-bool readChars(int f_serialPortHandle_i,
-               const uint32_t f_numChars_ui,
-               uint8_t* f_chars_p)
-{
-    const ssize_t read_i = read(f_serialPortHandle_i, f_chars_p, f_numChars_ui);
-    return (read_i == f_numChars_ui);
-}
-
-bool writeChar(int f_serialPortHandle_i,
-               const uint8_t f_char_ui)
-{
-    const ssize_t written_i = write(f_serialPortHandle_i, &f_char_ui, 1);
-    return (written_i == 1);
-}
-
-
-bool readChar(int f_serialPortHandle_i,
-              uint8_t& fr_char_ui)
-{
-    const ssize_t read_i = read(f_serialPortHandle_i, &fr_char_ui, 1);
-    return (read_i == 1);
-}
-
-
-#define RECORD_TIME(timespecStruct) \
-  clock_gettime(CLOCK_MONOTONIC_RAW, (struct timespec*) &timespecStruct);
-
-#define GET_NANOSECONDS(timespecStruct) \
-  (uint64_t(timespecStruct.tv_nsec) + (uint64_t(timespecStruct.tv_sec) * uint64_t(1000000000)))
-
-uint64_t getTimeStampNs()
-{
-    struct timespec t;
-    RECORD_TIME(t);
-    return GET_NANOSECONDS(t);
-}
-
-
-float getMilliseconds(const uint64_t f_startNs_ui,
-                      const uint64_t f_endNs_ui)
-{
-  if (f_endNs_ui > f_startNs_ui) {
-    const uint64_t diffNs_ui = f_endNs_ui - f_startNs_ui;
-    return float(diffNs_ui) / 1000000.0f;
-  } else {
-    const uint64_t diffNs_ui = f_startNs_ui - f_endNs_ui;
-    return float(diffNs_ui) / -1000000.0f;
-  }
-}
-
-
-float getMilliseconds(struct timespec& fr_startNs_ui,
-                      struct timespec& fr_endNs_ui)
-{
-  const uint64_t startNs_ui = GET_NANOSECONDS(fr_startNs_ui);
-  const uint64_t endNs_ui   = GET_NANOSECONDS(fr_endNs_ui);
-
-  if (endNs_ui > startNs_ui) {
-    const uint64_t diffNs_ui = endNs_ui - startNs_ui;
-    return float(diffNs_ui) / 1000000.0f;
-  } else {
-    const uint64_t diffNs_ui = startNs_ui - endNs_ui;
-    return float(diffNs_ui) / -1000000.0f;
-  }
-}
-
-
-float getMilliseconds(struct timespec& fr_startNs_ui,
-                      const uint64_t f_endNs_ui)
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Wait until the given bytes are received on the serial port.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_serialPortHandle_i - The serial port handle in non-blocking mode.
+ * \param[in] fr_expected          - The expected bytes.
+ * \param[in] f_deadlineNs_ui      - The deadline (see getTimeStampNs()).
+ * \return    Returns \c true if the bytes were received before the deadline.
+ *
+ *****************************************************************************/
+static bool waitForBytes(int                f_serialPortHandle_i,
+                         const std::string& fr_expected,
+                         const uint64_t     f_deadlineNs_ui)
 {
-  const uint64_t startNs_ui = GET_NANOSECONDS(fr_startNs_ui);
-
-  if (f_endNs_ui > startNs_ui) {
-    const uint64_t diffNs_ui = f_endNs_ui - startNs_ui;
-    return float(diffNs_ui) / 1000000.0f;
-  } else {
-    const uint64_t diffNs_ui = startNs_ui - f_endNs_ui;
-    return float(diffNs_ui) / -1000000.0f;
-  }
+    size_t matched_ui = 0;
+    uint64_t nowNs_ui = getTimeStampNs();
+    while (nowNs_ui < f_deadlineNs_ui) {
+        struct pollfd pfd;
+        pfd.fd      = f_serialPortHandle_i;
+        pfd.events  = POLLIN;
+        pfd.revents = 0;
+        const int timeoutMs_i = int((f_deadlineNs_ui - nowNs_ui + 999999) / 1000000);
+
+        if (poll(&pfd, 1, timeoutMs_i) > 0) {
+            uint8_t buffer[64];
+            const ssize_t read_i = read(f_serialPortHandle_i, buffer, sizeof(buffer));
+            for (ssize_t j = 0; j < read_i; ++j) {
+                // Restart the match on a mismatch (the expected bytes do not
+                // repeat their first character)
+                if (buffer[j] == uint8_t(fr_expected[matched_ui]))
+                    ++matched_ui;
+                else
+                    matched_ui = (buffer[j] == uint8_t(fr_expected[0])) ? 1 : 0;
+
+                if (matched_ui == fr_expected.size())
+                    return true;
+            }
+        }
+        nowNs_ui = getTimeStampNs();
+    }
+    return false;
 }
 
 
-bool timeWriteRead(int           f_serialPortHandle_i,
-                   const uint8_t f_dataByte_ui,
-                   uint64_t&     fr_timeBeforeWrite_ui,
-                   uint64_t&     fr_timeAfterWrite_ui,
-                   uint64_t&     fr_timeAfterRead_ui)
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Wait until the Arduino is ready to echo the bytes.
+ *
+ *            The firmware sends the banner ARDUINO_READY_BANNER at the end of
+ *            setup(). If the Arduino was not reset by opening the port, or if
+ *            it runs an older firmware without the banner, a probe byte is
+ *            sent instead and the echo is awaited. With \c f_probeFirst_b
+ *            (no reset expected), the probe is sent first and the banner is
+ *            only awaited if the probe is not answered.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_serialPortHandle_i - The serial port handle.
+ * \param[in] f_timeoutMs_ui       - Maximum time to wait for the banner.
+ * \param[in] f_probeFirst_b       - Probe before waiting for the banner.
+ * \return    Returns \c true if the Arduino is ready, otherwise \c false.
+ *
+ *****************************************************************************/
+bool waitForArduino(int            f_serialPortHandle_i,
+                    const uint32_t f_timeoutMs_ui,
+                    const bool     f_probeFirst_b)
 {
-  struct timespec timeBeforeWrite, timeAfterWrite, timeAfterRead;
-  uint8_t readChar_ui;
-
-  RECORD_TIME(timeBeforeWrite);
-  if (!writeChar(f_serialPortHandle_i, f_dataByte_ui)) {
-    return false;
-  }
-  RECORD_TIME(timeAfterWrite);
-
-  if (!readChar(f_serialPortHandle_i, readChar_ui)) {
-    return false;
-  }
-  RECORD_TIME(timeAfterRead);
+    const uint64_t startNs_ui = getTimeStampNs();
+    const std::string banner  = ARDUINO_READY_BANNER;
+    const std::string probe(1, char(ARDUINO_PROBE_BYTE));
 
-  fr_timeBeforeWrite_ui = GET_NANOSECONDS(timeBeforeWrite);
-  fr_timeAfterWrite_ui = GET_NANOSECONDS(timeAfterWrite);
-  fr_timeAfterRead_ui = GET_NANOSECONDS(timeAfterRead);
-
-  return (f_dataByte_ui == readChar_ui);
-}
+    SerialPortMode savedMode;
+    if (!enableSerialPolling(f_serialPortHandle_i, savedMode))
+        return false;
 
+    bool ready_b  = false;
+    bool probed_b = false;
+    if (f_probeFirst_b) {
+        probed_b = true;
+        ready_b  = ((write(f_serialPortHandle_i, probe.data(), 1) == 1) &&
+                    waitForBytes(f_serialPortHandle_i, probe,
+                                 getTimeStampNs() + ARDUINO_PROBE_TIMEOUT_MS * 1000000ull));
+    }
+    if (!ready_b) {
+        ready_b = waitForBytes(f_serialPortHandle_i, banner,
+                               startNs_ui + f_timeoutMs_ui * 1000000ull);
+    }
+    if (!ready_b && !probed_b) {
+        ready_b = ((write(f_serialPortHandle_i, probe.data(), 1) == 1) &&
+                   waitForBytes(f_serialPortHandle_i, probe,
+                                getTimeStampNs() + ARDUINO_PROBE_TIMEOUT_MS * 1000000ull));
+    }
 
-/// A time series (milliseconds)
-typedef std::vector<float> TimeSeries_t;
+    // Drop the remaining banner or probe bytes
+    usleep(ARDUINO_SETTLE_TIME_MS * 1000);
+    tcflush(f_serialPortHandle_i, TCIFLUSH);
 
-/// Information we extract from a time series for printing
-struct TimeAnalysis {
-  float mean_f;
-  float min_f;
-  float max_f;
-  float median_f;
-};
+    if (!restoreSerialMode(f_serialPortHandle_i, savedMode))
+        return false;
 
-void calculateStatistics(TimeSeries_t& fr_timeSeries,
-                         TimeAnalysis& fr_analysis) {
-  std::sort(fr_timeSeries.begin(), fr_timeSeries.end());
-  fr_analysis.min_f = fr_timeSeries.front();
-  fr_analysis.max_f = fr_timeSeries.back();
-  fr_analysis.median_f = fr_timeSeries[fr_timeSeries.size()/2];
-
-  float sum_f = 0.0f;
-  for (TimeSeries_t::const_iterator i = fr_timeSeries.begin(); i != fr_timeSeries.end(); ++i)
-    sum_f += *i;
-  fr_analysis.mean_f = sum_f / float(fr_timeSeries.size());
+    if (ready_b)
+        printf("Arduino ready after %.0f ms.\n", getMilliseconds(startNs_ui, getTimeStampNs()));
+    else
+        printf("Error: No response from the Arduino within %u ms!\n", f_timeoutMs_ui);
+    return ready_b;
 }
 
-void saveTimeSeries(const TimeSeries_t& fr_timeSeries,
-                    const std::string& fr_fileName) {
-  FILE* file_p = fopen(fr_fileName.c_str(), "w");
-
-  if (file_p) {
-    fprintf(file_p, "# Time series data. Unit is milliseconds.\n");
-    for (TimeSeries_t::const_iterator i = fr_timeSeries.begin(); i != fr_timeSeries.end(); ++i) {
-      fprintf(file_p, "%.6f\n", *i);
-    }
-    fclose(file_p);
-  }
-}
 
 void printProgress(uint64_t&      fr_lastNs_ui,
                    const char*    f_prefix_p,
@@ -443,15 +650,19 @@ void printProgress(uint64_t&      fr_lastNs_ui,
                    const uint32_t f_maxCounter_ui) {
   const uint64_t currentNs_ui = getTimeStampNs();
 
+  latencySeriesUpdateIntervals(currentNs_ui);
+
   if (getMilliseconds(fr_lastNs_ui, currentNs_ui) >= 1000.0f) {
-    printf("%s: %d of %d iterations performed...\n", f_prefix_p, f_currentCounter_ui + 1, f_maxCounter_ui);
+    if (sampleTargetEnabled() || (f_currentCounter_ui >= f_maxCounter_ui))
+      printf("%s: %d iterations performed...\n", f_prefix_p, f_currentCounter_ui + 1);
+    else
+      printf("%s: %d of %d iterations performed...\n", f_prefix_p, f_currentCounter_ui + 1, f_maxCounter_ui);
     fr_lastNs_ui = currentNs_ui;
   }
 }
 
-#if defined(ON_RASPBERRY_PI) or defined(ON_ODROID_XU4)
-
-volatile uint64_t g_timeInterrupt_ui;
+volatile uint64_t g_timeIntTestInterrupt_ui;
+volatile uint64_t g_timeArduinoInterrupt_ui;
 
 int32_t g_last_inttest_counter_i = -1;
 int32_t g_last_arduino_counter_i = -1;
@@ -461,7 +672,7 @@ void waitForSysfsIntTestTimestamp() {
     usleep(1000);
   }
   g_last_inttest_counter_i = getSysfsCounter("/sys/gpiotiming/inttest_counter");
-  g_timeInterrupt_ui = getSysfsTimestamp("/sys/gpiotiming/inttest_timestamp_ns");
+  g_timeIntTestInterrupt_ui = getSysfsTimestamp("/sys/gpiotiming/inttest_timestamp_ns");
 }
 
 void waitForSysfsArduinoTimestamp() {
@@ -469,125 +680,1109 @@ void waitForSysfsArduinoTimestamp() {
     usleep(1000);
   }
   g_last_arduino_counter_i = getSysfsCounter("/sys/gpiotiming/arduino_counter");
-  g_timeInterrupt_ui = getSysfsTimestamp("/sys/gpiotiming/arduino_timestamp_ns");
+  g_timeArduinoInterrupt_ui = getSysfsTimestamp("/sys/gpiotiming/arduino_timestamp_ns");
 }
 
 
-void interruptHandler() {
+// Each pin has its own handler and timestamp, so the interrupt test and the
+// serial test may run concurrently.
+void intTestInterruptHandler() {
   struct timespec timeInterrupt;
   RECORD_TIME(timeInterrupt);
-  g_timeInterrupt_ui = GET_NANOSECONDS(timeInterrupt);
+  g_timeIntTestInterrupt_ui = GET_NANOSECONDS(timeInterrupt);
 }
 
-bool initializeWiringPi() {
-  // Initialize wiringPi library
-  if (wiringPiSetup() < 0) {
-    printf("Error: Can't setup wiringPi library!\n");
-    return false;
-  }
+void arduinoInterruptHandler() {
+  struct timespec timeInterrupt;
+  RECORD_TIME(timeInterrupt);
+  g_timeArduinoInterrupt_ui = GET_NANOSECONDS(timeInterrupt);
+}
 
-  // Set pin modes
-#ifndef USE_KERNEL_DRIVER
-  pinMode(GPIO_ARDUINO,     INPUT);
-  pinMode(GPIO_INTTEST_IN,  INPUT);
-#endif
-  pinMode(GPIO_INTTEST_OUT, OUTPUT);
 
-#ifndef USE_KERNEL_DRIVER
-  // Add interrupt routines
-  if (wiringPiISR(GPIO_ARDUINO, INT_EDGE_FALLING, &interruptHandler) < 0) {
-    printf("Error: Can't add wiringPi interrupt on GPIO_ARDUINO!\n");
-    return false;
-  }
-  if (wiringPiISR(GPIO_INTTEST_IN, INT_EDGE_FALLING, &interruptHandler) < 0) {
-    printf("Error: Can't add wiringPi interrupt on GPIO_INTTEST_IN!\n");
-    return false;
-  }
-  printf("Info: Registered interrupt handler.\n");
-#endif
-  return true;
-}
+// The GPIO backends are the template arguments of the test loops. Their
+// methods are static and inline, so the backend is chosen once by the
+// dispatch in main() and the loops contain neither branches on the board or
+// driver nor indirect calls. The pins are read from g_board.
 
-void determineInterruptLatency(const uint32_t f_numLoops_ui) {
-  printf("Info: Testing interrupt latency...\n");
-  // We are triggering on falling edge, so we set the output to HIGH first
-  digitalWrite(GPIO_INTTEST_OUT, HIGH);
-  usleep(2000);
+/// GPIO backend of hosts without GPIO connections.
+class NoGpioBackend {
+ public:
+  static const bool c_hasInterrupts_b = false;
 
-#ifdef USE_KERNEL_DRIVER
-  g_last_inttest_counter_i = getSysfsCounter("/sys/gpiotiming/inttest_counter");
-#endif
-  
-  TimeSeries_t timeToInterrupt1;
-  TimeSeries_t timeToInterrupt2;
-  timeToInterrupt1.reserve(f_numLoops_ui);
-  timeToInterrupt2.reserve(f_numLoops_ui);
-  uint64_t     lastNs_ui = getTimeStampNs();
+  static bool     initialize()                           { return true; }
+  static void     setIntTestOutput(const bool /*high*/)  {}
+  static void     prepareIntTest()                       {}
+  static uint64_t waitForIntTestInterrupt()              { return 0; }
+  static void     prepareArduino()                       {}
+  static uint64_t waitForArduinoInterrupt()              { return 0; }
+};
 
-  for (uint32_t i = 0; i < f_numLoops_ui; ++i) {
-    struct timespec timeBeforeDigitalWrite, timeAfterDigitalWrite;
-    g_timeInterrupt_ui = 0;
+#ifdef HAVE_WIRINGPI
 
-    RECORD_TIME(timeBeforeDigitalWrite);
-    digitalWrite(GPIO_INTTEST_OUT, LOW);
-    RECORD_TIME(timeAfterDigitalWrite);
+/// GPIO backend using the interrupt handlers of wiringPi.
+class UserSpaceGpioBackend {
+ public:
+  static const bool c_hasInterrupts_b = true;
 
-#ifdef USE_KERNEL_DRIVER
-    waitForSysfsIntTestTimestamp();
-#else
+  static bool initialize() {
+    if (wiringPiSetup() < 0) {
+      printf("Error: Can't setup wiringPi library!\n");
+      return false;
+    }
+    pinMode(g_board.arduinoPin_i,    INPUT);
+    pinMode(g_board.intTestInPin_i,  INPUT);
+    pinMode(g_board.intTestOutPin_i, OUTPUT);
+
+    if (wiringPiISR(g_board.arduinoPin_i, INT_EDGE_FALLING, &arduinoInterruptHandler) < 0) {
+      printf("Error: Can't add wiringPi interrupt on pin %d (Arduino)!\n", g_board.arduinoPin_i);
+      return false;
+    }
+    if (wiringPiISR(g_board.intTestInPin_i, INT_EDGE_FALLING, &intTestInterruptHandler) < 0) {
+      printf("Error: Can't add wiringPi interrupt on pin %d (interrupt test)!\n", g_board.intTestInPin_i);
+      return false;
+    }
+    printf("Info: Registered interrupt handler.\n");
+    return true;
+  }
+
+  static void setIntTestOutput(const bool f_high_b) {
+    digitalWrite(g_board.intTestOutPin_i, f_high_b ? HIGH : LOW);
+  }
+
+  static void prepareIntTest() {}
+
+  static uint64_t waitForIntTestInterrupt() {
     // Wait for interrupt to be called
-    while (g_timeInterrupt_ui == 0)
+    while (g_timeIntTestInterrupt_ui == 0)
       usleep(1000);
-#endif
+    return g_timeIntTestInterrupt_ui;
+  }
 
-    timeToInterrupt1.push_back(getMilliseconds(timeBeforeDigitalWrite, g_timeInterrupt_ui));
-    timeToInterrupt2.push_back(getMilliseconds(timeAfterDigitalWrite,  g_timeInterrupt_ui));
+  static void prepareArduino() {}
 
-    // Set again to HIGH
-    digitalWrite(GPIO_INTTEST_OUT, HIGH);
-    usleep(2000);
+  static uint64_t waitForArduinoInterrupt() {
+    // The Arduino sets the pin before it answers, so the handler was called
+    return g_timeArduinoInterrupt_ui;
+  }
+};
 
-    printProgress(lastNs_ui, "Interrupt latency measurement", i, f_numLoops_ui);
+/// GPIO backend using the interrupt handlers of the gpiotiming kernel module.
+class KernelGpioBackend {
+ public:
+  static const bool c_hasInterrupts_b = true;
+
+  static bool initialize() {
+    if (!fileExists("/sys/gpiotiming/inttest_counter")) {
+      printf("Error: The gpiotiming kernel module is not loaded!\n");
+      return false;
+    }
+    if (wiringPiSetup() < 0) {
+      printf("Error: Can't setup wiringPi library!\n");
+      return false;
+    }
+    pinMode(g_board.intTestOutPin_i, OUTPUT);
+    return true;
   }
-  
-  TimeAnalysis analysis1, analysis2;
-  calculateStatistics(timeToInterrupt1, analysis1);
-  calculateStatistics(timeToInterrupt2, analysis2);
 
-  printf("Time between start of digital write and interrupt: %.3f ms (mean = %.3f, min = %.3f, max=%.3f)\n",
-         analysis1.median_f, analysis1.mean_f, analysis1.min_f, analysis1.max_f);
-  printf("Time between end of digital write and interrupt:   %.3f ms (mean = %.3f, min = %.3f, max=%.3f)\n",
-         analysis2.median_f, analysis2.mean_f, analysis2.min_f, analysis2.max_f);
+  static void setIntTestOutput(const bool f_high_b) {
+    digitalWrite(g_board.intTestOutPin_i, f_high_b ? HIGH : LOW);
+  }
 
-  saveTimeSeries(timeToInterrupt1, "digitalWriteStart_to_interrupt.gpd");
-  saveTimeSeries(timeToInterrupt2, "digitalWriteEnd_to_interrupt.gpd");
-}
+  static void prepareIntTest() {
+    g_last_inttest_counter_i = getSysfsCounter("/sys/gpiotiming/inttest_counter");
+  }
 
-#endif
+  static uint64_t waitForIntTestInterrupt() {
+    waitForSysfsIntTestTimestamp();
+    return g_timeIntTestInterrupt_ui;
+  }
+
+  static void prepareArduino() {
+    g_last_arduino_counter_i = getSysfsCounter("/sys/gpiotiming/arduino_counter");
+  }
+
+  static uint64_t waitForArduinoInterrupt() {
+    waitForSysfsArduinoTimestamp();
+    return g_timeArduinoInterrupt_ui;
+  }
+};
+
+#endif /* HAVE_WIRINGPI */
 
 
 /* ********************************* METHOD **********************************/
 /**
- * \brief     Main entry point.
+ * \brief     Initialize the GPIOs of the selected backend.
  *
  * \author    Clemens Rabe
- * \date      Apr 06, 2019
+ * \date      Oct 18, 2026
  *
- * \param[in] f_argc_i - Number of arguments.
- * \param[in] f_argv_p - Arguments.
- * \return    Return code of the application.
+ * \return    Returns \c true on success, otherwise \c false.
  *
  *****************************************************************************/
-int main(int f_argc_i, char** f_argv_p) {
+bool initializeGpio() {
+  switch (g_gpioBackend) {
+#ifdef HAVE_WIRINGPI
+  case GPIO_BACKEND_USERSPACE:
+    return UserSpaceGpioBackend::initialize();
+
+  case GPIO_BACKEND_KMOD:
+    return KernelGpioBackend::initialize();
+#endif
+
+  default:
+    return NoGpioBackend::initialize();
+  }
+}
+
+
+/// A group of tests running concurrently on their own threads.
+///
+/// The tests of a run start at a common time, which is also the start of
+/// their interval statistics, and a test that completed its loops continues
+/// as load, without recording, until all tests of the run completed theirs.
+/// The statistics of the series are kept by the group after the series are
+/// gone. A run of a single test gives the solo baseline.
+class TestGroup {
+ public:
+  explicit TestGroup(const char* f_prefix_p)
+    : m_prefix(f_prefix_p), m_numTests_ui(0), m_numStarted_ui(0), m_numRunning_ui(0),
+      m_startNs_ui(0), m_aborted_b(false) {}
+
+  /// Prepare a run of the given number of tests.
+  void begin(const uint32_t f_numTests_ui) {
+    m_numTests_ui = f_numTests_ui;
+    m_numStarted_ui.store(0);
+    m_numRunning_ui.store(f_numTests_ui);
+    m_startNs_ui.store(0);
+    m_aborted_b.store(false);
+  }
+
+  /// Prefix of the names of the series, ftrace markers and triggers
+  const std::string& prefix() const { return m_prefix; }
+
+  /// \c true if the tests of the run load each other
+  bool concurrent() const { return m_numTests_ui > 1; }
+
+  /// Wait until all tests of the run are ready. Returns the common start time.
+  uint64_t start() {
+    if (m_numStarted_ui.fetch_add(1) + 1 == m_numTests_ui)
+      m_startNs_ui.store(getTimeStampNs());
+    uint64_t startNs_ui;
+    while (((startNs_ui = m_startNs_ui.load()) == 0) && !m_aborted_b.load())
+      sched_yield();
+    latencySeriesStartThreadIntervals(startNs_ui);
+    return startNs_ui;
+  }
+
+  /// Check if a test continues after it completed its loops, i.e., as long
+  /// as other tests of the run did not complete theirs.
+  bool keepRunning(bool& fr_completed_b, const bool f_loopsDone_b) {
+    if (f_loopsDone_b && !fr_completed_b) {
+      fr_completed_b = true;
+      m_numRunning_ui.fetch_sub(1);
+    }
+    return !m_aborted_b.load() && (!fr_completed_b || (m_numRunning_ui.load() > 0));
+  }
+
+  /// Stop all tests of the run, e.g. after an error of one of them.
+  void abort() { m_aborted_b.store(true); }
+
+  /// Serializes the reports of the tests.
+  std::mutex& reportMutex() { return m_mutex; }
+
+  /// Keep the statistics of a series under its name without the prefix.
+  /// Called with the report mutex held.
+  void addResult(const LatencySeries& fr_series) {
+    m_results[fr_series.name().substr(m_prefix.size())] = fr_series.histogram();
+  }
+
+  const std::map<std::string, HdrHistogram>& results() const { return m_results; }
+
+ private:
+  std::string                         m_prefix;
+  uint32_t                            m_numTests_ui;
+  std::atomic<uint32_t>               m_numStarted_ui;
+  std::atomic<uint32_t>               m_numRunning_ui;
+  std::atomic<uint64_t>               m_startNs_ui;
+  std::atomic<bool>                   m_aborted_b;
+  std::mutex                          m_mutex;
+  std::map<std::string, HdrHistogram> m_results;
+};
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if the loop of a test continues.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]     f_group_p      - The group of the test, or \c NULL if the
+ *                                 test runs alone.
+ * \param[in,out] fr_completed_b - Set if the test completed its loops.
+ * \param[in]     f_loopsDone_b  - \c true if the loops are done.
+ * \return    Returns \c true if the test continues, otherwise \c false.
+ *
+ *****************************************************************************/
+static inline bool keepRunning(TestGroup* f_group_p,
+                               bool&      fr_completed_b,
+                               const bool f_loopsDone_b) {
+  if (f_group_p)
+    return f_group_p->keepRunning(fr_completed_b, f_loopsDone_b);
+  fr_completed_b = fr_completed_b || f_loopsDone_b;
+  return !fr_completed_b;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the number of loops of the interrupt self-test.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_numLoops_ui - Number of loops without adaptive sample size.
+ * \return    Returns the number of loops, see sampleTargetNumLoops().
+ *
+ *****************************************************************************/
+static inline uint32_t interruptTestNumLoops(const uint32_t f_numLoops_ui) {
+  return sampleTargetNumLoops(f_numLoops_ui, INTERRUPT_TEST_PERIOD_US * 1000ULL);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the number of loops of the serial write/read test.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_numLoops_ui - Number of loops without adaptive sample size.
+ * \param[in] f_rateHz_ui   - Rate of the loops in Hz.
+ * \return    Returns the number of loops, see sampleTargetNumLoops().
+ *
+ *****************************************************************************/
+static inline uint32_t serialTestNumLoops(const uint32_t f_numLoops_ui,
+                                          const uint32_t f_rateHz_ui) {
+  return sampleTargetNumLoops(f_numLoops_ui, 1000000000ULL / f_rateHz_ui);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Determine the latencies of the interrupt self-test: the time
+ *            from setting the output pin until the interrupt of the input pin.
+ *
+ *            Running in a group, the iterations after the loops completed
+ *            only load the other tests and are not recorded.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_numLoops_ui - Number of loops.
+ * \param[in] f_group_p     - The group if the test runs on its own thread,
+ *                            otherwise \c NULL.
+ * \param[in] f_capture_p   - The capture records of the thread, reserved
+ *                            before the group started, otherwise \c NULL.
+ *
+ *****************************************************************************/
+template <class GpioBackend>
+void determineInterruptLatency(const uint32_t f_numLoops_ui,
+                               TestGroup*     f_group_p   = NULL,
+                               CaptureBlock*  f_capture_p = NULL) {
+  const std::string prefix         = f_group_p ? f_group_p->prefix() : "";
+  const std::string markerName     = prefix + "interrupt";
+  const uint32_t    captureType_ui = (f_group_p && f_group_p->concurrent()) ?
+                                     CAPTURE_CONCURRENT_INTERRUPT : CAPTURE_INTERRUPT;
+  if (f_group_p)
+    f_group_p->start();
+
+  printf("Info: Testing interrupt latency...\n");
+  // We are triggering on falling edge, so we set the output to HIGH first
+  GpioBackend::setIntTestOutput(true);
+  usleep(2000);
+
+  GpioBackend::prepareIntTest();
+  
+  const uint32_t numLoops_ui = interruptTestNumLoops(f_numLoops_ui);
+  CaptureBlock   ownCapture;
+  if (!f_capture_p)
+    g_capture.reserveBlock(numLoops_ui, ownCapture);
+  CaptureBlock&  capture = f_capture_p ? *f_capture_p : ownCapture;
+  LatencySeries timeToInterrupt1((prefix + "digitalWriteStart_to_interrupt").c_str(),
+                                 "Time between start of digital write and interrupt:", numLoops_ui);
+  LatencySeries timeToInterrupt2((prefix + "digitalWriteEnd_to_interrupt").c_str(),
+                                 "Time between end of digital write and interrupt:  ", numLoops_ui);
+  uint64_t     lastNs_ui = getTimeStampNs();
+  FtraceTrigger trigger;
+  ftraceInitTrigger(trigger, (prefix + "digitalWriteStart_to_interrupt").c_str());
+  SampleTarget target("Interrupt latency test");
+  target.add(timeToInterrupt1);
+  target.add(timeToInterrupt2);
+
+  // The options do not change during the loop, so check them once
+  const bool ftrace_b   = ftraceEnabled();
+  const bool adaptive_b = sampleTargetEnabled();
+
+  bool completed_b = false;
+  for (uint32_t i = 0; keepRunning(f_group_p, completed_b, (i >= numLoops_ui) || (adaptive_b && target.done())); ++i) {
+    struct timespec timeBeforeDigitalWrite, timeAfterDigitalWrite;
+    g_timeIntTestInterrupt_ui = 0;
+    if (ftrace_b)
+      ftraceMarker(markerName.c_str(), i);
+
+    RECORD_TIME(timeBeforeDigitalWrite);
+    GpioBackend::setIntTestOutput(false);
+    RECORD_TIME(timeAfterDigitalWrite);
+
+    const uint64_t timeInterrupt_ui = GpioBackend::waitForIntTestInterrupt();
+
+    if (!completed_b) {
+      capture.append(captureType_ui, i, GET_NANOSECONDS(timeBeforeDigitalWrite),
+                     GET_NANOSECONDS(timeAfterDigitalWrite), 0, timeInterrupt_ui);
+
+      const int64_t timeToInterrupt1Ns_i = getNanoseconds(GET_NANOSECONDS(timeBeforeDigitalWrite), timeInterrupt_ui);
+      timeToInterrupt1.record(timeToInterrupt1Ns_i);
+      timeToInterrupt2.record(getNanoseconds(GET_NANOSECONDS(timeAfterDigitalWrite), timeInterrupt_ui));
+      if (ftrace_b)
+        ftraceCheckSample(trigger, timeToInterrupt1.histogram(), timeToInterrupt1Ns_i);
+    }
+
+    // Set again to HIGH
+    GpioBackend::setIntTestOutput(true);
+    usleep(INTERRUPT_TEST_PERIOD_US);
+
+    printProgress(lastNs_ui, "Interrupt latency measurement", i, numLoops_ui);
+  }
+  
+  // Do not interleave the reports of concurrent tests
+  std::unique_lock<std::mutex> reportLock;
+  if (f_group_p)
+    reportLock = std::unique_lock<std::mutex>(f_group_p->reportMutex());
+
+  target.report();
+  timeToInterrupt1.report();
+  timeToInterrupt2.report();
+
+  timeToInterrupt1.save();
+  timeToInterrupt2.save();
+
+  if (f_group_p) {
+    f_group_p->addResult(timeToInterrupt1);
+    f_group_p->addResult(timeToInterrupt2);
+  }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Determine the latencies of writing a byte to the Arduino and
+ *            reading its answer at a fixed rate.
+ *
+ *            If the GPIO backend has interrupts, the time until the signal
+ *            of the Arduino arrives is measured in addition. Running in a
+ *            group, the iterations after the loops completed only load the
+ *            other tests and are not recorded.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_serialPortHandle_i - The serial port handle.
+ * \param[in] f_numLoops_ui        - Number of loops.
+ * \param[in] f_rateHz_ui          - Rate of the loops in Hz.
+ * \param[in] f_group_p            - The group if the test runs on its own
+ *                                   thread, otherwise \c NULL.
+ * \param[in] f_capture_p          - The capture records of the thread,
+ *                                   reserved before the group started,
+ *                                   otherwise \c NULL.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+template <class GpioBackend>
+bool determineSerialLatency(const int      f_serialPortHandle_i,
+                            const uint32_t f_numLoops_ui,
+                            const uint32_t f_rateHz_ui,
+                            TestGroup*     f_group_p   = NULL,
+                            CaptureBlock*  f_capture_p = NULL) {
+  const std::string prefix         = f_group_p ? f_group_p->prefix() : "";
+  const std::string markerName     = prefix + "timed";
+  const uint32_t    captureType_ui = (f_group_p && f_group_p->concurrent()) ?
+                                     CAPTURE_CONCURRENT_SERIAL : CAPTURE_SERIAL;
+  if (f_group_p)
+    f_group_p->start();
+
+  printf("Write/read at %d Hz...\n", f_rateHz_ui);
+  const uint32_t numLoops_ui = serialTestNumLoops(f_numLoops_ui, f_rateHz_ui);
+  CaptureBlock   ownCapture;
+  if (!f_capture_p)
+    g_capture.reserveBlock(numLoops_ui, ownCapture);
+  CaptureBlock&  capture = f_capture_p ? *f_capture_p : ownCapture;
+  LatencySeries* timeToInterrupt_p = NULL;
+  if (GpioBackend::c_hasInterrupts_b)
+    timeToInterrupt_p = new LatencySeries((prefix + "startWrite_to_interrupt").c_str(),
+                                          "Time between start of write and interrupt:   ", numLoops_ui / 2);
+  LatencySeries timeOfWrite((prefix + "startWrite_to_endWrite").c_str(),
+                            "Time between start of write and end of write:", numLoops_ui);
+  LatencySeries timeToRead((prefix + "endWrite_to_endRead").c_str(),
+                           "Time between end of write and end of read:   ", numLoops_ui);
+  LatencySeries timeTotal((prefix + "startWrite_to_endRead").c_str(),
+                          "Time between start of write and end of read: ", numLoops_ui);
+  uint64_t     lastNs_ui = getTimeStampNs();
+
+  FtraceTrigger timeToInterruptTrigger, timeTotalTrigger;
+  ftraceInitTrigger(timeToInterruptTrigger, (prefix + "startWrite_to_interrupt").c_str());
+  ftraceInitTrigger(timeTotalTrigger, (prefix + "startWrite_to_endRead").c_str());
+
+  SampleTarget target("Serial write/read test");
+  if (GpioBackend::c_hasInterrupts_b)
+    target.add(*timeToInterrupt_p);
+  target.add(timeOfWrite);
+  target.add(timeToRead);
+  target.add(timeTotal);
+
+  GpioBackend::prepareArduino();
+
+  // The options do not change during the loop, so check them once
+  const bool ftrace_b   = ftraceEnabled();
+  const bool adaptive_b = sampleTargetEnabled();
+
+  bool completed_b = false;
+  for (uint32_t i = 0; keepRunning(f_group_p, completed_b, (i >= numLoops_ui) || (adaptive_b && target.done())); ++i) {
+    const uint8_t writtenChar_ui = i % 256;
+    uint64_t timeBeforeWrite_ui, timeAfterWrite_ui, timeAfterRead_ui;
+    uint64_t timeInterrupt_ui = 0;
+
+    usleep(1000000 / f_rateHz_ui);
+    if (ftrace_b)
+      ftraceMarker(markerName.c_str(), i);
+    if (!timeWriteRead(f_serialPortHandle_i, writtenChar_ui,
+                       timeBeforeWrite_ui, timeAfterWrite_ui, timeAfterRead_ui))
+      {
+        g_telemetry.countError();
+        printf("Error: Write/Read of character failed (loop %d)\n", i);
+        if (f_group_p)
+          f_group_p->abort();
+        delete timeToInterrupt_p;
+        return false;
+      }
+
+    // Interrupt is only triggered on falling edge, that means if we have written
+    // a value with the lowest bit set to 0.
+    if (GpioBackend::c_hasInterrupts_b && (i > 0) && ((writtenChar_ui % 2) == 0)) {
+      timeInterrupt_ui = GpioBackend::waitForArduinoInterrupt();
+      if (!completed_b) {
+        const int64_t timeToInterruptNs_i = getNanoseconds(timeBeforeWrite_ui, timeInterrupt_ui);
+        timeToInterrupt_p->record(timeToInterruptNs_i);
+        if (ftrace_b)
+          ftraceCheckSample(timeToInterruptTrigger, timeToInterrupt_p->histogram(), timeToInterruptNs_i);
+      }
+    }
+
+    if (!completed_b) {
+      capture.append(captureType_ui, i, timeBeforeWrite_ui, timeAfterWrite_ui, timeAfterRead_ui,
+                     timeInterrupt_ui);
+
+      timeOfWrite.record(getNanoseconds(timeBeforeWrite_ui, timeAfterWrite_ui));
+      timeToRead.record(getNanoseconds(timeAfterWrite_ui, timeAfterRead_ui));
+
+      const int64_t timeTotalNs_i = getNanoseconds(timeBeforeWrite_ui, timeAfterRead_ui);
+      timeTotal.record(timeTotalNs_i);
+      if (ftrace_b)
+        ftraceCheckSample(timeTotalTrigger, timeTotal.histogram(), timeTotalNs_i);
+    }
+
+    printProgress(lastNs_ui, "Serial write/read latency measurement", i, numLoops_ui);
+  }
+
+  // Do not interleave the reports of concurrent tests
+  std::unique_lock<std::mutex> reportLock;
+  if (f_group_p)
+    reportLock = std::unique_lock<std::mutex>(f_group_p->reportMutex());
+
+  target.report();
+  if (GpioBackend::c_hasInterrupts_b) {
+    timeToInterrupt_p->report();
+    timeToInterrupt_p->save();
+  }
+  timeOfWrite.report();
+  timeToRead.report();
+  timeTotal.report();
+
+  timeOfWrite.save();
+  timeToRead.save();
+  timeTotal.save();
+
+  if (f_group_p) {
+    if (GpioBackend::c_hasInterrupts_b)
+      f_group_p->addResult(*timeToInterrupt_p);
+    f_group_p->addResult(timeOfWrite);
+    f_group_p->addResult(timeToRead);
+    f_group_p->addResult(timeTotal);
+  }
+
+  delete timeToInterrupt_p;
+  return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Run the calling thread on a single core.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_core_i - The core, or -1 to keep the affinity.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool pinThread(const int32_t f_core_i)
+{
+    if (f_core_i < 0)
+        return true;
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(f_core_i, &cpuSet);
+    return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Run the interrupt test and/or the serial test of a group, each
+ *            on its own thread pinned to its core, with its own capture
+ *            records and telemetry ring.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_group             - The group keeping the results.
+ * \param[in]     fr_settings          - The settings of the tests.
+ * \param[in]     f_serialPortHandle_i - The serial port handle.
+ * \param[in]     f_interrupt_b        - Run the interrupt test.
+ * \param[in]     f_serial_b           - Run the serial test.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+template <class GpioBackend>
+bool runTestGroup(TestGroup&                fr_group,
+                  const ConcurrentSettings& fr_settings,
+                  const int                 f_serialPortHandle_i,
+                  const bool                f_interrupt_b,
+                  const bool                f_serial_b) {
+  fr_group.begin((f_interrupt_b ? 1 : 0) + (f_serial_b ? 1 : 0));
+
+  // Each thread appends to its own records, reserved before the threads start
+  CaptureBlock interruptCapture, serialCapture;
+  if (f_interrupt_b)
+    g_capture.reserveBlock(interruptTestNumLoops(fr_settings.numInterruptLoops_ui), interruptCapture);
+  if (f_serial_b)
+    g_capture.reserveBlock(serialTestNumLoops(fr_settings.numSerialLoops_ui, fr_settings.rateHz_ui),
+                           serialCapture);
+
+  std::atomic<bool>        ok_b(true);
+  std::vector<std::thread> threads;
+  if (f_interrupt_b) {
+    threads.push_back(std::thread([&]() {
+      g_telemetry.attachThread(0);
+      if (!pinThread(fr_settings.interruptCore_i)) {
+        printf("Error: Can't run the interrupt test on core %d!\n", fr_settings.interruptCore_i);
+        ok_b = false;
+        fr_group.abort();
+      }
+      determineInterruptLatency<GpioBackend>(fr_settings.numInterruptLoops_ui, &fr_group, &interruptCapture);
+    }));
+  }
+  if (f_serial_b) {
+    threads.push_back(std::thread([&]() {
+      g_telemetry.attachThread(1);
+      if (!pinThread(fr_settings.serialCore_i)) {
+        printf("Error: Can't run the serial test on core %d!\n", fr_settings.serialCore_i);
+        ok_b = false;
+        fr_group.abort();
+      }
+      if (!determineSerialLatency<GpioBackend>(f_serialPortHandle_i, fr_settings.numSerialLoops_ui,
+                                               fr_settings.rateHz_ui, &fr_group, &serialCapture))
+        ok_b = false;
+    }));
+  }
+
+  for (size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+
+  // The main thread measures again after the group
+  g_telemetry.attachThread(0);
+  return ok_b;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print and save the degradation of the latencies of the
+ *            concurrent run compared to the solo runs.
+ *
+ *            The summary is saved to concurrent_summary.txt, one line per
+ *            series. Without solo runs, their columns are nan.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_solo       - The group of the solo runs.
+ * \param[in] fr_concurrent - The group of the concurrent run.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool reportConcurrentLatency(const TestGroup& fr_solo,
+                             const TestGroup& fr_concurrent) {
+  static const double c_percentiles_d[] = { 50.0, 99.0, 99.9 };
+
+  FILE* summary_p = fopen("concurrent_summary.txt", "w");
+  if (!summary_p) {
+    printf("Error: Can't create concurrent_summary.txt!\n");
+    return false;
+  }
+  fprintf(summary_p, "# Interrupt test and serial test, solo and concurrent. Columns: series, solo samples,\n"
+          "# concurrent samples, solo p50, p99, p99.9, max, concurrent p50, p99, p99.9, max [ms],\n"
+          "# concurrent p99 / solo p99\n");
+
+  printf("Degradation by the concurrent run (solo -> concurrent):\n");
+  const std::map<std::string, HdrHistogram>& results = fr_concurrent.results();
+  for (std::map<std::string, HdrHistogram>::const_iterator it = results.begin(); it != results.end(); ++it) {
+    std::map<std::string, HdrHistogram>::const_iterator soloIt = fr_solo.results().find(it->first);
+    const HdrHistogram* solo_p = (soloIt == fr_solo.results().end()) ? NULL : &soloIt->second;
+
+    double soloMs_d[4], concurrentMs_d[4];
+    for (uint32_t p = 0; p < 3; ++p) {
+      soloMs_d[p]       = solo_p ? double(solo_p->percentile(c_percentiles_d[p])) / 1000000.0 : NAN;
+      concurrentMs_d[p] = double(it->second.percentile(c_percentiles_d[p])) / 1000000.0;
+    }
+    soloMs_d[3]       = solo_p ? double(solo_p->max()) / 1000000.0 : NAN;
+    concurrentMs_d[3] = double(it->second.max()) / 1000000.0;
+    const double ratio_d = (soloMs_d[1] > 0.0) ? concurrentMs_d[1] / soloMs_d[1] : NAN;
+
+    if (solo_p)
+      printf("  %-30s p50 %.3f -> %.3f, p99 %.3f -> %.3f (x%.2f), p99.9 %.3f -> %.3f ms\n",
+             it->first.c_str(), soloMs_d[0], concurrentMs_d[0], soloMs_d[1], concurrentMs_d[1], ratio_d,
+             soloMs_d[2], concurrentMs_d[2]);
+    else
+      printf("  %-30s p50 %.3f, p99 %.3f, p99.9 %.3f ms (no baseline)\n",
+             it->first.c_str(), concurrentMs_d[0], concurrentMs_d[1], concurrentMs_d[2]);
+
+    fprintf(summary_p, "%s %llu %llu %.6f %.6f %.6f %.6f %.6f %.6f %.6f %.6f %.3f\n", it->first.c_str(),
+            (unsigned long long) (solo_p ? solo_p->count() : 0), (unsigned long long) it->second.count(),
+            soloMs_d[0], soloMs_d[1], soloMs_d[2], soloMs_d[3],
+            concurrentMs_d[0], concurrentMs_d[1], concurrentMs_d[2], concurrentMs_d[3], ratio_d);
+  }
+
+  fclose(summary_p);
+  return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Determine how the interrupt test and the serial test degrade
+ *            when they run at the same time.
+ *
+ *            Both tests run on their own threads pinned to their cores and
+ *            start at a common time. Unless disabled, each test first runs
+ *            alone on the same core as baseline, with the usual series
+ *            names. The series of the concurrent run are prefixed with
+ *            concurrent_.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_serialPortHandle_i - The serial port handle.
+ * \param[in] fr_settings          - The settings of the tests.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+template <class GpioBackend>
+bool determineConcurrentLatency(const int                 f_serialPortHandle_i,
+                                const ConcurrentSettings& fr_settings) {
+  TestGroup solo("");
+  TestGroup concurrent("concurrent_");
+
+  if (fr_settings.baseline_b) {
+    printf("Info: Solo interrupt test on core %d...\n", fr_settings.interruptCore_i);
+    if (!runTestGroup<GpioBackend>(solo, fr_settings, f_serialPortHandle_i, true, false))
+      return false;
+    printf("Info: Solo serial test on core %d...\n", fr_settings.serialCore_i);
+    if (!runTestGroup<GpioBackend>(solo, fr_settings, f_serialPortHandle_i, false, true))
+      return false;
+  }
+
+  printf("Info: Concurrent interrupt test on core %d and serial test on core %d...\n",
+         fr_settings.interruptCore_i, fr_settings.serialCore_i);
+  if (!runTestGroup<GpioBackend>(concurrent, fr_settings, f_serialPortHandle_i, true, true))
+    return false;
+
+  return reportConcurrentLatency(solo, concurrent);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the current time of the CLOCK_MONOTONIC clock in nanoseconds.
+ *
+ *            In contrast to getTimeStampNs(), this clock is the one used by
+ *            the sleep functions and timers, so it is used to determine the
+ *            wakeup latencies.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns the current time in nanoseconds.
+ *
+ *****************************************************************************/
+uint64_t getMonotonicNs()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return GET_NANOSECONDS(t);
+}
+
+
+/// Names of the wakeup methods measured by determineWakeupLatency()
+static const char* g_wakeupMethodNames_p[] = {
+  "usleep",
+  "nanosleep_rel",
+  "nanosleep_abs",
+  "timerfd"
+};
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Determine the wakeup latency of the host timers.
+ *
+ *            Similar to cyclictest, the difference between the requested and
+ *            the actual wakeup time is measured for usleep(), clock_nanosleep()
+ *            with a relative and an absolute time and a periodic timerfd.
+ *            The test runs with the priority and affinity of the process, so
+ *            the results give the scheduling floor of the other tests.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_numLoops_ui - Number of wakeups per method.
+ * \param[in] f_periodUs_ui - Sleep period in microseconds.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool determineWakeupLatency(const uint32_t f_numLoops_ui,
+                            const uint32_t f_periodUs_ui) {
+  printf("Info: Testing timer wakeup latency (%d us period)...\n", f_periodUs_ui);
+  const uint64_t periodNs_ui = uint64_t(f_periodUs_ui) * 1000;
+
+  for (uint32_t method_ui = 0; method_ui < 4; ++method_ui) {
+    const std::string name        = std::string("wakeup_") + g_wakeupMethodNames_p[method_ui];
+    char description[64];
+    snprintf(description, sizeof(description), "Wakeup latency of %-14s",
+             (std::string(g_wakeupMethodNames_p[method_ui]) + ":").c_str());
+    const uint32_t numLoops_ui = sampleTargetNumLoops(f_numLoops_ui, periodNs_ui);
+    LatencySeries wakeupLatency(name.c_str(), description, numLoops_ui);
+    uint64_t lastNs_ui = getTimeStampNs();
+    std::string progressPrefix = std::string("Wakeup latency measurement (") + g_wakeupMethodNames_p[method_ui] + ")";
+    SampleTarget target(progressPrefix.c_str());
+    target.add(wakeupLatency);
+
+    int timerHandle_i = -1;
+    if (method_ui == 3) {
+      timerHandle_i = timerfd_create(CLOCK_MONOTONIC, 0);
+      if (timerHandle_i < 0) {
+        printf("Error: Can't create timerfd!\n");
+        return false;
+      }
+    }
+
+    uint64_t startNs_ui    = getMonotonicNs();
+    uint64_t expectedNs_ui = startNs_ui;
+
+    if (timerHandle_i >= 0) {
+      struct itimerspec timerSpec;
+      timerSpec.it_interval.tv_sec  = periodNs_ui / 1000000000;
+      timerSpec.it_interval.tv_nsec = periodNs_ui % 1000000000;
+      timerSpec.it_value.tv_sec     = (startNs_ui + periodNs_ui) / 1000000000;
+      timerSpec.it_value.tv_nsec    = (startNs_ui + periodNs_ui) % 1000000000;
+      if (timerfd_settime(timerHandle_i, TFD_TIMER_ABSTIME, &timerSpec, NULL) < 0) {
+        printf("Error: Can't start timerfd!\n");
+        close(timerHandle_i);
+        return false;
+      }
+    }
+
+    for (uint32_t i = 0; i < numLoops_ui; ++i) {
+      switch (method_ui) {
+      case 0:
+        expectedNs_ui = getMonotonicNs() + periodNs_ui;
+        usleep(f_periodUs_ui);
+        break;
+
+      case 1:
+        {
+          struct timespec sleepTime;
+          sleepTime.tv_sec  = periodNs_ui / 1000000000;
+          sleepTime.tv_nsec = periodNs_ui % 1000000000;
+          expectedNs_ui = getMonotonicNs() + periodNs_ui;
+          clock_nanosleep(CLOCK_MONOTONIC, 0, &sleepTime, NULL);
+        }
+        break;
+
+      case 2:
+        {
+          struct timespec wakeupTime;
+          expectedNs_ui += periodNs_ui;
+          wakeupTime.tv_sec  = expectedNs_ui / 1000000000;
+          wakeupTime.tv_nsec = expectedNs_ui % 1000000000;
+          clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeupTime, NULL);
+        }
+        break;
+
+      default:
+        {
+          uint64_t expirations_ui = 0;
+          if (read(timerHandle_i, &expirations_ui, sizeof(expirations_ui)) != sizeof(expirations_ui)) {
+            g_telemetry.countError();
+            printf("Error: Can't read timerfd (loop %d)!\n", i);
+            close(timerHandle_i);
+            return false;
+          }
+          expectedNs_ui += expirations_ui * periodNs_ui;
+        }
+        break;
+      }
+
+      const uint64_t wakeupNs_ui = getMonotonicNs();
+      wakeupLatency.record(getNanoseconds(expectedNs_ui, wakeupNs_ui));
+      if (g_capture.isOpen())
+        g_capture.append(CAPTURE_WAKEUP + method_ui, i, expectedNs_ui, 0, wakeupNs_ui, 0);
+
+      printProgress(lastNs_ui, progressPrefix.c_str(), i, numLoops_ui);
+      if (target.done())
+        break;
+    }
+
+    if (timerHandle_i >= 0)
+      close(timerHandle_i);
+
+    target.report();
+    wakeupLatency.report();
+    wakeupLatency.save();
+  }
+
+  return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Determine the latency and the throughput of payloads of
+ *            different sizes.
+ *
+ *            Each payload is filled with a sequence counter or a PRBS-31
+ *            pattern, written and its echo is reassembled and verified in
+ *            full. The time from the start of the write to the last byte of
+ *            the echo of each size is saved as series payload_<size>B, the
+ *            summary of all sizes to payload_summary.txt. Sizes around
+ *            multiples of 64 bytes show the effect of the USB packets of
+ *            FTDI and CH340 adapters. Lost or corrupted payloads are counted,
+ *            the port is flushed and the test continues.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  f_serialPortHandle_i - The serial port handle.
+ * \param[in]  fr_sizes             - The payload sizes in bytes.
+ * \param[in]  f_numLoops_ui        - Number of loops per size.
+ * \param[in]  fr_patterns          - The patterns, used in turn.
+ * \param[out] fr_numErrors_ui      - Number of lost or corrupted payloads.
+ * \return    Returns \c true on success, \c false on an I/O error.
+ *
+ *****************************************************************************/
+bool determinePayloadLatency(const int                            f_serialPortHandle_i,
+                             const std::vector<uint32_t>&         fr_sizes,
+                             const uint32_t                       f_numLoops_ui,
+                             const std::vector<PayloadPattern_t>& fr_patterns,
+                             uint64_t&                            fr_numErrors_ui) {
+  printf("Payload write/read of %u sizes...\n", uint32_t(fr_sizes.size()));
+  fr_numErrors_ui = 0;
+
+  FILE* summary_p = fopen("payload_summary.txt", "w");
+  if (!summary_p) {
+    printf("Error: Can't create payload_summary.txt!\n");
+    return false;
+  }
+
+  SerialPortMode savedMode;
+  if (!enableSerialPolling(f_serialPortHandle_i, savedMode)) {
+    fclose(summary_p);
+    return false;
+  }
+  fprintf(summary_p, "# Payload write/read, times in ms, throughput of the echo in kB/s\n");
+  fprintf(summary_p, "# size usb_packets samples errors reads_per_transfer first_byte_p50 "
+                     "total_p50 total_p99 total_max throughput\n");
+
+  bool ok_b = true;
+  for (size_t sizeIdx_ui = 0; ok_b && (sizeIdx_ui < fr_sizes.size()); ++sizeIdx_ui) {
+    const uint32_t size_ui = fr_sizes[sizeIdx_ui];
+    char name[32], description[64], progressPrefix[64];
+    snprintf(name, sizeof(name), "payload_%uB", size_ui);
+    snprintf(description, sizeof(description), "%-45s",
+             (std::string("Time from write to echo of ") + name + ":").c_str());
+    snprintf(progressPrefix, sizeof(progressPrefix), "Payload measurement (%u bytes)", size_ui);
+
+    // The echo of a payload takes at least its transfer time
+    const uint32_t numLoops_ui = sampleTargetNumLoops(f_numLoops_ui, uint64_t(size_ui) * SERIAL_BYTE_TIME_NS);
+    LatencySeries timeTotal(name, description, numLoops_ui);
+    HdrHistogram  timeToFirstByte;
+    SampleTarget  target(progressPrefix);
+    target.add(timeTotal);
+
+    FtraceTrigger trigger;
+    ftraceInitTrigger(trigger, name);
+    const bool ftrace_b = ftraceEnabled();
+
+    uint8_t*  writeBuffer_p = new uint8_t[size_ui];
+    uint8_t*  readBuffer_p  = new uint8_t[size_ui];
+    uint64_t  lastNs_ui     = getTimeStampNs();
+    uint64_t  numReads_ui   = 0;
+    uint64_t  numErrors_ui  = 0;
+
+    for (uint32_t i = 0; i < numLoops_ui; ++i) {
+      payloadFill(fr_patterns[i % fr_patterns.size()], i, writeBuffer_p, size_ui);
+
+      PayloadTransfer transfer;
+      if (ftrace_b)
+        ftraceMarker("payload", i);
+      if (!payloadTransfer(f_serialPortHandle_i, writeBuffer_p, readBuffer_p, size_ui,
+                           PAYLOAD_TIMEOUT_MS, transfer)) {
+        g_telemetry.countError();
+        printf("Error: Payload write/read of %u bytes failed (loop %d)!\n", size_ui, i);
+        ok_b = false;
+        break;
+      }
+
+      const int64_t mismatch_i = (transfer.received_ui < size_ui)
+                                 ? int64_t(transfer.received_ui)
+                                 : payloadFirstMismatch(writeBuffer_p, readBuffer_p, size_ui);
+      if (mismatch_i >= 0) {
+        g_telemetry.countError();
+        ++numErrors_ui;
+        if (transfer.received_ui < size_ui)
+          printf("Warning: Received %u of %u bytes (loop %d)!\n", transfer.received_ui, size_ui, i);
+        else
+          printf("Warning: Payload of %u bytes differs at offset %lld (byte %lld of its USB packet): "
+                 "expected 0x%02x, received 0x%02x, CRC 0x%08x instead of 0x%08x (loop %d)!\n",
+                 size_ui, (long long) mismatch_i, (long long) (mismatch_i % 64),
+                 writeBuffer_p[mismatch_i], readBuffer_p[mismatch_i], payloadCrc32(0, readBuffer_p, size_ui),
+                 payloadCrc32(0, writeBuffer_p, size_ui), i);
+
+        // Drop the rest of the echo, so the next payload starts in sync
+        usleep(ARDUINO_SETTLE_TIME_MS * 1000);
+        tcflush(f_serialPortHandle_i, TCIOFLUSH);
+        continue;
+      }
+
+      timeToFirstByte.record(getNanoseconds(transfer.startNs_ui, transfer.firstByteNs_ui));
+      const int64_t timeTotalNs_i = getNanoseconds(transfer.startNs_ui, transfer.endNs_ui);
+      timeTotal.record(timeTotalNs_i);
+      if (ftrace_b)
+        ftraceCheckSample(trigger, timeTotal.histogram(), timeTotalNs_i);
+      numReads_ui += transfer.numReads_ui;
+
+      printProgress(lastNs_ui, progressPrefix, i, numLoops_ui);
+      if (target.done())
+        break;
+    }
+
+    delete[] writeBuffer_p;
+    delete[] readBuffer_p;
+    fr_numErrors_ui += numErrors_ui;
+
+    const HdrHistogram& total = timeTotal.histogram();
+    const uint64_t numSamples_ui = total.count();
+    const double   p50Ms_d       = double(total.percentile(50.0)) / 1000000.0;
+    const double   throughput_d  = (p50Ms_d > 0.0) ? double(size_ui) / p50Ms_d : 0.0;
+    target.report();
+    timeTotal.report();
+    printf("%*s first byte p50 = %.3f ms, %.1f reads per transfer, %.2f kB/s, %llu errors\n",
+           45, "", double(timeToFirstByte.percentile(50.0)) / 1000000.0,
+           (numSamples_ui > 0) ? double(numReads_ui) / double(numSamples_ui) : 0.0,
+           throughput_d, (unsigned long long) numErrors_ui);
+    timeTotal.save();
+
+    fprintf(summary_p, "%u %u %llu %llu %.2f %.6f %.6f %.6f %.6f %.3f\n",
+            size_ui, (size_ui + 63) / 64, (unsigned long long) numSamples_ui,
+            (unsigned long long) numErrors_ui,
+            (numSamples_ui > 0) ? double(numReads_ui) / double(numSamples_ui) : 0.0,
+            double(timeToFirstByte.percentile(50.0)) / 1000000.0, p50Ms_d,
+            double(total.percentile(99.0)) / 1000000.0, double(total.max()) / 1000000.0,
+            throughput_d);
+  }
+
+  fclose(summary_p);
+  return restoreSerialMode(f_serialPortHandle_i, savedMode) && ok_b;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Main entry point.
+ *
+ * \author    Clemens Rabe
+ * \date      Apr 06, 2019
+ *
+ * \param[in] f_argc_i - Number of arguments.
+ * \param[in] f_argv_p - Arguments.
+ * \return    Return code of the application.
+ *
+ *****************************************************************************/
+int main(int f_argc_i, char** f_argv_p) {
     const char* progName_p = f_argv_p[0];
     std::string serialDevice = "";
     int32_t ftdiTgtLatency_i = 1;
     uint32_t numBytes_ui = 1;
+    bool performWakeupLatencyTest_b = true;
+    uint32_t numWakeupLoops_ui = 1000;
+    uint32_t wakeupPeriodUs_ui = 1000;
     bool performInterruptLatencyTest_b = true;
     uint32_t numInterruptLoops_ui = 10000;
     bool performBulkSerialTest_b = true;
+    uint32_t numBulkSerialLoops_ui = 1200;
     bool performedTimedSerialTest_b = true;
     uint32_t numTimedSerialLoops_ui = 20 * 60;
+    uint32_t timedSerialRateHz_ui = 20;
+    bool performPayloadTest_b = false;
+    uint32_t numPayloadLoops_ui = 50;
+    std::string payloadSizes = PAYLOAD_DEFAULT_SIZES;
+    std::string payloadPattern = "both";
+    bool performConcurrentTest_b = false;
+    int32_t concurrentInterruptCore_i = -2;
+    int32_t concurrentSerialCore_i = -2;
+    bool concurrentBaseline_b = true;
+    bool storeSamples_b = true;
+    uint32_t significantDigits_ui = 3;
+    float intervalS_f = 0.0f;
+    std::string captureFileName = "";
+    std::string telemetrySocket = "";
+    uint32_t prometheusPort_ui = 0;
+    float telemetryWindowS_f = 10.0f;
+    uint32_t readyTimeoutMs_ui = 5000;
+    std::string boardName = "";
+    bool printBoard_b = false;
+    bool useKernelDriver_b = false;
+    int32_t core_i = -2;
+    bool noReset_b = false;
+    float ftracePercentile_f = 0.0f;
+    float ftraceLimitMs_f = 0.0f;
+    std::string targetWidth = "";
+    std::string targetPercentiles = "50,99";
+    double targetConfidence_d = 95.0;
+    double timeBudgetS_d = 600.0;
 
     // Parse command line arguments
     for (int i=1; i < f_argc_i; ++i) {
@@ -607,46 +1802,306 @@ int main(int f_argc_i, char** f_argv_p) {
         else if ((strcmp(f_argv_p[i], "-s") == 0) ||
                  (strcmp(f_argv_p[i], "--size") == 0)) {
           if (++i < f_argc_i) {
-            numBytes_ui = atoi(f_argv_p[i]);
+            numBytes_ui = uint32_t(parseInteger(progName_p, "-s", f_argv_p[i], 1, BULK_MAX_SIZE));
           } else {
             printf("Error: Expected argument after -s option!\n");
             usage(progName_p);
           }
         }
+        else if ((strcmp(f_argv_p[i], "--board") == 0)) {
+          if (++i < f_argc_i) {
+            boardName = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --board option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--print-board") == 0)) {
+          printBoard_b = true;
+        }
+        else if ((strcmp(f_argv_p[i], "--kmod") == 0)) {
+          useKernelDriver_b = true;
+        }
+        else if ((strcmp(f_argv_p[i], "--core") == 0)) {
+          if (++i < f_argc_i) {
+            core_i = int32_t(parseInteger(progName_p, "--core", f_argv_p[i], -1,
+                                          int64_t(sysconf(_SC_NPROCESSORS_ONLN)) - 1));
+          } else {
+            printf("Error: Expected argument after --core option!\n");
+            usage(progName_p);
+          }
+        }
         else if ((strcmp(f_argv_p[i], "-i") == 0) ||
                  (strcmp(f_argv_p[i], "--interrupt") == 0)) {
+          performWakeupLatencyTest_b = false;
           performInterruptLatencyTest_b = true;
           performBulkSerialTest_b = false;
           performedTimedSerialTest_b = false;
+          performPayloadTest_b = false;
+          performConcurrentTest_b = false;
         }
         else if ((strcmp(f_argv_p[i], "--iloops") == 0)) {
           if (++i < f_argc_i) {
-            numInterruptLoops_ui = atoi(f_argv_p[i]);
+            numInterruptLoops_ui = parseLoops(progName_p, "--iloops", f_argv_p[i]);
           } else {
             printf("Error: Expected argument after --iloops option!\n");
             usage(progName_p);
           }
         }
+        else if ((strcmp(f_argv_p[i], "-w") == 0) ||
+                 (strcmp(f_argv_p[i], "--wakeup") == 0)) {
+          performWakeupLatencyTest_b = true;
+          performInterruptLatencyTest_b = false;
+          performBulkSerialTest_b = false;
+          performedTimedSerialTest_b = false;
+          performPayloadTest_b = false;
+          performConcurrentTest_b = false;
+        }
+        else if ((strcmp(f_argv_p[i], "--wloops") == 0)) {
+          if (++i < f_argc_i) {
+            numWakeupLoops_ui = parseLoops(progName_p, "--wloops", f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --wloops option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--wperiod") == 0)) {
+          if (++i < f_argc_i) {
+            wakeupPeriodUs_ui = uint32_t(parseInteger(progName_p, "--wperiod", f_argv_p[i], 1, WAKEUP_MAX_PERIOD_US));
+          } else {
+            printf("Error: Expected argument after --wperiod option!\n");
+            usage(progName_p);
+          }
+        }
         else if ((strcmp(f_argv_p[i], "-b") == 0) ||
                  (strcmp(f_argv_p[i], "--bulk") == 0)) {
+          performWakeupLatencyTest_b = false;
           performInterruptLatencyTest_b = false;
           performBulkSerialTest_b = true;
           performedTimedSerialTest_b = false;
+          performPayloadTest_b = false;
+          performConcurrentTest_b = false;
+        }
+        else if ((strcmp(f_argv_p[i], "--bloops") == 0)) {
+          if (++i < f_argc_i) {
+            numBulkSerialLoops_ui = parseLoops(progName_p, "--bloops", f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --bloops option!\n");
+            usage(progName_p);
+          }
         }
         else if ((strcmp(f_argv_p[i], "-t") == 0) ||
                  (strcmp(f_argv_p[i], "--timed") == 0)) {
+          performWakeupLatencyTest_b = false;
           performInterruptLatencyTest_b = false;
           performBulkSerialTest_b = false;
           performedTimedSerialTest_b = true;
+          performPayloadTest_b = false;
+          performConcurrentTest_b = false;
+        }
+        else if ((strcmp(f_argv_p[i], "-p") == 0) ||
+                 (strcmp(f_argv_p[i], "--payload") == 0)) {
+          performWakeupLatencyTest_b = false;
+          performInterruptLatencyTest_b = false;
+          performBulkSerialTest_b = false;
+          performedTimedSerialTest_b = false;
+          performPayloadTest_b = true;
+          performConcurrentTest_b = false;
+        }
+        else if ((strcmp(f_argv_p[i], "--psizes") == 0)) {
+          if (++i < f_argc_i) {
+            payloadSizes = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --psizes option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--ploops") == 0)) {
+          if (++i < f_argc_i) {
+            numPayloadLoops_ui = parseLoops(progName_p, "--ploops", f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --ploops option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--ppattern") == 0)) {
+          if (++i < f_argc_i) {
+            payloadPattern = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --ppattern option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--concurrent") == 0)) {
+          performWakeupLatencyTest_b = false;
+          performInterruptLatencyTest_b = false;
+          performBulkSerialTest_b = false;
+          performedTimedSerialTest_b = false;
+          performPayloadTest_b = false;
+          performConcurrentTest_b = true;
+        }
+        else if ((strcmp(f_argv_p[i], "--concurrent-cores") == 0)) {
+          if (++i < f_argc_i) {
+            if ((sscanf(f_argv_p[i], "%d,%d", &concurrentInterruptCore_i, &concurrentSerialCore_i) != 2) ||
+                (concurrentInterruptCore_i < -1) || (concurrentSerialCore_i < -1)) {
+              printf("Error: Invalid cores %s!\n", f_argv_p[i]);
+              usage(progName_p);
+            }
+          } else {
+            printf("Error: Expected argument after --concurrent-cores option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--no-baseline") == 0)) {
+          concurrentBaseline_b = false;
         }
         else if ((strcmp(f_argv_p[i], "--tloops") == 0)) {
           if (++i < f_argc_i) {
-            numTimedSerialLoops_ui = atoi(f_argv_p[i]);
+            numTimedSerialLoops_ui = parseLoops(progName_p, "--tloops", f_argv_p[i]);
           } else {
             printf("Error: Expected argument after --tloops option!\n");
             usage(progName_p);
           }
         }
+        else if ((strcmp(f_argv_p[i], "--rate") == 0)) {
+          if (++i < f_argc_i) {
+            timedSerialRateHz_ui = atoi(f_argv_p[i]);
+            if (timedSerialRateHz_ui == 0) {
+              printf("Error: The rate must be at least 1 Hz!\n");
+              usage(progName_p);
+            }
+          } else {
+            printf("Error: Expected argument after --rate option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--load") == 0)) {
+          if (++i < f_argc_i) {
+            if (!g_load.add(f_argv_p[i]))
+              usage(progName_p);
+          } else {
+            printf("Error: Expected argument after --load option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--no-raw") == 0)) {
+          storeSamples_b = false;
+        }
+        else if ((strcmp(f_argv_p[i], "--hdr-digits") == 0)) {
+          if (++i < f_argc_i) {
+            significantDigits_ui = uint32_t(parseInteger(progName_p, "--hdr-digits", f_argv_p[i], 1, 5));
+          } else {
+            printf("Error: Expected argument after --hdr-digits option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--interval") == 0)) {
+          if (++i < f_argc_i) {
+            intervalS_f = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --interval option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--target-ci") == 0)) {
+          if (++i < f_argc_i) {
+            targetWidth = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --target-ci option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--target-percentiles") == 0)) {
+          if (++i < f_argc_i) {
+            targetPercentiles = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --target-percentiles option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--target-confidence") == 0)) {
+          if (++i < f_argc_i) {
+            targetConfidence_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --target-confidence option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--time-budget") == 0)) {
+          if (++i < f_argc_i) {
+            timeBudgetS_d = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --time-budget option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--telemetry") == 0)) {
+          if (++i < f_argc_i) {
+            telemetrySocket = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --telemetry option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--prometheus") == 0)) {
+          if (++i < f_argc_i) {
+            prometheusPort_ui = atoi(f_argv_p[i]);
+            if ((prometheusPort_ui == 0) || (prometheusPort_ui > 65535)) {
+              printf("Error: Invalid port %s!\n", f_argv_p[i]);
+              usage(progName_p);
+            }
+          } else {
+            printf("Error: Expected argument after --prometheus option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--telemetry-window") == 0)) {
+          if (++i < f_argc_i) {
+            telemetryWindowS_f = atof(f_argv_p[i]);
+            if (telemetryWindowS_f <= 0.0f) {
+              printf("Error: The telemetry window must be positive!\n");
+              usage(progName_p);
+            }
+          } else {
+            printf("Error: Expected argument after --telemetry-window option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--ready-timeout") == 0)) {
+          if (++i < f_argc_i) {
+            readyTimeoutMs_ui = uint32_t(parseInteger(progName_p, "--ready-timeout", f_argv_p[i], 1, UINT32_MAX));
+          } else {
+            printf("Error: Expected argument after --ready-timeout option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--no-reset") == 0)) {
+          noReset_b = true;
+        }
+        else if ((strcmp(f_argv_p[i], "--capture") == 0)) {
+          if (++i < f_argc_i) {
+            captureFileName = f_argv_p[i];
+          } else {
+            printf("Error: Expected argument after --capture option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--ftrace-percentile") == 0)) {
+          if (++i < f_argc_i) {
+            ftracePercentile_f = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --ftrace-percentile option!\n");
+            usage(progName_p);
+          }
+        }
+        else if ((strcmp(f_argv_p[i], "--ftrace-limit") == 0)) {
+          if (++i < f_argc_i) {
+            ftraceLimitMs_f = atof(f_argv_p[i]);
+          } else {
+            printf("Error: Expected argument after --ftrace-limit option!\n");
+            usage(progName_p);
+          }
+        }
         else if (f_argv_p[i][0] == '-') {
             printf("Error: Unknown option %s! Please see usage for available options!\n\n",
                    f_argv_p[i]);
@@ -661,6 +2116,96 @@ int main(int f_argc_i, char** f_argv_p) {
         }
     }
 
+    if (!targetWidth.empty()) {
+        std::vector<double> percentiles;
+        for (size_t start_ui = 0; start_ui < targetPercentiles.size(); ) {
+            size_t end_ui = targetPercentiles.find(',', start_ui);
+            if (end_ui == std::string::npos)
+                end_ui = targetPercentiles.size();
+            percentiles.push_back(atof(targetPercentiles.substr(start_ui, end_ui - start_ui).c_str()));
+            start_ui = end_ui + 1;
+        }
+        if (!sampleTargetConfigure(targetWidth, percentiles, targetConfidence_d, timeBudgetS_d,
+                                   significantDigits_ui))
+            usage(progName_p);
+    }
+
+    std::vector<uint32_t>         sizes;
+    std::vector<PayloadPattern_t> patterns;
+    if (!payloadParseSizes(payloadSizes.c_str(), sizes))
+        usage(progName_p);
+    if ((payloadPattern == "sequence") || (payloadPattern == "both"))
+        patterns.push_back(PAYLOAD_PATTERN_SEQUENCE);
+    if ((payloadPattern == "prbs") || (payloadPattern == "both"))
+        patterns.push_back(PAYLOAD_PATTERN_PRBS);
+    if (patterns.empty()) {
+        printf("Error: Unknown payload pattern %s!\n", payloadPattern.c_str());
+        usage(progName_p);
+    }
+
+    // Select the board and the backend of the GPIO interrupts
+    if (boardName.empty())
+        boardDetect(g_board);
+    else if (!boardSelect(boardName, g_board))
+        return 4;
+
+    if (printBoard_b) {
+        boardPrint(g_board);
+        return 0;
+    }
+
+    if (boardHasGpio(g_board)) {
+#ifdef HAVE_WIRINGPI
+        g_gpioBackend = useKernelDriver_b ? GPIO_BACKEND_KMOD : GPIO_BACKEND_USERSPACE;
+#else
+        printf("Error: The board %s has GPIOs, but latencyTest was built without wiringPi!\n",
+               g_board.name.c_str());
+        return 5;
+#endif
+    }
+    else if (useKernelDriver_b) {
+        printf("Warning: The board %s has no GPIOs, ignoring --kmod.\n", g_board.name.c_str());
+    }
+    printf("Info: Board %s, GPIO interrupts: %s.\n", g_board.name.c_str(),
+           g_gpioBackendNames_p[g_gpioBackend]);
+
+    if (performConcurrentTest_b && (g_gpioBackend == GPIO_BACKEND_NONE)) {
+        printf("Error: The concurrent test needs the GPIO interrupts of the board!\n");
+        return 5;
+    }
+
+    if (core_i == -2)
+        core_i = affinityRestricted() ? -1 : g_board.defaultCore_i;
+    if (core_i >= 0) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(core_i, &cpuSet);
+        if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0) {
+            printf("Error: Can't run on core %d!\n", core_i);
+            return 4;
+        }
+        printf("Info: Running on core %d.\n", core_i);
+    }
+
+#ifdef HAVE_WIRINGPI
+    ConcurrentSettings concurrent;
+    concurrent.interruptCore_i      = core_i;
+    concurrent.serialCore_i         = (core_i >= 0) ? (core_i + 1) % int32_t(sysconf(_SC_NPROCESSORS_ONLN)) : -1;
+    concurrent.numInterruptLoops_ui = numInterruptLoops_ui;
+    concurrent.numSerialLoops_ui    = numTimedSerialLoops_ui;
+    concurrent.rateHz_ui            = timedSerialRateHz_ui;
+    concurrent.baseline_b           = concurrentBaseline_b;
+    if (concurrentInterruptCore_i != -2) {
+        concurrent.interruptCore_i = concurrentInterruptCore_i;
+        concurrent.serialCore_i    = concurrentSerialCore_i;
+    }
+    if (performConcurrentTest_b && (concurrent.interruptCore_i >= 0) &&
+        (concurrent.interruptCore_i == concurrent.serialCore_i)) {
+        printf("Warning: Both tests of --concurrent run on core %d, so they take turns on the CPU "
+               "instead of running at the same time!\n", concurrent.interruptCore_i);
+    }
+#endif
+
     // Auto detect serial device
     if (serialDevice.empty()) {
         if (fileExists("/dev/ttyUSB0")) {
@@ -712,15 +2257,84 @@ int main(int f_argc_i, char** f_argv_p) {
         }
     }
 
-#if defined(ON_RASPBERRY_PI) or defined(ON_ODROID_XU4)
-    if (!initializeWiringPi())
+    if (g_load.usesDevice(serialDevice)) {
+        printf("Error: The load uses the serial device %s of the Arduino!\n", serialDevice.c_str());
+        return 13;
+    }
+
+    writeRunInfo(serialDevice, numBytes_ui, timedSerialRateHz_ui, g_load.profile());
+
+    // Start the load once the run is set up, so a wrong option does not
+    // start it. The loads without a core keep the affinity of latencyTest.
+    if (!g_load.start())
+        return 13;
+
+    latencySeriesConfigure(storeSamples_b, significantDigits_ui, intervalS_f);
+
+    if (!ftraceInitialize(ftracePercentile_f, ftraceLimitMs_f))
+      return 6;
+
+    if (!telemetrySocket.empty() || (prometheusPort_ui != 0)) {
+      if (!g_telemetry.start(telemetrySocket, prometheusPort_ui, telemetryWindowS_f))
+        return 9;
+      latencySeriesSetSink(&g_telemetry);
+    }
+
+    if (!captureFileName.empty()) {
+      CaptureHeader header;
+      captureInitializeHeader(header);
+      header.ftdiLatencyMs_i = getFtdiLatency(serialDevice);
+      header.payloadSize_ui  = numBytes_ui;
+      header.rateHz_ui       = timedSerialRateHz_ui;
+      snprintf(header.board,  sizeof(header.board),  "%s", g_board.name.c_str());
+      snprintf(header.driver, sizeof(header.driver), "%s", g_gpioBackendNames_p[g_gpioBackend]);
+      snprintf(header.device, sizeof(header.device), "%s", serialDevice.c_str());
+      if (!g_load.empty())
+        snprintf(header.comment, sizeof(header.comment), "load = %s", g_load.profile().c_str());
+
+      // Size the capture for all records of the run, so the tests never grow it
+      const uint64_t interruptRecords_ui = interruptTestNumLoops(numInterruptLoops_ui);
+      const uint64_t serialRecords_ui    = serialTestNumLoops(numTimedSerialLoops_ui, timedSerialRateHz_ui);
+      uint64_t numRecords_ui = 0;
+      if (performWakeupLatencyTest_b)
+        numRecords_ui += 4 * uint64_t(sampleTargetNumLoops(numWakeupLoops_ui, uint64_t(wakeupPeriodUs_ui) * 1000));
+      if (performInterruptLatencyTest_b)
+        numRecords_ui += interruptRecords_ui;
+      if (performedTimedSerialTest_b)
+        numRecords_ui += serialRecords_ui;
+      if (performConcurrentTest_b)
+        numRecords_ui += (concurrentBaseline_b ? 2 : 1) * (interruptRecords_ui + serialRecords_ui);
+
+      if (!g_capture.open(captureFileName, header, numRecords_ui))
+        return 8;
+      printf("Info: Capturing raw timestamps to %s.\n", captureFileName.c_str());
+    }
+
+    if (performWakeupLatencyTest_b) {
+      if (!determineWakeupLatency(numWakeupLoops_ui, wakeupPeriodUs_ui))
+        return 7;
+    }
+
+    if (!initializeGpio())
       return 5;
 
     if (performInterruptLatencyTest_b) {
-      determineInterruptLatency(numInterruptLoops_ui);
-    }
+      switch (g_gpioBackend) {
+#ifdef HAVE_WIRINGPI
+      case GPIO_BACKEND_USERSPACE:
+        determineInterruptLatency<UserSpaceGpioBackend>(numInterruptLoops_ui);
+        break;
+
+      case GPIO_BACKEND_KMOD:
+        determineInterruptLatency<KernelGpioBackend>(numInterruptLoops_ui);
+        break;
 #endif
 
+      default:
+        break;
+      }
+    }
+
     // Open the serial port
     const std::string serialPortName = "/dev/" + serialDevice;
     int serialPortHandle_i = open(serialPortName.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
@@ -735,134 +2349,126 @@ int main(int f_argc_i, char** f_argv_p) {
         return 11;
     }
 
-    printf("Waiting for arduino to start (5 seconds)...\n");
-    sleep(5);
+    if (!configureModemLines(serialPortHandle_i, noReset_b)) {
+        close(serialPortHandle_i);
+        return 11;
+    }
+
+    printf("Waiting for arduino to start (at most %u ms)...\n", readyTimeoutMs_ui);
+    if (!waitForArduino(serialPortHandle_i, readyTimeoutMs_ui, noReset_b)) {
+        close(serialPortHandle_i);
+        return 12;
+    }
 
     if (performBulkSerialTest_b) {
       printf("Bulk write/read ...\n");
-      const uint32_t numLoops_ui = 1200;
+      const uint32_t numLoops_ui = numBulkSerialLoops_ui;
       const uint64_t startNs_ui = getTimeStampNs();
 
       uint8_t* writeBuffer_p = new uint8_t[numBytes_ui];
       uint8_t* readBuffer_p  = new uint8_t[numBytes_ui];
 
       for (uint32_t i = 0; i < numLoops_ui; ++i) {
-        const uint8_t writtenChar_ui = i % 256;
-        for (uint32_t j = 0; j < numBytes_ui; ++j)
-          writeBuffer_p[j] = writtenChar_ui;
-
-        uint8_t readChar_ui;
+        payloadFill(PAYLOAD_PATTERN_SEQUENCE, i, writeBuffer_p, numBytes_ui);
 
         if (!writeChars(serialPortHandle_i, numBytes_ui, writeBuffer_p)) {
+          g_telemetry.countError();
           printf("Error: Can't write character(s) on serial line (loop %d)!\n", i);
           close(serialPortHandle_i);
           return 20;
         }
 
         if (!readChars(serialPortHandle_i, numBytes_ui, readBuffer_p)) {
+          g_telemetry.countError();
           printf("Error: Can't read character(s) from serial line (loop %d)\n", i);
           close(serialPortHandle_i);
           return 21;
         }
 
-        if (writtenChar_ui != readBuffer_p[0]) {
-          printf("Error: Written character %d but received character %d!\n",
-                 int(writtenChar_ui), int(readBuffer_p[0]));
+        const int64_t mismatch_i = payloadFirstMismatch(writeBuffer_p, readBuffer_p, numBytes_ui);
+        if (mismatch_i >= 0) {
+          g_telemetry.countError();
+          printf("Error: Written character %d but received character %d at offset %lld (loop %d)!\n",
+                 int(writeBuffer_p[mismatch_i]), int(readBuffer_p[mismatch_i]), (long long) mismatch_i, i);
           close(serialPortHandle_i);
           return 22;
         }
       }
       const uint64_t endNs_ui = getTimeStampNs();
+      delete[] writeBuffer_p;
+      delete[] readBuffer_p;
 
       printf("%.3f ms per iteration\n", getMilliseconds(startNs_ui, endNs_ui) / float(numLoops_ui));
     }
 
     if (performedTimedSerialTest_b) {
-      printf("Write/read at 20 Hz...\n");
-      TimeSeries_t timeToInterrupt;
-      TimeSeries_t timeOfWrite;
-      TimeSeries_t timeToRead;
-      TimeSeries_t timeTotal;
-      uint64_t     lastNs_ui = getTimeStampNs();
-
-      timeToInterrupt.reserve(numTimedSerialLoops_ui);
-      timeOfWrite.reserve(numTimedSerialLoops_ui);
-      timeToRead.reserve(numTimedSerialLoops_ui);
-      timeTotal.reserve(numTimedSerialLoops_ui);
-
-#if defined(ON_RASPBERRY_PI) or defined(ON_ODROID_XU4)
-#ifdef USE_KERNEL_DRIVER
-      g_last_arduino_counter_i = getSysfsCounter("/sys/gpiotiming/arduino_counter");
-#endif /* USE_KERNEL_DRIVER */
+      bool ok_b = true;
+      switch (g_gpioBackend) {
+#ifdef HAVE_WIRINGPI
+      case GPIO_BACKEND_USERSPACE:
+        ok_b = determineSerialLatency<UserSpaceGpioBackend>(serialPortHandle_i, numTimedSerialLoops_ui,
+                                                            timedSerialRateHz_ui);
+        break;
+
+      case GPIO_BACKEND_KMOD:
+        ok_b = determineSerialLatency<KernelGpioBackend>(serialPortHandle_i, numTimedSerialLoops_ui,
+                                                         timedSerialRateHz_ui);
+        break;
 #endif
-      
-      for (uint32_t i = 0; i < numTimedSerialLoops_ui; ++i) {
-        const uint8_t writtenChar_ui = i % 256;
-        uint64_t timeBeforeWrite_ui, timeAfterWrite_ui, timeAfterRead_ui;
-
-        usleep(1000000 / 20);
-        if (!timeWriteRead(serialPortHandle_i, writtenChar_ui,
-                           timeBeforeWrite_ui, timeAfterWrite_ui, timeAfterRead_ui))
-          {
-            printf("Error: Write/Read of character failed (loop %d)\n", i);
-            close(serialPortHandle_i);
-            return 30;
-          }
 
-#if defined(ON_RASPBERRY_PI) or defined(ON_ODROID_XU4)
-        // Interrupt is only triggered on falling edge, that means if we have written
-        // a value with the lowest bit set to 0.
-        if ((i > 0) && (writtenChar_ui % 2) == 0) {
-#ifdef USE_KERNEL_DRIVER
-	  waitForSysfsArduinoTimestamp();
-#endif /* USE_KERNEL_DRIVER */
-          const float timeToInterruptMs_f = getMilliseconds(timeBeforeWrite_ui, g_timeInterrupt_ui);
-          timeToInterrupt.push_back(timeToInterruptMs_f);
-        }
-#endif
+      default:
+        ok_b = determineSerialLatency<NoGpioBackend>(serialPortHandle_i, numTimedSerialLoops_ui,
+                                                     timedSerialRateHz_ui);
+        break;
+      }
 
-        const float timeOfWriteMs_f = getMilliseconds(timeBeforeWrite_ui, timeAfterWrite_ui);
-        timeOfWrite.push_back(timeOfWriteMs_f);
+      if (!ok_b) {
+        close(serialPortHandle_i);
+        return 30;
+      }
+    }
 
-        const float timeToReadMs_f = getMilliseconds(timeAfterWrite_ui, timeAfterRead_ui);
-        timeToRead.push_back(timeToReadMs_f);
+    if (performPayloadTest_b) {
+      uint64_t numErrors_ui = 0;
+      if (!determinePayloadLatency(serialPortHandle_i, sizes, numPayloadLoops_ui, patterns, numErrors_ui)) {
+        close(serialPortHandle_i);
+        return 40;
+      }
+      if (numErrors_ui > 0) {
+        printf("Error: %llu payloads were lost or corrupted!\n", (unsigned long long) numErrors_ui);
+        close(serialPortHandle_i);
+        return 41;
+      }
+    }
 
-        const float timeTotalMs_f = getMilliseconds(timeBeforeWrite_ui, timeAfterRead_ui);
-        timeTotal.push_back(timeTotalMs_f);
+    if (performConcurrentTest_b) {
+      bool ok_b = true;
+      switch (g_gpioBackend) {
+#ifdef HAVE_WIRINGPI
+      case GPIO_BACKEND_USERSPACE:
+        ok_b = determineConcurrentLatency<UserSpaceGpioBackend>(serialPortHandle_i, concurrent);
+        break;
+
+      case GPIO_BACKEND_KMOD:
+        ok_b = determineConcurrentLatency<KernelGpioBackend>(serialPortHandle_i, concurrent);
+        break;
+#endif
 
-        printProgress(lastNs_ui, "Serial write/read latency measurement", i, numTimedSerialLoops_ui);
+      default:
+        break;
       }
-#if defined(ON_RASPBERRY_PI) or defined(ON_ODROID_XU4)
-      TimeAnalysis timeToInterruptAnalysis;
-      calculateStatistics(timeToInterrupt, timeToInterruptAnalysis);
-
-      printf("Time between start of write and interrupt:    %.3f ms (mean = %.3f, min = %.3f, max=%.3f)\n",
-             timeToInterruptAnalysis.median_f, timeToInterruptAnalysis.mean_f,
-             timeToInterruptAnalysis.min_f, timeToInterruptAnalysis.max_f);
 
-      saveTimeSeries(timeToInterrupt, "startWrite_to_interrupt.gpd");
-#endif
-      TimeAnalysis timeOfWriteAnalysis, timeToReadAnalysis, timeTotalAnalysis;
-      calculateStatistics(timeOfWrite, timeOfWriteAnalysis);
-      calculateStatistics(timeToRead, timeToReadAnalysis);
-      calculateStatistics(timeTotal, timeTotalAnalysis);
-
-      printf("Time between start of write and end of write: %.3f ms (mean = %.3f, min = %.3f, max=%.3f)\n",
-             timeOfWriteAnalysis.median_f, timeOfWriteAnalysis.mean_f,
-             timeOfWriteAnalysis.min_f, timeOfWriteAnalysis.max_f);
-      printf("Time between end of write and end of read:    %.3f ms (mean = %.3f, min = %.3f, max=%.3f)\n",
-             timeToReadAnalysis.median_f, timeToReadAnalysis.mean_f,
-             timeToReadAnalysis.min_f, timeToReadAnalysis.max_f);
-      printf("Time between start of write and end of read:  %.3f ms (mean = %.3f, min = %.3f, max=%.3f)\n",
-             timeTotalAnalysis.median_f, timeTotalAnalysis.mean_f,
-             timeTotalAnalysis.min_f, timeTotalAnalysis.max_f);
-
-      saveTimeSeries(timeOfWrite, "startWrite_to_endWrite.gpd");
-      saveTimeSeries(timeToRead, "endWrite_to_endRead.gpd");
-      saveTimeSeries(timeTotal, "startWrite_to_endRead.gpd");
+      if (!ok_b) {
+        close(serialPortHandle_i);
+        return 50;
+      }
     }
 
     close(serialPortHandle_i);
+    g_load.stop(true);
+    ftraceShutdown();
+    g_telemetry.stop();
+    g_capture.close();
 
     return 0;
 }
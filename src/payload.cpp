@@ -0,0 +1,310 @@
+/* ********************************* FILE ************************************/
+/** \file    payload.cpp
+ *
+ * \brief    This file describes the payloads of the serial transfer tests.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "payload.h"
+#include "serialTiming.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+/// Reflected polynomial of the CRC-32 (IEEE 802.3)
+#define PAYLOAD_CRC32_POLYNOMIAL 0xEDB88320u
+
+/// Largest payload size accepted by payloadParseSizes()
+#define PAYLOAD_MAX_SIZE         (1024 * 1024)
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// Tables of the CRC-32 processing eight bytes per step (slicing-by-8)
+static uint32_t g_crcTable[8][256];
+
+/// Set once g_crcTable is filled
+static bool     g_crcTableReady_b = false;
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Fill the tables of the CRC-32.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+static void payloadInitCrcTable()
+{
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc_ui = i;
+        for (uint32_t bit_ui = 0; bit_ui < 8; ++bit_ui)
+            crc_ui = (crc_ui >> 1) ^ ((crc_ui & 1) ? PAYLOAD_CRC32_POLYNOMIAL : 0);
+        g_crcTable[0][i] = crc_ui;
+    }
+    for (uint32_t i = 0; i < 256; ++i)
+        for (uint32_t slice_ui = 1; slice_ui < 8; ++slice_ui)
+            g_crcTable[slice_ui][i] = (g_crcTable[slice_ui - 1][i] >> 8) ^
+                                      g_crcTable[0][g_crcTable[slice_ui - 1][i] & 0xFF];
+    g_crcTableReady_b = true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Fill a payload with a pattern.
+ *
+ *            The sequence pattern holds a 16 bit little endian counter, so a
+ *            byte dropped or repeated anywhere in up to 128 kB shifts the
+ *            remaining bytes. The PRBS-31 pattern has no repetition within a
+ *            payload and toggles all bits, which also catches corruptions
+ *            depending on the data, e.g. by a wrong baud rate.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  f_pattern_e - The pattern.
+ * \param[in]  f_seed_ui   - The seed, e.g. the loop number.
+ * \param[out] f_data_p    - The payload.
+ * \param[in]  f_size_ui   - The size of the payload in bytes.
+ *
+ *****************************************************************************/
+void payloadFill(const PayloadPattern_t f_pattern_e,
+                 const uint32_t         f_seed_ui,
+                 uint8_t*               f_data_p,
+                 const uint32_t         f_size_ui)
+{
+    if (f_pattern_e == PAYLOAD_PATTERN_SEQUENCE) {
+        for (uint32_t i = 0; i < f_size_ui; ++i) {
+            const uint16_t counter_ui = uint16_t(f_seed_ui + (i >> 1));
+            f_data_p[i] = uint8_t((i & 1) ? (counter_ui >> 8) : counter_ui);
+        }
+        return;
+    }
+
+    // The taps are at bits 30 and 27, so the next eight bits only depend on
+    // bits 30 to 20 of the state and are computed at once.
+    uint32_t state_ui = ((f_seed_ui * 2654435761u) & 0x7FFFFFFFu) | 1u;
+    for (uint32_t i = 0; i < f_size_ui; ++i) {
+        const uint8_t byte_ui = uint8_t((state_ui >> 23) ^ (state_ui >> 20));
+        state_ui = ((state_ui << 8) | byte_ui) & 0x7FFFFFFFu;
+        f_data_p[i] = byte_ui;
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Continue the CRC-32 (IEEE 802.3) of a byte stream.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_crc_ui  - The CRC of the previous bytes, 0 for the first ones.
+ * \param[in] f_data_p  - The next bytes.
+ * \param[in] f_size_ui - The number of the next bytes.
+ * \return    Returns the CRC of all bytes.
+ *
+ *****************************************************************************/
+uint32_t payloadCrc32(uint32_t       f_crc_ui,
+                      const uint8_t* f_data_p,
+                      const size_t   f_size_ui)
+{
+    if (!g_crcTableReady_b)
+        payloadInitCrcTable();
+
+    uint32_t crc_ui  = ~f_crc_ui;
+    size_t   size_ui = f_size_ui;
+    while (size_ui >= 8) {
+        const uint32_t low_ui  = crc_ui ^ (uint32_t(f_data_p[0])       | (uint32_t(f_data_p[1]) << 8) |
+                                           (uint32_t(f_data_p[2]) << 16) | (uint32_t(f_data_p[3]) << 24));
+        const uint32_t high_ui = uint32_t(f_data_p[4])       | (uint32_t(f_data_p[5]) << 8) |
+                                 (uint32_t(f_data_p[6]) << 16) | (uint32_t(f_data_p[7]) << 24);
+        crc_ui = g_crcTable[7][low_ui & 0xFF]          ^ g_crcTable[6][(low_ui >> 8) & 0xFF] ^
+                 g_crcTable[5][(low_ui >> 16) & 0xFF]  ^ g_crcTable[4][low_ui >> 24] ^
+                 g_crcTable[3][high_ui & 0xFF]         ^ g_crcTable[2][(high_ui >> 8) & 0xFF] ^
+                 g_crcTable[1][(high_ui >> 16) & 0xFF] ^ g_crcTable[0][high_ui >> 24];
+        f_data_p += 8;
+        size_ui  -= 8;
+    }
+    while (size_ui-- > 0)
+        crc_ui = (crc_ui >> 8) ^ g_crcTable[0][(crc_ui ^ *f_data_p++) & 0xFF];
+    return ~crc_ui;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Compare a received payload with the expected one.
+ *
+ *            The full payload is compared with memcmp(), which uses the
+ *            vector instructions of the host. Only if it differs, the first
+ *            mismatch is located eight bytes at a time.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_expected_p - The expected payload.
+ * \param[in] f_received_p - The received payload.
+ * \param[in] f_size_ui    - The size of the payloads in bytes.
+ * \return    Returns the offset of the first mismatch, or -1 if the payloads
+ *            are equal.
+ *
+ *****************************************************************************/
+int64_t payloadFirstMismatch(const uint8_t* f_expected_p,
+                             const uint8_t* f_received_p,
+                             const uint32_t f_size_ui)
+{
+    if (memcmp(f_expected_p, f_received_p, f_size_ui) == 0)
+        return -1;
+
+    uint32_t offset_ui = 0;
+    for (; offset_ui + 8 <= f_size_ui; offset_ui += 8) {
+        uint64_t expected_ui, received_ui;
+        memcpy(&expected_ui, f_expected_p + offset_ui, 8);
+        memcpy(&received_ui, f_received_p + offset_ui, 8);
+        if (expected_ui != received_ui)
+            break;
+    }
+    for (; offset_ui < f_size_ui; ++offset_ui)
+        if (f_expected_p[offset_ui] != f_received_p[offset_ui])
+            return int64_t(offset_ui);
+    return -1;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Write a payload and read its echo.
+ *
+ *            The serial port must be switched by enableSerialPolling().
+ *            The payload is written while the echo is read, so payloads
+ *            larger than the buffers of the driver do not overflow them. The
+ *            echo is reassembled from the partial reads and only verified
+ *            after the transfer, so the timing is not affected. A
+ *            transfer stops when the echo is complete or after the timeout
+ *            without data; then fr_transfer.received_ui is less than the
+ *            payload size.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  f_serialPortHandle_i - The serial port handle.
+ * \param[in]  f_writeBuffer_p      - The payload.
+ * \param[out] f_readBuffer_p       - The echo.
+ * \param[in]  f_size_ui            - The size of the payload in bytes.
+ * \param[in]  f_timeoutMs_ui       - The maximum time without data in ms.
+ * \param[out] fr_transfer          - The timestamps and statistics.
+ * \return    Returns \c true on success or timeout, \c false on an I/O error.
+ *
+ *****************************************************************************/
+bool payloadTransfer(const int        f_serialPortHandle_i,
+                     const uint8_t*   f_writeBuffer_p,
+                     uint8_t*         f_readBuffer_p,
+                     const uint32_t   f_size_ui,
+                     const uint32_t   f_timeoutMs_ui,
+                     PayloadTransfer& fr_transfer)
+{
+    uint32_t written_ui = 0;
+    fr_transfer.numReads_ui    = 0;
+    fr_transfer.received_ui    = 0;
+    fr_transfer.firstByteNs_ui = 0;
+    fr_transfer.startNs_ui     = getTimeStampNs();
+    fr_transfer.endNs_ui       = fr_transfer.startNs_ui;
+
+    while (fr_transfer.received_ui < f_size_ui) {
+        if (written_ui < f_size_ui) {
+            const ssize_t result_i = write(f_serialPortHandle_i, f_writeBuffer_p + written_ui,
+                                           f_size_ui - written_ui);
+            if (result_i > 0)
+                written_ui += uint32_t(result_i);
+            else if ((result_i < 0) && (errno != EAGAIN) && (errno != EINTR))
+                return false;
+        }
+
+        const ssize_t result_i = read(f_serialPortHandle_i, f_readBuffer_p + fr_transfer.received_ui,
+                                      f_size_ui - fr_transfer.received_ui);
+        if (result_i > 0) {
+            const uint64_t nowNs_ui = getTimeStampNs();
+            if (fr_transfer.numReads_ui++ == 0)
+                fr_transfer.firstByteNs_ui = nowNs_ui;
+            fr_transfer.endNs_ui = nowNs_ui;
+            fr_transfer.received_ui += uint32_t(result_i);
+            continue;
+        }
+        if ((result_i < 0) && (errno != EAGAIN) && (errno != EINTR))
+            return false;
+
+        struct pollfd pollFd;
+        pollFd.fd      = f_serialPortHandle_i;
+        pollFd.events  = POLLIN | ((written_ui < f_size_ui) ? POLLOUT : 0);
+        pollFd.revents = 0;
+        const int ready_i = poll(&pollFd, 1, int(f_timeoutMs_ui));
+        if (ready_i == 0)
+            break;
+        if ((ready_i < 0) && (errno != EINTR))
+            return false;
+        if (pollFd.revents & (POLLERR | POLLHUP | POLLNVAL))
+            return false;
+    }
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Parse a comma separated list of payload sizes.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  f_list_p - The list, e.g. "1,64,4096".
+ * \param[out] fr_sizes - The sizes in bytes.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool payloadParseSizes(const char*            f_list_p,
+                       std::vector<uint32_t>& fr_sizes)
+{
+    fr_sizes.clear();
+    const char* text_p = f_list_p;
+    while (*text_p != '\0') {
+        char* end_p = NULL;
+        const long size_i = strtol(text_p, &end_p, 10);
+        if ((end_p == text_p) || ((*end_p != ',') && (*end_p != '\0')) ||
+            (size_i < 1) || (size_i > PAYLOAD_MAX_SIZE)) {
+            printf("Error: Invalid payload size list '%s', expected sizes from 1 to %d bytes!\n",
+                   f_list_p, PAYLOAD_MAX_SIZE);
+            return false;
+        }
+        fr_sizes.push_back(uint32_t(size_i));
+        text_p = (*end_p == ',') ? end_p + 1 : end_p;
+    }
+    if (fr_sizes.empty()) {
+        printf("Error: Empty payload size list!\n");
+        return false;
+    }
+    return true;
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
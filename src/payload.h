@@ -0,0 +1,79 @@
+/* ********************************* FILE ************************************/
+/** \file    payload.h
+ *
+ * \brief    This file describes the payloads of the serial transfer tests.
+ *
+ *           A payload is filled with a structured pattern, either a 16 bit
+ *           sequence counter or a PRBS-31 sequence, both seeded with the loop
+ *           number, so dropped, repeated, reordered and corrupted bytes of the
+ *           echo are detected. A transfer writes the payload and reassembles
+ *           the echo from partial reads; the CRC-32 of the echo is computed
+ *           chunk by chunk while waiting for the next bytes. The echo is then
+ *           compared in full with memcmp() (vectorized by the C library) and
+ *           the first mismatch is located word by word.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef PAYLOAD_H
+#define PAYLOAD_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Patterns of the payload
+enum PayloadPattern_t {
+  PAYLOAD_PATTERN_SEQUENCE,  ///< 16 bit little endian counter starting at the seed
+  PAYLOAD_PATTERN_PRBS       ///< PRBS-31 (x^31 + x^28 + 1) seeded by the seed
+};
+
+
+/// Timestamps and statistics of one transfer
+struct PayloadTransfer {
+  uint64_t startNs_ui;      ///< Before the first write
+  uint64_t firstByteNs_ui;  ///< After the read of the first byte of the echo
+  uint64_t endNs_ui;        ///< After the read of the last byte of the echo
+  uint32_t numReads_ui;     ///< Number of reads returning data
+  uint32_t received_ui;     ///< Number of bytes received
+};
+
+
+/*****************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+void     payloadFill(const PayloadPattern_t f_pattern_e,
+                     const uint32_t         f_seed_ui,
+                     uint8_t*               f_data_p,
+                     const uint32_t         f_size_ui);
+uint32_t payloadCrc32(uint32_t       f_crc_ui,
+                      const uint8_t* f_data_p,
+                      const size_t   f_size_ui);
+int64_t  payloadFirstMismatch(const uint8_t* f_expected_p,
+                              const uint8_t* f_received_p,
+                              const uint32_t f_size_ui);
+bool     payloadTransfer(const int        f_serialPortHandle_i,
+                         const uint8_t*   f_writeBuffer_p,
+                         uint8_t*         f_readBuffer_p,
+                         const uint32_t   f_size_ui,
+                         const uint32_t   f_timeoutMs_ui,
+                         PayloadTransfer& fr_transfer);
+bool     payloadParseSizes(const char*            f_list_p,
+                           std::vector<uint32_t>& fr_sizes);
+
+#endif /* PAYLOAD_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,471 @@
+/* ********************************* FILE ************************************/
+/** \file    resultsStore.cpp
+ *
+ * \brief    This file describes the compact archive of measured time series.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "resultsStore.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Header of the archive file
+struct ResultsStoreHeader {
+  char     magic[8];          ///< RESULTS_STORE_MAGIC
+  uint32_t version_ui;        ///< RESULTS_STORE_VERSION
+  uint32_t numRuns_ui;        ///< Number of runs in the index
+  uint64_t dataSize_ui;       ///< Size of the data section following the header
+  uint64_t indexSize_ui;      ///< Size of the index following the data section
+};
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// Percentiles precomputed for each series (0 = minimum, 100 = maximum)
+static const double g_resultsSummaryPercentiles_d[RESULTS_NUM_SUMMARY] = {
+  0.0, 10.0, 25.0, 50.0, 75.0, 90.0, 99.0, 99.9, 100.0
+};
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Append an unsigned varint (LEB128) to a buffer.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_buffer - The buffer.
+ * \param[in]     f_value_ui - The value.
+ *
+ *****************************************************************************/
+static inline void putVarint(std::vector<uint8_t>& fr_buffer,
+                             uint64_t              f_value_ui)
+{
+    while (f_value_ui >= 0x80) {
+        fr_buffer.push_back(uint8_t(f_value_ui) | 0x80);
+        f_value_ui >>= 7;
+    }
+    fr_buffer.push_back(uint8_t(f_value_ui));
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Read an unsigned varint (LEB128) from a buffer.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_pos_p  - Position in the buffer, advanced on success.
+ * \param[in]     f_end_p   - End of the buffer.
+ * \param[out]    fr_value_ui - The value.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static inline bool getVarint(const uint8_t*& fr_pos_p,
+                             const uint8_t*  f_end_p,
+                             uint64_t&       fr_value_ui)
+{
+    uint64_t value_ui = 0;
+    for (uint32_t shift_ui = 0; (fr_pos_p < f_end_p) && (shift_ui < 64); shift_ui += 7) {
+        const uint8_t byte_ui = *fr_pos_p++;
+        value_ui |= uint64_t(byte_ui & 0x7f) << shift_ui;
+        if ((byte_ui & 0x80) == 0) {
+            fr_value_ui = value_ui;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Append a string (varint length and characters) to a buffer.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_buffer - The buffer.
+ * \param[in]     fr_string - The string.
+ *
+ *****************************************************************************/
+static void putString(std::vector<uint8_t>& fr_buffer,
+                      const std::string&    fr_string)
+{
+    putVarint(fr_buffer, fr_string.size());
+    fr_buffer.insert(fr_buffer.end(), fr_string.begin(), fr_string.end());
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Read a string from a buffer.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_pos_p  - Position in the buffer, advanced on success.
+ * \param[in]     f_end_p   - End of the buffer.
+ * \param[out]    fr_string - The string.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool getString(const uint8_t*& fr_pos_p,
+                      const uint8_t*  f_end_p,
+                      std::string&    fr_string)
+{
+    uint64_t size_ui;
+    if (!getVarint(fr_pos_p, f_end_p, size_ui) || (size_ui > uint64_t(f_end_p - fr_pos_p)))
+        return false;
+    fr_string.assign((const char*) fr_pos_p, size_ui);
+    fr_pos_p += size_ui;
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Determine percentiles of a series using the nearest rank method.
+ *
+ *            Instead of sorting the values, the ranks are selected in
+ *            ascending order with std::nth_element().
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in,out] fr_values      - The values, reordered on return.
+ * \param[in]     fr_percentiles - The percentiles (0 = minimum, 100 = maximum).
+ * \param[out]    fr_results     - The values at the percentiles or 0 if the
+ *                                 series is empty.
+ *
+ *****************************************************************************/
+void resultsPercentiles(std::vector<int64_t>&      fr_values,
+                        const std::vector<double>& fr_percentiles,
+                        std::vector<int64_t>&      fr_results)
+{
+    fr_results.assign(fr_percentiles.size(), 0);
+    if (fr_values.empty())
+        return;
+
+    std::vector<std::pair<size_t, size_t> > ranks;
+    for (size_t i = 0; i < fr_percentiles.size(); ++i) {
+        size_t rank_ui = 0;
+        if (fr_percentiles[i] > 0.0)
+            rank_ui = size_t(ceil(fr_percentiles[i] / 100.0 * double(fr_values.size()))) - 1;
+        ranks.push_back(std::make_pair(std::min(rank_ui, fr_values.size() - 1), i));
+    }
+    std::sort(ranks.begin(), ranks.end());
+
+    size_t first_ui = 0;
+    for (size_t i = 0; i < ranks.size(); ++i) {
+        if (ranks[i].first >= first_ui) {
+            std::nth_element(fr_values.begin() + first_ui, fr_values.begin() + ranks[i].first, fr_values.end());
+            first_ui = ranks[i].first + 1;
+        }
+        fr_results[ranks[i].second] = fr_values[ranks[i].first];
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the percentiles of the summary of each series.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns the RESULTS_NUM_SUMMARY percentiles.
+ *
+ *****************************************************************************/
+const double* ResultsStore::summaryPercentiles()
+{
+    return g_resultsSummaryPercentiles_d;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Load the archive. A missing file gives an empty archive.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_fileName - The file name.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool ResultsStore::load(const std::string& fr_fileName)
+{
+    m_data.clear();
+    m_runs.clear();
+
+    FILE* file_p = fopen(fr_fileName.c_str(), "rb");
+    if (!file_p)
+        return true;
+
+    ResultsStoreHeader header;
+    if ((fread(&header, sizeof(header), 1, file_p) != 1) ||
+        (memcmp(header.magic, RESULTS_STORE_MAGIC, sizeof(RESULTS_STORE_MAGIC)) != 0) ||
+        (header.version_ui != RESULTS_STORE_VERSION)) {
+        printf("Error: %s is not a results store of version %d!\n", fr_fileName.c_str(), RESULTS_STORE_VERSION);
+        fclose(file_p);
+        return false;
+    }
+
+    // Check the sizes against the file before allocating anything
+    long fileSize_i = -1;
+    if (fseek(file_p, 0, SEEK_END) == 0)
+        fileSize_i = ftell(file_p);
+    const uint64_t available_ui = (fileSize_i >= long(sizeof(header))) ? uint64_t(fileSize_i) - sizeof(header) : 0;
+    if ((fileSize_i < 0) || (fseek(file_p, sizeof(header), SEEK_SET) != 0) ||
+        (header.dataSize_ui > available_ui) ||
+        (header.indexSize_ui > available_ui - header.dataSize_ui)) {
+        printf("Error: Results store %s is truncated!\n", fr_fileName.c_str());
+        fclose(file_p);
+        return false;
+    }
+
+    std::vector<uint8_t> index(header.indexSize_ui);
+    m_data.resize(header.dataSize_ui);
+    if (((header.dataSize_ui > 0) && (fread(&m_data[0], header.dataSize_ui, 1, file_p) != 1)) ||
+        ((header.indexSize_ui > 0) && (fread(&index[0], header.indexSize_ui, 1, file_p) != 1))) {
+        printf("Error: Results store %s is truncated!\n", fr_fileName.c_str());
+        fclose(file_p);
+        m_data.clear();
+        return false;
+    }
+    fclose(file_p);
+
+    const uint8_t* pos_p = index.empty() ? NULL : &index[0];
+    const uint8_t* end_p = pos_p + index.size();
+
+    // A run takes at least the two bytes of its numbers of keys and series
+    bool ok_b = (header.numRuns_ui <= index.size() / 2);
+    if (ok_b)
+        m_runs.resize(header.numRuns_ui);
+    for (uint32_t r = 0; ok_b && (r < header.numRuns_ui); ++r) {
+        StoredRun& run = m_runs[r];
+        uint64_t numKeys_ui = 0, numSeries_ui = 0;
+
+        ok_b = getVarint(pos_p, end_p, numKeys_ui);
+        for (uint64_t k = 0; ok_b && (k < numKeys_ui); ++k) {
+            std::string key, value;
+            ok_b = getString(pos_p, end_p, key) && getString(pos_p, end_p, value);
+            run.metadata[key] = value;
+        }
+
+        ok_b = ok_b && getVarint(pos_p, end_p, numSeries_ui);
+        for (uint64_t s = 0; ok_b && (s < numSeries_ui); ++s) {
+            StoredSeries series;
+            ok_b = getString(pos_p, end_p, series.name) &&
+                   getVarint(pos_p, end_p, series.count_ui) &&
+                   getVarint(pos_p, end_p, series.offset_ui) &&
+                   getVarint(pos_p, end_p, series.size_ui);
+            for (uint32_t i = 0; ok_b && (i < RESULTS_NUM_SUMMARY); ++i) {
+                uint64_t zigzag_ui;
+                ok_b = getVarint(pos_p, end_p, zigzag_ui);
+                if (ok_b)
+                    series.summaryNs_i[i] = int64_t(zigzag_ui >> 1) ^ -int64_t(zigzag_ui & 1);
+            }
+            // Each value takes at least one byte of the column
+            ok_b = ok_b && (series.count_ui <= series.size_ui) &&
+                   (series.offset_ui <= m_data.size()) &&
+                   (series.size_ui <= m_data.size() - series.offset_ui);
+            run.series.push_back(series);
+        }
+    }
+
+    if (!ok_b) {
+        printf("Error: Corrupt index in results store %s!\n", fr_fileName.c_str());
+        m_data.clear();
+        m_runs.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Save the archive. Columns of replaced runs are dropped.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_fileName - The file name.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool ResultsStore::save(const std::string& fr_fileName) const
+{
+    std::vector<uint8_t> data, index;
+
+    for (size_t r = 0; r < m_runs.size(); ++r) {
+        const StoredRun& run = m_runs[r];
+
+        putVarint(index, run.metadata.size());
+        for (RunMetadata_t::const_iterator i = run.metadata.begin(); i != run.metadata.end(); ++i) {
+            putString(index, i->first);
+            putString(index, i->second);
+        }
+
+        putVarint(index, run.series.size());
+        for (size_t s = 0; s < run.series.size(); ++s) {
+            const StoredSeries& series = run.series[s];
+            putString(index, series.name);
+            putVarint(index, series.count_ui);
+            putVarint(index, data.size());
+            putVarint(index, series.size_ui);
+            for (uint32_t i = 0; i < RESULTS_NUM_SUMMARY; ++i)
+                putVarint(index, (uint64_t(series.summaryNs_i[i]) << 1) ^ uint64_t(series.summaryNs_i[i] >> 63));
+
+            data.insert(data.end(), m_data.begin() + series.offset_ui,
+                        m_data.begin() + series.offset_ui + series.size_ui);
+        }
+    }
+
+    ResultsStoreHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RESULTS_STORE_MAGIC, sizeof(RESULTS_STORE_MAGIC));
+    header.version_ui   = RESULTS_STORE_VERSION;
+    header.numRuns_ui   = m_runs.size();
+    header.dataSize_ui  = data.size();
+    header.indexSize_ui = index.size();
+
+    // Write to a temporary file first, so a failure keeps the old archive
+    const std::string tmpFileName = fr_fileName + ".tmp";
+    FILE* file_p = fopen(tmpFileName.c_str(), "wb");
+    if (!file_p) {
+        printf("Error: Can't create %s!\n", tmpFileName.c_str());
+        return false;
+    }
+    bool ok_b = (fwrite(&header, sizeof(header), 1, file_p) == 1);
+    if (ok_b && !data.empty())
+        ok_b = (fwrite(&data[0], data.size(), 1, file_p) == 1);
+    if (ok_b && !index.empty())
+        ok_b = (fwrite(&index[0], index.size(), 1, file_p) == 1);
+    ok_b = (fclose(file_p) == 0) && ok_b;
+
+    if (!ok_b || (rename(tmpFileName.c_str(), fr_fileName.c_str()) != 0)) {
+        printf("Error: Can't write results store %s!\n", fr_fileName.c_str());
+        remove(tmpFileName.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Add a run. A run with the same "path" is replaced.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_metadata - The metadata of the run.
+ * \param[in] fr_series   - The time series of the run in nanoseconds.
+ *
+ *****************************************************************************/
+void ResultsStore::addRun(const RunMetadata_t&                                fr_metadata,
+                          const std::map<std::string, std::vector<int64_t> >& fr_series)
+{
+    RunMetadata_t::const_iterator path = fr_metadata.find("path");
+    if (path != fr_metadata.end()) {
+        for (size_t r = 0; r < m_runs.size(); ++r) {
+            RunMetadata_t::const_iterator otherPath = m_runs[r].metadata.find("path");
+            if ((otherPath != m_runs[r].metadata.end()) && (otherPath->second == path->second)) {
+                m_runs.erase(m_runs.begin() + r);
+                break;
+            }
+        }
+    }
+
+    StoredRun run;
+    run.metadata = fr_metadata;
+
+    const std::vector<double> percentiles(g_resultsSummaryPercentiles_d,
+                                          g_resultsSummaryPercentiles_d + RESULTS_NUM_SUMMARY);
+    for (std::map<std::string, std::vector<int64_t> >::const_iterator i = fr_series.begin();
+         i != fr_series.end(); ++i) {
+        StoredSeries series;
+        series.name      = i->first;
+        series.count_ui  = i->second.size();
+        series.offset_ui = m_data.size();
+
+        int64_t previous_i = 0;
+        for (size_t j = 0; j < i->second.size(); ++j) {
+            const int64_t delta_i = i->second[j] - previous_i;
+            putVarint(m_data, (uint64_t(delta_i) << 1) ^ uint64_t(delta_i >> 63));
+            previous_i = i->second[j];
+        }
+        series.size_ui = m_data.size() - series.offset_ui;
+
+        std::vector<int64_t> values(i->second), summary;
+        resultsPercentiles(values, percentiles, summary);
+        std::copy(summary.begin(), summary.end(), series.summaryNs_i);
+
+        run.series.push_back(series);
+    }
+
+    m_runs.push_back(run);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Decode the column of a series.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_series - The series.
+ * \param[out] fr_values - The values in nanoseconds are appended to this list.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool ResultsStore::decode(const StoredSeries&   fr_series,
+                          std::vector<int64_t>& fr_values) const
+{
+    if (fr_series.count_ui == 0)
+        return true;
+
+    const uint8_t* pos_p = m_data.data() + fr_series.offset_ui;
+    const uint8_t* end_p = pos_p + fr_series.size_ui;
+    int64_t        value_i = 0;
+
+    fr_values.reserve(fr_values.size() + fr_series.count_ui);
+    for (uint64_t i = 0; i < fr_series.count_ui; ++i) {
+        uint64_t zigzag_ui;
+        if (!getVarint(pos_p, end_p, zigzag_ui)) {
+            printf("Error: Corrupt column of series %s!\n", fr_series.name.c_str());
+            return false;
+        }
+        value_i += int64_t(zigzag_ui >> 1) ^ -int64_t(zigzag_ui & 1);
+        fr_values.push_back(value_i);
+    }
+
+    return true;
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,102 @@
+/* ********************************* FILE ************************************/
+/** \file    resultsStore.h
+ *
+ * \brief    This file describes the compact archive of measured time series.
+ *
+ *           The archive is a single binary file. Each time series is stored
+ *           as a column of nanosecond values, delta encoded and written as
+ *           zigzag LEB128 varints, so a typical series needs 1-2 bytes per
+ *           sample. An index at the end of the file holds the metadata of
+ *           each run (board, kernel, driver, device, adapter, latency timer,
+ *           payload, date, ...) and per series the number of samples, the
+ *           location of the column and a summary of precomputed percentiles.
+ *           All values are stored in host byte order.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef RESULTS_STORE_H
+#define RESULTS_STORE_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <string>
+#include <map>
+#include <vector>
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+#define RESULTS_STORE_MAGIC      "LATSTOR"
+#define RESULTS_STORE_VERSION    1
+
+/// Number of precomputed percentiles per series, see summaryPercentiles()
+#define RESULTS_NUM_SUMMARY      9
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Metadata of a run, e.g. "board" -> "odroidxu4"
+typedef std::map<std::string, std::string> RunMetadata_t;
+
+/// A stored time series
+struct StoredSeries {
+  std::string name;                              ///< Name, e.g. startWrite_to_endRead
+  uint64_t    count_ui;                          ///< Number of samples
+  uint64_t    offset_ui;                         ///< Offset of the column in the data section
+  uint64_t    size_ui;                           ///< Size of the column in bytes
+  int64_t     summaryNs_i[RESULTS_NUM_SUMMARY];  ///< Precomputed percentiles in ns
+};
+
+/// A stored run, i.e., the time series of one results directory
+struct StoredRun {
+  RunMetadata_t             metadata;
+  std::vector<StoredSeries> series;
+};
+
+
+/*****************************************************************************
+ * CLASS
+ ******************************************************************************/
+/// The results archive. It is kept in memory completely.
+class ResultsStore {
+ public:
+  bool load(const std::string& fr_fileName);
+  bool save(const std::string& fr_fileName) const;
+
+  void addRun(const RunMetadata_t&                                fr_metadata,
+              const std::map<std::string, std::vector<int64_t> >& fr_series);
+
+  const std::vector<StoredRun>& runs() const { return m_runs; }
+
+  bool decode(const StoredSeries&   fr_series,
+              std::vector<int64_t>& fr_values) const;
+
+  static const double* summaryPercentiles();
+
+ private:
+  std::vector<uint8_t>   m_data;
+  std::vector<StoredRun> m_runs;
+};
+
+
+/*****************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+void resultsPercentiles(std::vector<int64_t>&      fr_values,
+                        const std::vector<double>& fr_percentiles,
+                        std::vector<int64_t>&      fr_results);
+
+#endif /* RESULTS_STORE_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
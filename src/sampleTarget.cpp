@@ -0,0 +1,374 @@
+/* ********************************* FILE ************************************/
+/** \file    sampleTarget.cpp
+ *
+ * \brief    This file describes the adaptive sample size of the tests.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "sampleTarget.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+/// Minimum time between two convergence checks
+#define SAMPLE_TARGET_CHECK_NS   250000000ULL
+
+/// Maximum number of loops of a test with adaptive sample size
+#define SAMPLE_TARGET_MAX_LOOPS  10000000U
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+static bool                g_sampleTargetEnabled_b    = false;
+static bool                g_sampleTargetRelative_b   = true;
+static double              g_sampleTargetWidth_d      = 0.0;  ///< Fraction or nanoseconds
+static std::vector<double> g_sampleTargetPercentiles;
+static double              g_sampleTargetConfidence_d = 95.0;
+static double              g_sampleTargetZ_d          = 1.96;
+static uint64_t            g_sampleTargetBudgetNs_ui  = 0;
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the current time of the CLOCK_MONOTONIC clock in nanoseconds.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns the current time in nanoseconds.
+ *
+ *****************************************************************************/
+static uint64_t sampleTargetNowNs()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return uint64_t(t.tv_sec) * 1000000000ULL + uint64_t(t.tv_nsec);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Enable the adaptive sample size for all tests.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_targetWidth         - Target width of the confidence
+ *                                     intervals, either relative to the
+ *                                     percentile (e.g. "2%") or in
+ *                                     milliseconds (e.g. "0.05").
+ * \param[in] fr_percentiles         - The percentiles which have to converge.
+ * \param[in] f_confidence_d         - Confidence level in percent.
+ * \param[in] f_timeBudgetS_d        - Maximum duration of each test in seconds.
+ * \param[in] f_significantDigits_ui - Significant digits of the histograms.
+ * \return    Returns \c true on success, \c false on invalid settings.
+ *
+ *****************************************************************************/
+bool sampleTargetConfigure(const std::string&         fr_targetWidth,
+                           const std::vector<double>& fr_percentiles,
+                           const double               f_confidence_d,
+                           const double               f_timeBudgetS_d,
+                           const uint32_t             f_significantDigits_ui)
+{
+    char* end_p = NULL;
+    const double width_d = strtod(fr_targetWidth.c_str(), &end_p);
+    g_sampleTargetRelative_b = (*end_p == '%');
+    if ((end_p == fr_targetWidth.c_str()) || (width_d <= 0.0) || (*end_p && !g_sampleTargetRelative_b)) {
+        printf("Error: Invalid target width %s of the confidence intervals!\n", fr_targetWidth.c_str());
+        return false;
+    }
+    g_sampleTargetWidth_d = g_sampleTargetRelative_b ? width_d / 100.0 : width_d * 1000000.0;
+
+    if (fr_percentiles.empty()) {
+        printf("Error: No percentiles given for the target confidence intervals!\n");
+        return false;
+    }
+    for (size_t i = 0; i < fr_percentiles.size(); ++i) {
+        if ((fr_percentiles[i] <= 0.0) || (fr_percentiles[i] >= 100.0)) {
+            printf("Error: The percentiles of the target must be between 0 and 100!\n");
+            return false;
+        }
+    }
+    if ((f_confidence_d <= 0.0) || (f_confidence_d >= 100.0) || (f_timeBudgetS_d <= 0.0)) {
+        printf("Error: The confidence level must be between 0 and 100%% and the time budget positive!\n");
+        return false;
+    }
+
+    // The HDR histograms resolve about one part in 10^digits of a value
+    if (g_sampleTargetRelative_b && (g_sampleTargetWidth_d < 2.0 * pow(10.0, -double(f_significantDigits_ui))))
+        printf("Warning: The target width %s is close to the resolution of the histograms (%d digits).\n",
+               fr_targetWidth.c_str(), f_significantDigits_ui);
+
+    // Quantile of the standard normal distribution by bisection
+    const double tail_d = (1.0 - f_confidence_d / 100.0) / 2.0;
+    double low_d = 0.0, high_d = 10.0;
+    for (uint32_t i = 0; i < 100; ++i) {
+        const double z_d = (low_d + high_d) / 2.0;
+        if (0.5 * erfc(z_d / sqrt(2.0)) > tail_d)
+            low_d = z_d;
+        else
+            high_d = z_d;
+    }
+
+    g_sampleTargetEnabled_b    = true;
+    g_sampleTargetPercentiles  = fr_percentiles;
+    g_sampleTargetConfidence_d = f_confidence_d;
+    g_sampleTargetZ_d          = (low_d + high_d) / 2.0;
+    g_sampleTargetBudgetNs_ui  = uint64_t(f_timeBudgetS_d * 1.0e9);
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if the adaptive sample size is enabled.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns \c true if sampleTargetConfigure() was successful.
+ *
+ *****************************************************************************/
+bool sampleTargetEnabled()
+{
+    return g_sampleTargetEnabled_b;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the number of loops of a test.
+ *
+ *            With adaptive sample size, the test is stopped by
+ *            SampleTarget::done(), at the latest when the time budget is
+ *            exhausted. The number of loops is then bounded by the time
+ *            budget and the minimum duration of an iteration, so the series
+ *            of the test can reserve their samples before the loop.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_fixedNumLoops_ui - Number of loops without adaptive sample size.
+ * \param[in] f_minPeriodNs_ui   - Minimum duration of an iteration in
+ *                                 nanoseconds, e.g. its sleep time.
+ * \return    Returns the fixed number of loops or, with adaptive sample size,
+ *            the maximum number of loops within the time budget.
+ *
+ *****************************************************************************/
+uint32_t sampleTargetNumLoops(const uint32_t f_fixedNumLoops_ui,
+                              const uint64_t f_minPeriodNs_ui)
+{
+    if (!g_sampleTargetEnabled_b)
+        return f_fixedNumLoops_ui;
+    if (f_minPeriodNs_ui == 0)
+        return SAMPLE_TARGET_MAX_LOOPS;
+
+    const uint64_t numLoops_ui = g_sampleTargetBudgetNs_ui / f_minPeriodNs_ui + 1;
+    return (numLoops_ui < SAMPLE_TARGET_MAX_LOOPS) ? uint32_t(numLoops_ui) : SAMPLE_TARGET_MAX_LOOPS;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the distribution-free confidence interval of a percentile.
+ *
+ *            The number of samples below the p-th percentile is binomially
+ *            distributed, so the order statistics with the ranks
+ *            n*p -/+ z*sqrt(n*p*(1-p)) enclose the percentile with the
+ *            configured confidence (normal approximation, ranks rounded
+ *            outwards).
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_histogram   - Histogram of the samples.
+ * \param[in]  f_percentile_d - The percentile (0..100).
+ * \param[out] fr_lowNs_i     - Lower bound in nanoseconds.
+ * \param[out] fr_highNs_i    - Upper bound in nanoseconds.
+ * \return    Returns \c false if there are too few samples for an interval.
+ *
+ *****************************************************************************/
+bool percentileConfidenceInterval(const HdrHistogram& fr_histogram,
+                                  const double        f_percentile_d,
+                                  int64_t&            fr_lowNs_i,
+                                  int64_t&            fr_highNs_i)
+{
+    const double n_d      = double(fr_histogram.count());
+    const double q_d      = f_percentile_d / 100.0;
+    const double spread_d = g_sampleTargetZ_d * sqrt(n_d * q_d * (1.0 - q_d));
+    const double lowRank_d  = floor(n_d * q_d - spread_d);
+    const double highRank_d = ceil(n_d * q_d + spread_d) + 1.0;
+
+    if ((lowRank_d < 1.0) || (highRank_d > n_d))
+        return false;
+
+    fr_lowNs_i  = fr_histogram.valueAtRank(uint64_t(lowRank_d));
+    fr_highNs_i = fr_histogram.valueAtRank(uint64_t(highRank_d));
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Constructor.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_testName_p - Name of the test used in the report.
+ *
+ *****************************************************************************/
+SampleTarget::SampleTarget(const char* f_testName_p)
+  : m_testName(f_testName_p),
+    m_startNs_ui(sampleTargetNowNs()),
+    m_lastCheckNs_ui(m_startNs_ui),
+    m_converged_b(false)
+{
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Add a series which has to reach the target.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_series - The series. It must outlive this object.
+ *
+ *****************************************************************************/
+void SampleTarget::add(const LatencySeries& fr_series)
+{
+    m_series.push_back(&fr_series);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if the test can stop. Call it after each iteration.
+ *
+ *            The intervals are checked at most every 250 ms. Each check
+ *            walks the histograms once per bound, independent of the number
+ *            of samples.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns \c true if the target is reached or the time budget is
+ *            exhausted. Without adaptive sample size, it returns \c false.
+ *
+ *****************************************************************************/
+bool SampleTarget::done()
+{
+    if (!g_sampleTargetEnabled_b)
+        return false;
+
+    const uint64_t nowNs_ui = sampleTargetNowNs();
+    if (nowNs_ui - m_lastCheckNs_ui < SAMPLE_TARGET_CHECK_NS)
+        return false;
+    m_lastCheckNs_ui = nowNs_ui;
+
+    if (converged(false)) {
+        m_converged_b = true;
+        return true;
+    }
+    return (nowNs_ui - m_startNs_ui >= g_sampleTargetBudgetNs_ui);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check the confidence intervals of all series.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_print_b - If \c true, print the interval of each percentile.
+ * \return    Returns \c true if all intervals are narrower than the target.
+ *
+ *****************************************************************************/
+bool SampleTarget::converged(const bool f_print_b) const
+{
+    bool converged_b = true;
+
+    for (size_t s = 0; s < m_series.size(); ++s) {
+        const HdrHistogram& histogram = m_series[s]->histogram();
+
+        for (size_t p = 0; p < g_sampleTargetPercentiles.size(); ++p) {
+            const double percentile_d = g_sampleTargetPercentiles[p];
+            int64_t lowNs_i, highNs_i;
+
+            if (!percentileConfidenceInterval(histogram, percentile_d, lowNs_i, highNs_i)) {
+                if (f_print_b)
+                    printf("  %s p%g: too few samples (%llu)\n", m_series[s]->name().c_str(), percentile_d,
+                           (unsigned long long)histogram.count());
+                converged_b = false;
+                if (!f_print_b)
+                    return false;
+                continue;
+            }
+
+            const double widthNs_d  = double(highNs_i - lowNs_i);
+            const double targetNs_d = g_sampleTargetRelative_b ?
+                                      g_sampleTargetWidth_d * fabs(double(histogram.percentile(percentile_d))) :
+                                      g_sampleTargetWidth_d;
+            const bool   reached_b  = (widthNs_d <= targetNs_d);
+
+            if (f_print_b)
+                printf("  %s p%g: [%.4f ms, %.4f ms], width %.4f ms (target %.4f ms)%s\n",
+                       m_series[s]->name().c_str(), percentile_d, double(lowNs_i) / 1000000.0,
+                       double(highNs_i) / 1000000.0, widthNs_d / 1000000.0, targetNs_d / 1000000.0,
+                       reached_b ? "" : " - not reached");
+            if (!reached_b) {
+                converged_b = false;
+                if (!f_print_b)
+                    return false;
+            }
+        }
+    }
+
+    return converged_b;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Print why the test stopped and the final intervals.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void SampleTarget::report() const
+{
+    if (!g_sampleTargetEnabled_b)
+        return;
+
+    const double elapsedS_d = double(sampleTargetNowNs() - m_startNs_ui) / 1.0e9;
+    if (m_converged_b)
+        printf("Info: %s reached the target %g%% confidence intervals after %.1f s:\n",
+               m_testName.c_str(), g_sampleTargetConfidence_d, elapsedS_d);
+    else
+        printf("Warning: %s exhausted its time budget (%.1f s) before reaching the target %g%% confidence intervals:\n",
+               m_testName.c_str(), elapsedS_d, g_sampleTargetConfidence_d);
+    converged(true);
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,79 @@
+/* ********************************* FILE ************************************/
+/** \file    sampleTarget.h
+ *
+ * \brief    This file describes the adaptive sample size of the tests.
+ *
+ *           Instead of a fixed number of loops, a test keeps sampling until
+ *           the confidence intervals of the chosen percentiles of all its
+ *           series are narrower than a target width, or until the time budget
+ *           is exhausted. The distribution-free interval of a percentile is
+ *           given by two order statistics whose ranks follow from the
+ *           binomial distribution of the number of samples below the
+ *           percentile. The order statistics are read from the HDR
+ *           histograms of the series, so a check does not sort the samples.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef SAMPLE_TARGET_H
+#define SAMPLE_TARGET_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "latencySeries.h"
+
+
+/*****************************************************************************
+ * CLASS
+ ******************************************************************************/
+/// The stop criterion of a test with adaptive sample size.
+class SampleTarget {
+ public:
+  SampleTarget(const char* f_testName_p);
+
+  void     add(const LatencySeries& fr_series);
+  bool     done();
+  void     report() const;
+
+ private:
+  bool     converged(const bool f_print_b) const;
+
+  std::string                        m_testName;
+  std::vector<const LatencySeries*>  m_series;
+  uint64_t                           m_startNs_ui;
+  uint64_t                           m_lastCheckNs_ui;
+  bool                               m_converged_b;
+};
+
+
+/*****************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+bool sampleTargetConfigure(const std::string&         fr_targetWidth,
+                           const std::vector<double>& fr_percentiles,
+                           const double               f_confidence_d,
+                           const double               f_timeBudgetS_d,
+                           const uint32_t             f_significantDigits_ui);
+bool sampleTargetEnabled();
+uint32_t sampleTargetNumLoops(const uint32_t f_fixedNumLoops_ui,
+                              const uint64_t f_minPeriodNs_ui);
+
+bool percentileConfidenceInterval(const HdrHistogram& fr_histogram,
+                                  const double        f_percentile_d,
+                                  int64_t&            fr_lowNs_i,
+                                  int64_t&            fr_highNs_i);
+
+#endif /* SAMPLE_TARGET_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,393 @@
+/* ********************************* FILE ************************************/
+/** \file    serialTiming.cpp
+ *
+ * \brief    This file describes the timestamps, the serial port access and
+ *           the sysfs interface of the gpiotiming kernel module shared by
+ *           latencyTest and the latency probe library.
+ *
+ * \author   Clemens Rabe
+ * \date     Apr 06, 2019
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "serialTiming.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// A baud rate and its terminal speed
+struct SerialBaudRate {
+  uint32_t baudRate_ui;
+  speed_t  speed;
+};
+
+/// The baud rates supported by initializeSerialPort()
+static const SerialBaudRate g_serialBaudRates[] = {
+  {    9600, B9600    }, {   19200, B19200   }, {   38400, B38400   },
+  {   57600, B57600   }, {  115200, B115200  }, {  230400, B230400  },
+  {  460800, B460800  }, {  500000, B500000  }, {  576000, B576000  },
+  {  921600, B921600  }, { 1000000, B1000000 }, { 1152000, B1152000 },
+  { 1500000, B1500000 }, { 2000000, B2000000 }, { 2500000, B2500000 },
+  { 3000000, B3000000 }, { 3500000, B3500000 }, { 4000000, B4000000 }
+};
+
+/// Number of the supported baud rates
+static const uint32_t g_numSerialBaudRates_ui = sizeof(g_serialBaudRates) / sizeof(g_serialBaudRates[0]);
+
+
+int32_t getSysfsCounter(const std::string& fr_fileName) {
+  int32_t counter_i = -1;
+  FILE* file_p = fopen(fr_fileName.c_str(), "r");
+  if (file_p) {
+    if (fscanf(file_p, "%d", &counter_i) != 1) {
+      counter_i = -1;
+    }
+    fclose(file_p);
+  }
+  return counter_i;
+}
+
+uint64_t getSysfsTimestamp(const std::string& fr_fileName) {
+  uint64_t timestamp_ui = 0;
+  FILE* file_p = fopen(fr_fileName.c_str(), "r");
+  if (file_p) {
+    if (fscanf(file_p, "%llu", &timestamp_ui) != 1) {
+      timestamp_ui = 0;
+    }
+    fclose(file_p);
+  }
+  return timestamp_ui;
+}
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the terminal speed of a baud rate.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  f_baudRate_ui - The baud rate.
+ * \param[out] fr_speed      - The terminal speed.
+ * \return    Returns \c true if the baud rate is supported, otherwise \c false.
+ *
+ *****************************************************************************/
+static bool serialSpeed(const uint32_t f_baudRate_ui, speed_t& fr_speed)
+{
+    for (uint32_t i = 0; i < g_numSerialBaudRates_ui; ++i) {
+        if (g_serialBaudRates[i].baudRate_ui == f_baudRate_ui) {
+            fr_speed = g_serialBaudRates[i].speed;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Check if initializeSerialPort() supports a baud rate.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_baudRate_ui - The baud rate.
+ * \return    Returns \c true if the baud rate is supported, otherwise \c false.
+ *
+ *****************************************************************************/
+bool serialBaudRateSupported(const uint32_t f_baudRate_ui)
+{
+    speed_t speed;
+    return serialSpeed(f_baudRate_ui, speed);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Initialize the serial port.
+ *
+ * \author    Clemens Rabe
+ * \date      Apr 06, 2019
+ *
+ * \param[in] f_serialPortHandle_i - The serial port handle.
+ * \param[in] f_numBytes_ui        - Minimum number of bytes of a read.
+ * \param[in] f_baudRate_ui        - The baud rate.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool initializeSerialPort(int f_serialPortHandle_i, const uint32_t f_numBytes_ui,
+                          const uint32_t f_baudRate_ui)
+{
+    speed_t speed;
+    if (!serialSpeed(f_baudRate_ui, speed)) {
+        printf("Error: Unsupported baud rate %u!\n", f_baudRate_ui);
+        return false;
+    }
+
+    struct termios newtio;
+    memset( &newtio, 0, sizeof( newtio ) );
+
+    // No processing
+    cfmakeraw( &newtio );
+
+    cfsetspeed( &newtio, speed );
+
+    // Ignore control lines
+    newtio.c_cflag |= CLOCAL;
+    newtio.c_cflag &= ~CRTSCTS;
+
+    // set to 8N1
+    newtio.c_cflag &= ~( PARENB | PARODD );
+    newtio.c_cflag &= ~CSTOPB;
+    newtio.c_cflag &= ~CSIZE;
+    newtio.c_cflag |= CS8;
+
+    // Enable read
+    newtio.c_cflag |= CREAD;
+
+    // Input flags (ignore parity errors)
+    newtio.c_iflag = IGNPAR;
+
+    // Raw output
+    newtio.c_oflag = 0;
+
+    // Disable canonical input
+    newtio.c_lflag = 0;
+
+    // Read parameters (block read until 1 character arrives)
+    newtio.c_cc[VTIME]    = 0;     /* inter-character timer unused */
+    newtio.c_cc[VMIN]     = (f_numBytes_ui < 255) ? f_numBytes_ui : 255;  /* blocking read until the payload (at most 255 characters) arrives */
+
+    if ( tcsetattr( f_serialPortHandle_i, TCSANOW, &newtio ) != 0 )
+    {
+        printf("Error: Can't setup serial port!\n");
+        return false;
+    }
+
+    // Set serial port to blocking mode again. This is required, since
+    // a blocking open() may block until a carrier is present, depending
+    // on the serial port configuration. To be sure, we open with non-blocking
+    // and reset to blocking here.
+    int flags_i = fcntl( f_serialPortHandle_i, F_GETFL );
+    flags_i    &= ~O_NONBLOCK;
+
+    if ( fcntl( f_serialPortHandle_i, F_SETFL, flags_i ) < 0 )
+    {
+        printf("Error: Can't disable non-blocking mode of the serial port!\n");
+        return false;
+    }
+
+    // Remove any content waiting on the serial port
+    tcflush(f_serialPortHandle_i, TCIOFLUSH);
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Switch the serial port to non-blocking reads for poll().
+ *
+ *            The terminal driver signals POLLIN only when VMIN characters are
+ *            available, so VMIN is set to one as well. Otherwise a payload
+ *            size given by --size would hide smaller responses from poll().
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  f_serialPortHandle_i - The serial port handle.
+ * \param[out] fr_savedMode         - The previous mode for restoreSerialMode().
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool enableSerialPolling(int f_serialPortHandle_i, SerialPortMode& fr_savedMode)
+{
+    struct termios tio;
+    fr_savedMode.flags_i = fcntl(f_serialPortHandle_i, F_GETFL);
+    if ((fr_savedMode.flags_i < 0) || (tcgetattr(f_serialPortHandle_i, &tio) != 0)) {
+        printf("Error: Can't get the mode of the serial port!\n");
+        return false;
+    }
+    fr_savedMode.minChars_ui = tio.c_cc[VMIN];
+
+    tio.c_cc[VMIN] = 1;
+    if ((tcsetattr(f_serialPortHandle_i, TCSANOW, &tio) != 0) ||
+        (fcntl(f_serialPortHandle_i, F_SETFL, fr_savedMode.flags_i | O_NONBLOCK) < 0)) {
+        printf("Error: Can't enable non-blocking mode of the serial port!\n");
+        restoreSerialMode(f_serialPortHandle_i, fr_savedMode);
+        return false;
+    }
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Restore the mode of the serial port saved by
+ *            enableSerialPolling().
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_serialPortHandle_i - The serial port handle.
+ * \param[in] fr_savedMode         - The saved mode.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool restoreSerialMode(int f_serialPortHandle_i, const SerialPortMode& fr_savedMode)
+{
+    bool ok_b = true;
+    struct termios tio;
+    if (tcgetattr(f_serialPortHandle_i, &tio) == 0) {
+        tio.c_cc[VMIN] = fr_savedMode.minChars_ui;
+        ok_b = (tcsetattr(f_serialPortHandle_i, TCSANOW, &tio) == 0);
+    } else {
+        ok_b = false;
+    }
+    if (fcntl(f_serialPortHandle_i, F_SETFL, fr_savedMode.flags_i) < 0)
+        ok_b = false;
+
+    if (!ok_b)
+        printf("Error: Can't disable non-blocking mode of the serial port!\n");
+    return ok_b;
+}
+
+
+bool writeChars(int f_serialPortHandle_i,
+                const uint32_t f_numChars_ui,
+                const uint8_t* f_chars_p)
+{
+    const ssize_t written_i = write(f_serialPortHandle_i, f_chars_p, f_numChars_ui);
+    return (written_i == f_numChars_ui);
+}
+
+bool readChars(int f_serialPortHandle_i,
+               const uint32_t f_numChars_ui,
+               uint8_t* f_chars_p)
+{
+    // VMIN is limited to 255 bytes, so larger transfers arrive in parts
+    uint32_t received_ui = 0;
+    while (received_ui < f_numChars_ui) {
+        const ssize_t read_i = read(f_serialPortHandle_i, f_chars_p + received_ui,
+                                    f_numChars_ui - received_ui);
+        if (read_i <= 0)
+            return false;
+        received_ui += uint32_t(read_i);
+    }
+    return true;
+}
+
+bool writeChar(int f_serialPortHandle_i,
+               const uint8_t f_char_ui)
+{
+    const ssize_t written_i = write(f_serialPortHandle_i, &f_char_ui, 1);
+    return (written_i == 1);
+}
+
+
+bool readChar(int f_serialPortHandle_i,
+              uint8_t& fr_char_ui)
+{
+    const ssize_t read_i = read(f_serialPortHandle_i, &fr_char_ui, 1);
+    return (read_i == 1);
+}
+
+uint64_t getTimeStampNs()
+{
+    struct timespec t;
+    RECORD_TIME(t);
+    return GET_NANOSECONDS(t);
+}
+
+
+float getMilliseconds(const uint64_t f_startNs_ui,
+                      const uint64_t f_endNs_ui)
+{
+  if (f_endNs_ui > f_startNs_ui) {
+    const uint64_t diffNs_ui = f_endNs_ui - f_startNs_ui;
+    return float(diffNs_ui) / 1000000.0f;
+  } else {
+    const uint64_t diffNs_ui = f_startNs_ui - f_endNs_ui;
+    return float(diffNs_ui) / -1000000.0f;
+  }
+}
+
+
+float getMilliseconds(struct timespec& fr_startNs_ui,
+                      struct timespec& fr_endNs_ui)
+{
+  const uint64_t startNs_ui = GET_NANOSECONDS(fr_startNs_ui);
+  const uint64_t endNs_ui   = GET_NANOSECONDS(fr_endNs_ui);
+
+  if (endNs_ui > startNs_ui) {
+    const uint64_t diffNs_ui = endNs_ui - startNs_ui;
+    return float(diffNs_ui) / 1000000.0f;
+  } else {
+    const uint64_t diffNs_ui = startNs_ui - endNs_ui;
+    return float(diffNs_ui) / -1000000.0f;
+  }
+}
+
+
+float getMilliseconds(struct timespec& fr_startNs_ui,
+                      const uint64_t f_endNs_ui)
+{
+  const uint64_t startNs_ui = GET_NANOSECONDS(fr_startNs_ui);
+
+  if (f_endNs_ui > startNs_ui) {
+    const uint64_t diffNs_ui = f_endNs_ui - startNs_ui;
+    return float(diffNs_ui) / 1000000.0f;
+  } else {
+    const uint64_t diffNs_ui = startNs_ui - f_endNs_ui;
+    return float(diffNs_ui) / -1000000.0f;
+  }
+}
+
+
+int64_t getNanoseconds(const uint64_t f_startNs_ui,
+                       const uint64_t f_endNs_ui)
+{
+  return int64_t(f_endNs_ui - f_startNs_ui);
+}
+
+bool timeWriteRead(int           f_serialPortHandle_i,
+                   const uint8_t f_dataByte_ui,
+                   uint64_t&     fr_timeBeforeWrite_ui,
+                   uint64_t&     fr_timeAfterWrite_ui,
+                   uint64_t&     fr_timeAfterRead_ui)
+{
+  struct timespec timeBeforeWrite, timeAfterWrite, timeAfterRead;
+  uint8_t readChar_ui;
+
+  RECORD_TIME(timeBeforeWrite);
+  if (!writeChar(f_serialPortHandle_i, f_dataByte_ui)) {
+    return false;
+  }
+  RECORD_TIME(timeAfterWrite);
+
+  if (!readChar(f_serialPortHandle_i, readChar_ui)) {
+    return false;
+  }
+  RECORD_TIME(timeAfterRead);
+
+  fr_timeBeforeWrite_ui = GET_NANOSECONDS(timeBeforeWrite);
+  fr_timeAfterWrite_ui = GET_NANOSECONDS(timeAfterWrite);
+  fr_timeAfterRead_ui = GET_NANOSECONDS(timeAfterRead);
+
+  return (f_dataByte_ui == readChar_ui);
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -0,0 +1,96 @@
+/* ********************************* FILE ************************************/
+/** \file    serialTiming.h
+ *
+ * \brief    This file describes the timestamps, the serial port access and
+ *           the sysfs interface of the gpiotiming kernel module shared by
+ *           latencyTest and the latency probe library.
+ *
+ *           All timestamps are taken from CLOCK_MONOTONIC_RAW, the clock
+ *           also used by the kernel module.
+ *
+ * \author   Clemens Rabe
+ * \date     Apr 06, 2019
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef SERIAL_TIMING_H
+#define SERIAL_TIMING_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <time.h>
+#include <string>
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+#define RECORD_TIME(timespecStruct) \
+  clock_gettime(CLOCK_MONOTONIC_RAW, (struct timespec*) &timespecStruct);
+
+#define GET_NANOSECONDS(timespecStruct) \
+  (uint64_t(timespecStruct.tv_nsec) + (uint64_t(timespecStruct.tv_sec) * uint64_t(1000000000)))
+
+/// Default baud rate of initializeSerialPort(), the one of the Arduino sketch
+#define SERIAL_DEFAULT_BAUD_RATE 115200
+
+/// Time of a byte (10 bits) at the default baud rate
+#define SERIAL_BYTE_TIME_NS 86806
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Blocking mode and minimum read size of a serial port, see enableSerialPolling()
+struct SerialPortMode {
+  int     flags_i;      ///< File status flags
+  uint8_t minChars_ui;  ///< VMIN of the terminal attributes
+};
+
+
+/*****************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+uint64_t getTimeStampNs();
+float    getMilliseconds(const uint64_t f_startNs_ui,
+                         const uint64_t f_endNs_ui);
+float    getMilliseconds(struct timespec& fr_startNs_ui,
+                         struct timespec& fr_endNs_ui);
+float    getMilliseconds(struct timespec& fr_startNs_ui,
+                         const uint64_t   f_endNs_ui);
+int64_t  getNanoseconds(const uint64_t f_startNs_ui,
+                        const uint64_t f_endNs_ui);
+
+int32_t  getSysfsCounter(const std::string& fr_fileName);
+uint64_t getSysfsTimestamp(const std::string& fr_fileName);
+
+bool     serialBaudRateSupported(const uint32_t f_baudRate_ui);
+bool     initializeSerialPort(int f_serialPortHandle_i, const uint32_t f_numBytes_ui,
+                              const uint32_t f_baudRate_ui = SERIAL_DEFAULT_BAUD_RATE);
+bool     enableSerialPolling(int f_serialPortHandle_i, SerialPortMode& fr_savedMode);
+bool     restoreSerialMode(int f_serialPortHandle_i, const SerialPortMode& fr_savedMode);
+bool     writeChars(int f_serialPortHandle_i,
+                    const uint32_t f_numChars_ui,
+                    const uint8_t* f_chars_p);
+bool     readChars(int f_serialPortHandle_i,
+                   const uint32_t f_numChars_ui,
+                   uint8_t* f_chars_p);
+bool     writeChar(int f_serialPortHandle_i,
+                   const uint8_t f_char_ui);
+bool     readChar(int f_serialPortHandle_i,
+                  uint8_t& fr_char_ui);
+bool     timeWriteRead(int           f_serialPortHandle_i,
+                       const uint8_t f_dataByte_ui,
+                       uint64_t&     fr_timeBeforeWrite_ui,
+                       uint64_t&     fr_timeAfterWrite_ui,
+                       uint64_t&     fr_timeAfterRead_ui);
+
+#endif /* SERIAL_TIMING_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
@@ -21,17 +21,9 @@ fi
 echo "Waiting 5 seconds..."
 sleep 5s
 
-echo "Executing test with real-time priority on CPU core 0..."
+echo "Executing test with real-time priority on the default CPU core of the board..."
 if [ -e /dev/ttyACM0 ]; then
-    if uname -a | grep -q "raspberrypi"; then
-	sudo taskset -c 0 chrt 99 ./latencyTest $@ /dev/ttyACM0
-    else
-	sudo taskset -c 5 chrt 99 ./latencyTest $@ /dev/ttyACM0
-    fi
+	sudo chrt 99 ./latencyTest $@ /dev/ttyACM0
 else
-    if uname -a | grep -q "raspberrypi"; then
-	sudo taskset -c 0 chrt 99 ./latencyTest $@
-    else
-	sudo taskset -c 5 chrt 99 ./latencyTest $@
-    fi
+	sudo chrt 99 ./latencyTest $@
 fi
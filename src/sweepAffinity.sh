@@ -0,0 +1,213 @@
+#!/bin/bash
+#
+# Sweep the placement of the measuring task, the GPIO interrupts and the USB
+# controller interrupts over the CPU cores and run the latency tests for
+# every combination. The results of each combination are stored in a
+# subdirectory of sweep_<date>/ and summarized in sweep_<date>/matrix.txt.
+#
+# Usage: ./sweepAffinity.sh [latencyTest options] [device]
+#
+# Environment variables:
+#   SWEEP_CORES - Cores to use (e.g. "0 4 7"). Default: first and last core
+#                 of each CPU cluster.
+#   GPIO_IRQS   - GPIO interrupt numbers. Default: lines of /proc/interrupts
+#                 containing 'gpiotiming' (kernel module) or the gpiolib
+#                 interrupts of the GPIOs on the interrupt chip of the board
+#                 (userspace, see irq_chip of latencyTest --print-board).
+#   USB_IRQS    - USB controller interrupt numbers. Default: lines of
+#                 /proc/interrupts containing dwc_otg, dwc2, xhci, ehci or ohci.
+#   BINARY      - Test program. Default: ./latencyTest --kmod if the kernel
+#                 module is loaded, otherwise ./latencyTest.
+#
+# (c) 2026 by Clemens Rabe <clemens.rabe@gmail.com>
+
+if [ -z "$BINARY" ]; then
+    if [ -d /sys/gpiotiming ]; then
+        BINARY="$(pwd)/latencyTest --kmod"
+    else
+        BINARY=$(pwd)/latencyTest
+    fi
+fi
+
+# -----------------------------------------------------------------------------
+#  CPU topology
+# -----------------------------------------------------------------------------
+echo "CPU topology:"
+echo "  core cluster max_freq_khz"
+declare -A CLUSTER_CORES
+for CPU_DIR in /sys/devices/system/cpu/cpu[0-9]*; do
+    CORE=${CPU_DIR##*cpu}
+    if [ -e $CPU_DIR/online ] && [ "$(cat $CPU_DIR/online)" = "0" ]; then
+        continue
+    fi
+    if [ -e $CPU_DIR/topology/cluster_id ]; then
+        CLUSTER=$(cat $CPU_DIR/topology/cluster_id)
+    else
+        CLUSTER=$(cat $CPU_DIR/topology/physical_package_id 2>/dev/null || echo 0)
+    fi
+    MAX_FREQ=$(cat $CPU_DIR/cpufreq/cpuinfo_max_freq 2>/dev/null || echo "-")
+    echo "  $CORE $CLUSTER $MAX_FREQ"
+    CLUSTER_CORES[$CLUSTER]="${CLUSTER_CORES[$CLUSTER]} $CORE"
+done
+
+if [ -z "$SWEEP_CORES" ]; then
+    for CLUSTER in "${!CLUSTER_CORES[@]}"; do
+        CORES=$(echo ${CLUSTER_CORES[$CLUSTER]} | tr ' ' '\n' | sort -n)
+        SWEEP_CORES="$SWEEP_CORES $(echo "$CORES" | head -n 1) $(echo "$CORES" | tail -n 1)"
+    done
+    SWEEP_CORES=$(echo $SWEEP_CORES | tr ' ' '\n' | sort -n | uniq | tr '\n' ' ')
+fi
+
+# -----------------------------------------------------------------------------
+#  Interrupts
+# -----------------------------------------------------------------------------
+# The interrupts of wiringPi are listed as gpiolib with the interrupt chip
+# and the GPIO number within its controller, e.g.
+# "pinctrl-bcm2835  4 Edge  gpiolib". The chip is given by the board.
+boardValue() {
+    local KEY=$1
+    shift
+    $BINARY "$@" --print-board 2>/dev/null | \
+        awk -F' *= *' -v key="$KEY" '$1 == key { print $2 }'
+}
+
+boardGpios() {
+    { boardValue arduino_gpio "$@"; boardValue inttest_gpio "$@"; } | \
+        awk '$1 >= 0' | tr '\n' '|' | sed 's/|$//'
+}
+
+findGpioIrqs() {
+    local GPIOS=$(boardGpios "$@")
+    local CHIP=$(boardValue irq_chip "$@")
+    {
+        grep -E "gpiotiming" /proc/interrupts
+        [ -n "$GPIOS" ] && [ -n "$CHIP" ] && grep -E "gpiolib" /proc/interrupts | \
+            grep -E "[[:space:]]${CHIP}[[:space:]]+($GPIOS)[[:space:]]+(Edge|Level)"
+    } | cut -d: -f1 | tr -d ' ' | sort -n | uniq | tr '\n' ' '
+}
+
+# The GPIO tests run unless only the wakeup, bulk or payload test is selected
+# or the board has no GPIOs
+GPIO_TEST=yes
+for ARG in "$@"; do
+    case "$ARG" in
+        -w|--wakeup|-b|--bulk|-p|--payload) GPIO_TEST=no ;;
+        -i|--interrupt|-t|--timed|--concurrent) GPIO_TEST=yes ;;
+    esac
+done
+[ -z "$(boardGpios "$@")" ] && GPIO_TEST=no
+
+if [ -z "$GPIO_IRQS" ]; then
+    GPIO_IRQS=$(findGpioIrqs "$@")
+    if [ -z "$GPIO_IRQS" ] && [ "$GPIO_TEST" = "yes" ]; then
+        # wiringPi requests the interrupts on the first run only
+        echo "Registering the GPIO interrupts by a short interrupt test..."
+        sudo $BINARY "$@" -i --iloops 10 >/dev/null 2>&1
+        GPIO_IRQS=$(findGpioIrqs "$@")
+    fi
+    if [ -z "$GPIO_IRQS" ] && [ "$GPIO_TEST" = "yes" ]; then
+        echo "Error: No GPIO interrupt of the board found in /proc/interrupts! Please set GPIO_IRQS."
+        exit 1
+    fi
+fi
+if [ -z "$USB_IRQS" ]; then
+    USB_IRQS=$(grep -E "dwc_otg|dwc2|xhci|ehci|ohci" /proc/interrupts | cut -d: -f1 | tr -d ' ' | tr '\n' ' ')
+fi
+
+echo "Cores to sweep:           $SWEEP_CORES"
+echo "GPIO interrupts:          ${GPIO_IRQS:-none found}"
+echo "USB controller interrupts: ${USB_IRQS:-none found}"
+
+# Remember the original affinities and restore them on exit
+declare -A ORIG_AFFINITY
+for IRQ in $GPIO_IRQS $USB_IRQS; do
+    ORIG_AFFINITY[$IRQ]=$(cat /proc/irq/$IRQ/smp_affinity)
+done
+
+restoreAffinity() {
+    for IRQ in "${!ORIG_AFFINITY[@]}"; do
+        echo ${ORIG_AFFINITY[$IRQ]} | sudo tee /proc/irq/$IRQ/smp_affinity >/dev/null
+    done
+}
+trap restoreAffinity EXIT
+
+setAffinity() {
+    local CORE=$1
+    shift
+    for IRQ in $@; do
+        printf "%x" $((1 << CORE)) | sudo tee /proc/irq/$IRQ/smp_affinity >/dev/null || \
+            echo "Warning: Can't set affinity of IRQ $IRQ to core $CORE."
+    done
+}
+
+# Print the median, 99%, 99.9% quantile and maximum of a time series file
+percentiles() {
+    if [ ! -e "$1" ]; then
+        echo "- - - -"
+        return
+    fi
+    grep -v '^#' "$1" | sort -g | awk '{ v[NR] = $1 }
+        END {
+            if (NR == 0) { print "- - - -"; exit }
+            printf "%.6f %.6f %.6f %.6f\n", v[int((NR-1)*0.5)+1], v[int((NR-1)*0.99)+1], v[int((NR-1)*0.999)+1], v[NR]
+        }'
+}
+
+# -----------------------------------------------------------------------------
+#  Sweep
+# -----------------------------------------------------------------------------
+echo "Set CPU governor to 'performance' on all cores..."
+echo performance | sudo tee /sys/devices/system/cpu/cpu*/cpufreq/scaling_governor >/dev/null
+
+SWEEP_DIR=sweep_$(date +%Y%m%d_%H%M%S)
+mkdir -p $SWEEP_DIR
+MATRIX=$SWEEP_DIR/matrix.txt
+
+SERIES="digitalWriteStart_to_interrupt startWrite_to_interrupt startWrite_to_endRead"
+{
+    echo "# Affinity sweep on $(uname -n) ($(uname -r)) using ${BINARY##*/} $@"
+    echo "# Values in milliseconds. Columns: measuring core, GPIO IRQ core, USB IRQ core,"
+    for S in $SERIES; do
+        echo "#   $S: median, 99%, 99.9%, max"
+    done
+} > $MATRIX
+
+GPIO_SWEEP_CORES=$SWEEP_CORES
+[ -z "$GPIO_IRQS" ] && GPIO_SWEEP_CORES="-"
+USB_SWEEP_CORES=$SWEEP_CORES
+[ -z "$USB_IRQS" ] && USB_SWEEP_CORES="-"
+
+for CORE in $SWEEP_CORES; do
+    for GPIO_CORE in $GPIO_SWEEP_CORES; do
+        [ "$GPIO_CORE" != "-" ] && setAffinity $GPIO_CORE $GPIO_IRQS
+        for USB_CORE in $USB_SWEEP_CORES; do
+            [ "$USB_CORE" != "-" ] && setAffinity $USB_CORE $USB_IRQS
+
+            RUN_DIR=$SWEEP_DIR/core${CORE}_gpio${GPIO_CORE}_usb${USB_CORE}
+            mkdir -p $RUN_DIR
+            echo "Measuring on core $CORE, GPIO IRQs on core $GPIO_CORE, USB IRQs on core $USB_CORE..."
+            (cd $RUN_DIR && sudo taskset -c $CORE chrt 99 $BINARY $@ > latencyTest.log 2>&1)
+
+            ROW="$CORE $GPIO_CORE $USB_CORE"
+            for S in $SERIES; do
+                ROW="$ROW   $(percentiles $RUN_DIR/$S.gpd)"
+            done
+            echo "$ROW" >> $MATRIX
+        done
+    done
+done
+
+# -----------------------------------------------------------------------------
+#  Summary
+# -----------------------------------------------------------------------------
+echo
+echo "Placement with the lowest 99.9% quantile:"
+COLUMN=4
+for S in $SERIES; do
+    BEST=$(grep -v '^#' $MATRIX | awk -v c=$((COLUMN+2)) '$c != "-"' | sort -g -k $((COLUMN+2)) | head -n 1)
+    if [ -n "$BEST" ]; then
+        echo "  $S: core $(echo $BEST | cut -d' ' -f1), GPIO IRQs on core $(echo $BEST | cut -d' ' -f2), USB IRQs on core $(echo $BEST | cut -d' ' -f3) (99.9% = $(echo $BEST | cut -d' ' -f$((COLUMN+2))) ms)"
+    fi
+    COLUMN=$((COLUMN+4))
+done
+echo "Full matrix: $MATRIX"
@@ -0,0 +1,763 @@
+/* ********************************* FILE ************************************/
+/** \file    telemetry.cpp
+ *
+ * \brief    This file describes the live telemetry of long-running
+ *           measurements.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include "telemetry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sched.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <algorithm>
+#include <deque>
+
+#include "hdrHistogram.h"
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+/// Period of the telemetry thread, i.e., the maximum delay of a request
+#define TELEMETRY_PERIOD_MS      100
+
+/// Number of published percentiles, see g_telemetryPercentiles
+#define TELEMETRY_NUM_PERCENTILES 6
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// Statistics of a series, owned by the telemetry thread
+struct TelemetrySeries {
+  std::string                                  name;
+  HdrHistogram                                 total;
+  std::deque<std::pair<uint64_t, int64_t> >    window;  ///< Arrival time and value
+};
+
+
+/*****************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************/
+/// The published percentiles, 0 and 100 are the minimum and maximum
+static const double g_telemetryPercentiles[TELEMETRY_NUM_PERCENTILES] = { 0.0, 50.0, 90.0, 99.0, 99.9, 100.0 };
+static const char*  g_telemetryPercentileNames_p[TELEMETRY_NUM_PERCENTILES] = {
+  "min", "p50", "p90", "p99", "p99.9", "max" };
+
+thread_local TelemetryRing* Telemetry::s_ring_p = NULL;
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the current time of the CLOCK_MONOTONIC clock in nanoseconds.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns the current time in nanoseconds.
+ *
+ *****************************************************************************/
+static uint64_t telemetryNowNs()
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return uint64_t(t.tv_sec) * 1000000000ULL + uint64_t(t.tv_nsec);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Get the percentiles of the rolling window of a series.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in]  fr_series   - The series.
+ * \param[out] fr_valuesNs - The values of g_telemetryPercentiles.
+ *
+ *****************************************************************************/
+static void windowPercentiles(const TelemetrySeries& fr_series,
+                              int64_t*               fr_valuesNs)
+{
+    std::vector<int64_t> values(fr_series.window.size());
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = fr_series.window[i].second;
+    std::sort(values.begin(), values.end());
+
+    for (uint32_t p = 0; p < TELEMETRY_NUM_PERCENTILES; ++p) {
+        if (values.empty()) {
+            fr_valuesNs[p] = 0;
+            continue;
+        }
+        // Nearest rank like HdrHistogram::percentile()
+        size_t rank_ui = size_t(ceil(g_telemetryPercentiles[p] / 100.0 * double(values.size())));
+        rank_ui = std::max(rank_ui, size_t(1));
+        fr_valuesNs[p] = values[std::min(rank_ui, values.size()) - 1];
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Constructor.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+Telemetry::Telemetry()
+  : m_numDropped_ui(0),
+    m_numErrors_ui(0),
+    m_numSeries_ui(0),
+    m_socketHandle_i(-1),
+    m_httpHandle_i(-1),
+    m_windowNs_ui(0),
+    m_startNs_ui(0),
+    m_running_b(false),
+    m_stop_b(false)
+{
+    for (uint32_t i = 0; i < TELEMETRY_MAX_THREADS; ++i) {
+        m_rings[i].head_ui = 0;
+        m_rings[i].tail_ui = 0;
+        m_rings[i].tid_i   = 0;
+        memset(&m_isolation[i], 0, sizeof(m_isolation[i]));
+        m_isolation[i].lastCpu_i = -1;
+    }
+    memset(m_names, 0, sizeof(m_names));
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Destructor. Stops the telemetry thread.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+Telemetry::~Telemetry()
+{
+    stop();
+    for (size_t i = 0; i < m_series.size(); ++i)
+        delete m_series[i];
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Open the endpoints and start the telemetry thread.
+ *
+ *            The calling thread is attached to the first ring, see
+ *            attachThread().
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_socketPath       - Path of the Unix socket serving JSON, or
+ *                                  empty to disable it.
+ * \param[in] f_prometheusPort_ui - TCP port on localhost serving the
+ *                                  Prometheus text format, or 0 to disable it.
+ * \param[in] f_windowS_f         - Length of the rolling window in seconds.
+ * \return    Returns \c true on success, otherwise \c false.
+ *
+ *****************************************************************************/
+bool Telemetry::start(const std::string& fr_socketPath,
+                      const uint32_t     f_prometheusPort_ui,
+                      const float        f_windowS_f)
+{
+    m_windowNs_ui = uint64_t(f_windowS_f * 1.0e9f);
+    m_startNs_ui  = telemetryNowNs();
+    for (uint32_t i = 0; i < TELEMETRY_MAX_THREADS; ++i)
+        m_rings[i].samples.resize(TELEMETRY_RING_SIZE);
+    attachThread(0);
+
+    if (!fr_socketPath.empty()) {
+        struct sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (fr_socketPath.size() >= sizeof(address.sun_path)) {
+            printf("Error: The telemetry socket path %s is too long!\n", fr_socketPath.c_str());
+            return false;
+        }
+        strcpy(address.sun_path, fr_socketPath.c_str());
+
+        // Replace a stale socket of a previous run, but nothing else
+        struct stat fileStat;
+        if (lstat(fr_socketPath.c_str(), &fileStat) == 0) {
+            if (!S_ISSOCK(fileStat.st_mode)) {
+                printf("Error: %s exists and is not a socket!\n", fr_socketPath.c_str());
+                return false;
+            }
+            unlink(fr_socketPath.c_str());
+        }
+
+        m_socketHandle_i = socket(AF_UNIX, SOCK_STREAM, 0);
+        if ((m_socketHandle_i < 0) ||
+            (bind(m_socketHandle_i, (struct sockaddr*)&address, sizeof(address)) < 0) ||
+            (listen(m_socketHandle_i, 4) < 0)) {
+            printf("Error: Can't listen on the telemetry socket %s!\n", fr_socketPath.c_str());
+            stop();
+            return false;
+        }
+        m_socketPath = fr_socketPath;
+        printf("Info: Publishing telemetry as JSON on the Unix socket %s.\n", fr_socketPath.c_str());
+    }
+
+    if (f_prometheusPort_ui != 0) {
+        struct sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family      = AF_INET;
+        address.sin_port        = htons(uint16_t(f_prometheusPort_ui));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        const int reuse_i = 1;
+
+        m_httpHandle_i = socket(AF_INET, SOCK_STREAM, 0);
+        if ((m_httpHandle_i < 0) ||
+            (setsockopt(m_httpHandle_i, SOL_SOCKET, SO_REUSEADDR, &reuse_i, sizeof(reuse_i)) < 0) ||
+            (bind(m_httpHandle_i, (struct sockaddr*)&address, sizeof(address)) < 0) ||
+            (listen(m_httpHandle_i, 4) < 0)) {
+            printf("Error: Can't listen on port %d of localhost for Prometheus!\n", f_prometheusPort_ui);
+            stop();
+            return false;
+        }
+        printf("Info: Publishing telemetry for Prometheus on http://127.0.0.1:%d/metrics.\n", f_prometheusPort_ui);
+    }
+
+    // The thread must not inherit a real-time policy of the measurement
+    pthread_attr_t attributes;
+    struct sched_param parameters;
+    memset(&parameters, 0, sizeof(parameters));
+    pthread_attr_init(&attributes);
+    pthread_attr_setinheritsched(&attributes, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attributes, SCHED_OTHER);
+    pthread_attr_setschedparam(&attributes, &parameters);
+
+    m_stop_b = false;
+    const int result_i = pthread_create(&m_thread, &attributes, &Telemetry::threadMain, this);
+    pthread_attr_destroy(&attributes);
+    if (result_i != 0) {
+        printf("Error: Can't start the telemetry thread!\n");
+        stop();
+        return false;
+    }
+    m_running_b = true;
+
+    return true;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Stop the telemetry thread and close the endpoints.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void Telemetry::stop()
+{
+    if (m_running_b) {
+        m_stop_b = true;
+        pthread_join(m_thread, NULL);
+        m_running_b = false;
+    }
+
+    if (m_socketHandle_i >= 0) {
+        close(m_socketHandle_i);
+        m_socketHandle_i = -1;
+    }
+    if (!m_socketPath.empty()) {
+        unlink(m_socketPath.c_str());
+        m_socketPath.clear();
+    }
+    if (m_httpHandle_i >= 0) {
+        close(m_httpHandle_i);
+        m_httpHandle_i = -1;
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Let the calling thread push its samples into a ring and watch
+ *            it for isolation violations.
+ *
+ *            Threads measuring concurrently need different rings. A thread
+ *            may take over the ring of a thread that finished.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_ring_ui - Index of the ring, less than TELEMETRY_MAX_THREADS.
+ *
+ *****************************************************************************/
+void Telemetry::attachThread(const uint32_t f_ring_ui)
+{
+    if (f_ring_ui >= TELEMETRY_MAX_THREADS)
+        return;
+    s_ring_p = &m_rings[f_ring_ui];
+    m_rings[f_ring_ui].tid_i.store(pid_t(syscall(SYS_gettid)), std::memory_order_relaxed);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Register a series.
+ *
+ *            Called by a measurement thread before the series records
+ *            samples. A series of the same name continues the statistics.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] fr_name - Name of the series.
+ * \return    Returns the identifier, or TELEMETRY_MAX_SERIES if there are too
+ *            many series (their samples are dropped).
+ *
+ *****************************************************************************/
+uint32_t Telemetry::registerSeries(const std::string& fr_name)
+{
+    std::lock_guard<std::mutex> lock(m_registerMutex);
+
+    uint32_t       seriesId_ui  = TELEMETRY_MAX_SERIES;
+    const uint32_t numSeries_ui = m_numSeries_ui.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; (i < numSeries_ui) && (seriesId_ui == TELEMETRY_MAX_SERIES); ++i) {
+        if (fr_name == m_names[i])
+            seriesId_ui = i;
+    }
+
+    if ((seriesId_ui == TELEMETRY_MAX_SERIES) && (numSeries_ui < TELEMETRY_MAX_SERIES)) {
+        strncpy(m_names[numSeries_ui], fr_name.c_str(), TELEMETRY_MAX_NAME - 1);
+        m_numSeries_ui.store(numSeries_ui + 1, std::memory_order_release);
+        seriesId_ui = numSeries_ui;
+    }
+
+    return seriesId_ui;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Entry point of the telemetry thread.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_telemetry_p - The telemetry object.
+ * \return    Returns \c NULL.
+ *
+ *****************************************************************************/
+void* Telemetry::threadMain(void* f_telemetry_p)
+{
+    static_cast<Telemetry*>(f_telemetry_p)->run();
+    return NULL;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Main loop of the telemetry thread.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void Telemetry::run()
+{
+    checkIsolation();
+
+    // Lowest priority, and away from the CPU of the measurement if possible
+    setpriority(PRIO_PROCESS, pid_t(syscall(SYS_gettid)), 19);
+    cpu_set_t cpus;
+    if ((pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0) &&
+        (CPU_COUNT(&cpus) > 1) && (m_isolation[0].lastCpu_i >= 0)) {
+        CPU_CLR(m_isolation[0].lastCpu_i, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+
+    while (!m_stop_b) {
+        struct pollfd handles[2];
+        uint32_t numHandles_ui = 0;
+        if (m_socketHandle_i >= 0) {
+            handles[numHandles_ui].fd     = m_socketHandle_i;
+            handles[numHandles_ui].events = POLLIN;
+            ++numHandles_ui;
+        }
+        if (m_httpHandle_i >= 0) {
+            handles[numHandles_ui].fd     = m_httpHandle_i;
+            handles[numHandles_ui].events = POLLIN;
+            ++numHandles_ui;
+        }
+
+        const int numReady_i = poll(handles, numHandles_ui, TELEMETRY_PERIOD_MS);
+        const uint64_t nowNs_ui = telemetryNowNs();
+        drain(nowNs_ui);
+        checkIsolation();
+
+        for (uint32_t i = 0; (numReady_i > 0) && (i < numHandles_ui); ++i) {
+            if (handles[i].revents & POLLIN)
+                serve(handles[i].fd, handles[i].fd == m_httpHandle_i, nowNs_ui);
+        }
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Move the samples from the rings into the statistics.
+ *
+ *            The samples are timestamped on arrival, so the rolling window
+ *            is accurate to the period of the telemetry thread.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_nowNs_ui - The current time in nanoseconds.
+ *
+ *****************************************************************************/
+void Telemetry::drain(const uint64_t f_nowNs_ui)
+{
+    // A series is registered before its first sample is pushed
+    const uint32_t numSeries_ui = m_numSeries_ui.load(std::memory_order_acquire);
+    while (m_series.size() < numSeries_ui) {
+        TelemetrySeries* series_p = new TelemetrySeries;
+        series_p->name = m_names[m_series.size()];
+        m_series.push_back(series_p);
+    }
+
+    for (uint32_t r = 0; r < TELEMETRY_MAX_THREADS; ++r) {
+        TelemetryRing& ring    = m_rings[r];
+        const uint32_t head_ui = ring.head_ui.load(std::memory_order_acquire);
+        uint32_t       tail_ui = ring.tail_ui.load(std::memory_order_relaxed);
+
+        for (; tail_ui != head_ui; ++tail_ui) {
+            const TelemetrySample& sample   = ring.samples[tail_ui & (TELEMETRY_RING_SIZE - 1)];
+            TelemetrySeries*       series_p = m_series[sample.seriesId_ui];
+            series_p->total.record(sample.valueNs_i);
+            series_p->window.push_back(std::make_pair(f_nowNs_ui, sample.valueNs_i));
+        }
+        ring.tail_ui.store(tail_ui, std::memory_order_release);
+    }
+
+    for (size_t i = 0; i < m_series.size(); ++i) {
+        std::deque<std::pair<uint64_t, int64_t> >& window = m_series[i]->window;
+        while (!window.empty() && (window.front().first + m_windowNs_ui < f_nowNs_ui))
+            window.pop_front();
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Update the isolation counters of the measurement threads.
+ *
+ *            Involuntary context switches mean that a measurement thread
+ *            was preempted, a change of its CPU is a migration. The counters
+ *            of a ring taken over by another thread continue with the
+ *            counters of the new thread.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ *****************************************************************************/
+void Telemetry::checkIsolation()
+{
+    char fileName[64];
+    char buffer[2048];
+
+    for (uint32_t r = 0; r < TELEMETRY_MAX_THREADS; ++r) {
+        TelemetryIsolation& isolation = m_isolation[r];
+        const pid_t         tid_i     = m_rings[r].tid_i.load(std::memory_order_relaxed);
+        if (tid_i == 0)
+            continue;
+        const bool sameThread_b = (tid_i == isolation.tid_i);
+        isolation.tid_i = tid_i;
+
+        snprintf(fileName, sizeof(fileName), "/proc/self/task/%d/status", int(tid_i));
+        FILE* file_p = fopen(fileName, "r");
+        if (file_p) {
+            while (fgets(buffer, sizeof(buffer), file_p)) {
+                unsigned long long value_ui;
+                if (sscanf(buffer, "nonvoluntary_ctxt_switches: %llu", &value_ui) == 1) {
+                    if (sameThread_b)
+                        isolation.ctxtSwitches_ui += value_ui - isolation.lastCtxtSwitches_ui;
+                    isolation.lastCtxtSwitches_ui = value_ui;
+                }
+            }
+            fclose(file_p);
+        }
+
+        // The CPU is the 39th field, the name (2nd field) may contain spaces
+        snprintf(fileName, sizeof(fileName), "/proc/self/task/%d/stat", int(tid_i));
+        file_p = fopen(fileName, "r");
+        if (file_p) {
+            const size_t size_ui = fread(buffer, 1, sizeof(buffer) - 1, file_p);
+            fclose(file_p);
+            buffer[size_ui] = '\0';
+
+            const char* pos_p = strrchr(buffer, ')');
+            for (uint32_t field_ui = 2; pos_p && (field_ui < 39); ++field_ui)
+                pos_p = strchr(pos_p + 1, ' ');
+            if (pos_p) {
+                const int32_t cpu_i = atoi(pos_p + 1);
+                if (sameThread_b && (isolation.lastCpu_i >= 0) && (cpu_i != isolation.lastCpu_i))
+                    ++isolation.numMigrations_ui;
+                isolation.lastCpu_i = cpu_i;
+            }
+        }
+    }
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Answer a client of an endpoint.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_listenHandle_i - The listening socket.
+ * \param[in] f_http_b         - If \c true, answer an HTTP request with the
+ *                               Prometheus text format, otherwise send JSON.
+ * \param[in] f_nowNs_ui       - The current time in nanoseconds.
+ *
+ *****************************************************************************/
+void Telemetry::serve(const int      f_listenHandle_i,
+                      const bool     f_http_b,
+                      const uint64_t f_nowNs_ui)
+{
+    const int clientHandle_i = accept(f_listenHandle_i, NULL, NULL);
+    if (clientHandle_i < 0)
+        return;
+
+    // A slow client must not stall the telemetry for long
+    struct timeval timeout;
+    timeout.tv_sec  = 1;
+    timeout.tv_usec = 0;
+    setsockopt(clientHandle_i, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(clientHandle_i, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string response;
+    if (f_http_b) {
+        char request[1024];
+        const ssize_t size_i = recv(clientHandle_i, request, sizeof(request), 0);
+        if ((size_i >= 4) && (strncmp(request, "GET ", 4) == 0)) {
+            const std::string body = renderPrometheus();
+            char header[160];
+            snprintf(header, sizeof(header),
+                     "HTTP/1.0 200 OK\r\n"
+                     "Content-Type: text/plain; version=0.0.4\r\n"
+                     "Content-Length: %zu\r\n"
+                     "Connection: close\r\n\r\n", body.size());
+            response = header + body;
+        }
+        else {
+            response = "HTTP/1.0 405 Method Not Allowed\r\nConnection: close\r\n\r\n";
+        }
+    }
+    else {
+        response = renderJson(f_nowNs_ui);
+    }
+
+    size_t sent_ui = 0;
+    while (sent_ui < response.size()) {
+        const ssize_t size_i = send(clientHandle_i, response.data() + sent_ui, response.size() - sent_ui,
+                                    MSG_NOSIGNAL);
+        if (size_i <= 0)
+            break;
+        sent_ui += size_t(size_i);
+    }
+    close(clientHandle_i);
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Render the statistics as JSON. Latencies are in milliseconds.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \param[in] f_nowNs_ui - The current time in nanoseconds.
+ * \return    Returns the JSON document.
+ *
+ *****************************************************************************/
+std::string Telemetry::renderJson(const uint64_t f_nowNs_ui)
+{
+    const double windowS_d = double(m_windowNs_ui) / 1.0e9;
+    const double uptimeS_d = double(f_nowNs_ui - m_startNs_ui) / 1.0e9;
+    std::string  json;
+    char         buffer[1024];
+
+    snprintf(buffer, sizeof(buffer),
+             "{\n"
+             "  \"uptime_s\": %.3f,\n"
+             "  \"errors\": %llu,\n"
+             "  \"dropped_samples\": %llu,\n"
+             "  \"isolation\": [",
+             uptimeS_d,
+             (unsigned long long)m_numErrors_ui.load(std::memory_order_relaxed),
+             (unsigned long long)m_numDropped_ui.load(std::memory_order_relaxed));
+    json += buffer;
+
+    bool first_b = true;
+    for (uint32_t r = 0; r < TELEMETRY_MAX_THREADS; ++r) {
+        const TelemetryIsolation& isolation = m_isolation[r];
+        if (isolation.tid_i == 0)
+            continue;
+        snprintf(buffer, sizeof(buffer),
+                 "%s\n    { \"thread\": %d, \"cpu\": %d, \"involuntary_context_switches\": %llu, "
+                 "\"cpu_migrations\": %llu }",
+                 first_b ? "" : ",", int(isolation.tid_i), int(isolation.lastCpu_i),
+                 (unsigned long long)isolation.ctxtSwitches_ui, (unsigned long long)isolation.numMigrations_ui);
+        json += buffer;
+        first_b = false;
+    }
+    json += "\n  ],\n  \"series\": {";
+
+    for (size_t i = 0; i < m_series.size(); ++i) {
+        const TelemetrySeries& series = *m_series[i];
+        int64_t windowNs[TELEMETRY_NUM_PERCENTILES];
+        windowPercentiles(series, windowNs);
+
+        snprintf(buffer, sizeof(buffer),
+                 "%s\n    \"%s\": {\n"
+                 "      \"count\": %llu, \"rate_hz\": %.3f,\n"
+                 "      \"cumulative\": {",
+                 (i > 0) ? "," : "", series.name.c_str(), (unsigned long long)series.total.count(),
+                 (uptimeS_d > 0.0) ? double(series.total.count()) / uptimeS_d : 0.0);
+        json += buffer;
+        for (uint32_t p = 0; p < TELEMETRY_NUM_PERCENTILES; ++p) {
+            snprintf(buffer, sizeof(buffer), "%s \"%s\": %.6f", (p > 0) ? "," : "", g_telemetryPercentileNames_p[p],
+                     double(series.total.percentile(g_telemetryPercentiles[p])) / 1000000.0);
+            json += buffer;
+        }
+
+        snprintf(buffer, sizeof(buffer),
+                 " },\n"
+                 "      \"window\": { \"seconds\": %.1f, \"count\": %zu, \"rate_hz\": %.3f,",
+                 windowS_d, series.window.size(), double(series.window.size()) / windowS_d);
+        json += buffer;
+        for (uint32_t p = 0; p < TELEMETRY_NUM_PERCENTILES; ++p) {
+            snprintf(buffer, sizeof(buffer), "%s \"%s\": %.6f", (p > 0) ? "," : "", g_telemetryPercentileNames_p[p],
+                     double(windowNs[p]) / 1000000.0);
+            json += buffer;
+        }
+        json += " }\n    }";
+    }
+    json += "\n  }\n}\n";
+
+    return json;
+}
+
+
+/* ********************************* METHOD **********************************/
+/**
+ * \brief     Render the statistics in the Prometheus text format. Latencies
+ *            are in seconds as recommended by Prometheus.
+ *
+ * \author    Clemens Rabe
+ * \date      Oct 18, 2026
+ *
+ * \return    Returns the metrics.
+ *
+ *****************************************************************************/
+std::string Telemetry::renderPrometheus()
+{
+    const double windowS_d = double(m_windowNs_ui) / 1.0e9;
+    std::string  text;
+    char         buffer[1024];
+
+    text += "# HELP latency_seconds Latency percentiles of the measured series, cumulative and over the rolling window.\n"
+            "# TYPE latency_seconds gauge\n";
+    for (size_t i = 0; i < m_series.size(); ++i) {
+        const TelemetrySeries& series = *m_series[i];
+        int64_t windowNs[TELEMETRY_NUM_PERCENTILES];
+        windowPercentiles(series, windowNs);
+
+        for (uint32_t p = 0; p < TELEMETRY_NUM_PERCENTILES; ++p) {
+            snprintf(buffer, sizeof(buffer), "latency_seconds{series=\"%s\",window=\"cumulative\",quantile=\"%g\"} %.9f\n",
+                     series.name.c_str(), g_telemetryPercentiles[p] / 100.0,
+                     double(series.total.percentile(g_telemetryPercentiles[p])) / 1.0e9);
+            text += buffer;
+        }
+        for (uint32_t p = 0; p < TELEMETRY_NUM_PERCENTILES; ++p) {
+            snprintf(buffer, sizeof(buffer), "latency_seconds{series=\"%s\",window=\"rolling\",quantile=\"%g\"} %.9f\n",
+                     series.name.c_str(), g_telemetryPercentiles[p] / 100.0, double(windowNs[p]) / 1.0e9);
+            text += buffer;
+        }
+    }
+
+    text += "# HELP latency_samples_total Number of samples of the measured series.\n"
+            "# TYPE latency_samples_total counter\n";
+    for (size_t i = 0; i < m_series.size(); ++i) {
+        snprintf(buffer, sizeof(buffer), "latency_samples_total{series=\"%s\"} %llu\n",
+                 m_series[i]->name.c_str(), (unsigned long long)m_series[i]->total.count());
+        text += buffer;
+    }
+
+    text += "# HELP latency_sample_rate_hertz Sample rate of the measured series over the rolling window.\n"
+            "# TYPE latency_sample_rate_hertz gauge\n";
+    for (size_t i = 0; i < m_series.size(); ++i) {
+        snprintf(buffer, sizeof(buffer), "latency_sample_rate_hertz{series=\"%s\"} %.3f\n",
+                 m_series[i]->name.c_str(), double(m_series[i]->window.size()) / windowS_d);
+        text += buffer;
+    }
+
+    snprintf(buffer, sizeof(buffer),
+             "# HELP latency_errors_total Number of failed iterations.\n"
+             "# TYPE latency_errors_total counter\n"
+             "latency_errors_total %llu\n"
+             "# HELP latency_dropped_samples_total Samples not published because a telemetry ring was full.\n"
+             "# TYPE latency_dropped_samples_total counter\n"
+             "latency_dropped_samples_total %llu\n",
+             (unsigned long long)m_numErrors_ui.load(std::memory_order_relaxed),
+             (unsigned long long)m_numDropped_ui.load(std::memory_order_relaxed));
+    text += buffer;
+
+    uint64_t ctxtSwitches_ui  = 0;
+    uint64_t numMigrations_ui = 0;
+    for (uint32_t r = 0; r < TELEMETRY_MAX_THREADS; ++r) {
+        ctxtSwitches_ui  += m_isolation[r].ctxtSwitches_ui;
+        numMigrations_ui += m_isolation[r].numMigrations_ui;
+    }
+    snprintf(buffer, sizeof(buffer),
+             "# HELP latency_involuntary_context_switches_total Preemptions of the measurement threads.\n"
+             "# TYPE latency_involuntary_context_switches_total counter\n"
+             "latency_involuntary_context_switches_total %llu\n"
+             "# HELP latency_cpu_migrations_total CPU changes of the measurement threads.\n"
+             "# TYPE latency_cpu_migrations_total counter\n"
+             "latency_cpu_migrations_total %llu\n",
+             (unsigned long long)ctxtSwitches_ui, (unsigned long long)numMigrations_ui);
+    text += buffer;
+
+    return text;
+}
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/
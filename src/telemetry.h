@@ -0,0 +1,171 @@
+/* ********************************* FILE ************************************/
+/** \file    telemetry.h
+ *
+ * \brief    This file describes the live telemetry of long-running
+ *           measurements.
+ *
+ *           Each measurement thread pushes its samples into its own
+ *           lock-free single-producer/single-consumer ring and never waits:
+ *           if the ring is full, the sample is counted as dropped. A
+ *           separate thread with the lowest priority drains the rings into
+ *           its own cumulative histograms and rolling windows, watches the
+ *           measurement threads for isolation violations (involuntary
+ *           context switches and CPU migrations) and publishes the
+ *           statistics on request as JSON over a Unix socket and in the
+ *           Prometheus text format over HTTP on localhost.
+ *
+ * \author   Clemens Rabe
+ * \date     Oct 18, 2026
+ * \note     (C) Copyright Clemens Rabe <clemens.rabe@gmail.com>
+ *
+ *****************************************************************************/
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+
+/*****************************************************************************
+ * INCLUDE FILES
+ ******************************************************************************/
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "latencySeries.h"
+
+
+/*****************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+/// Number of samples in a ring, must be a power of two
+#define TELEMETRY_RING_SIZE      65536
+
+/// Maximum number of measurement threads, each with its own ring
+#define TELEMETRY_MAX_THREADS    2
+
+/// Maximum number of series
+#define TELEMETRY_MAX_SERIES     32
+
+/// Maximum length of a series name
+#define TELEMETRY_MAX_NAME       64
+
+
+/*****************************************************************************
+ * TYPES
+ ******************************************************************************/
+/// A sample passed from the measurement thread to the telemetry thread
+struct TelemetrySample {
+  uint32_t seriesId_ui;
+  int64_t  valueNs_i;
+};
+
+/// Ring of the samples of a single measurement thread
+struct TelemetryRing {
+  std::vector<TelemetrySample> samples;
+  std::atomic<uint32_t>        head_ui;
+  char                         padding1[64];
+  std::atomic<uint32_t>        tail_ui;
+  char                         padding2[64];
+  std::atomic<pid_t>           tid_i;   ///< The thread pushing into the ring, 0 if none
+};
+
+/// Isolation counters of a measurement thread, owned by the telemetry thread
+struct TelemetryIsolation {
+  pid_t    tid_i;
+  int32_t  lastCpu_i;
+  uint64_t lastCtxtSwitches_ui;
+  uint64_t ctxtSwitches_ui;
+  uint64_t numMigrations_ui;
+};
+
+/// Statistics of a series, owned by the telemetry thread
+struct TelemetrySeries;
+
+
+/*****************************************************************************
+ * CLASS
+ ******************************************************************************/
+/// The telemetry publisher.
+class Telemetry : public LatencySink {
+ public:
+  Telemetry();
+  ~Telemetry();
+
+  bool start(const std::string& fr_socketPath,
+             const uint32_t     f_prometheusPort_ui,
+             const float        f_windowS_f);
+  void stop();
+  bool isRunning() const { return m_running_b; }
+
+  /// Count an error of the measurement, e.g. a failed write or read.
+  inline void countError() {
+    m_numErrors_ui.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void attachThread(const uint32_t f_ring_ui);
+
+  virtual uint32_t registerSeries(const std::string& fr_name);
+
+  /// Push a sample into the ring of the calling thread. Wait-free, as each
+  /// measurement thread has its own ring. Samples of a thread without a
+  /// ring are dropped.
+  virtual void record(const uint32_t f_seriesId_ui,
+                      const int64_t  f_valueNs_i) {
+    TelemetryRing* ring_p = s_ring_p;
+    if (!ring_p || (f_seriesId_ui >= TELEMETRY_MAX_SERIES)) {
+      m_numDropped_ui.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    const uint32_t head_ui = ring_p->head_ui.load(std::memory_order_relaxed);
+    if (head_ui - ring_p->tail_ui.load(std::memory_order_acquire) >= TELEMETRY_RING_SIZE) {
+      m_numDropped_ui.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    ring_p->samples[head_ui & (TELEMETRY_RING_SIZE - 1)].seriesId_ui = f_seriesId_ui;
+    ring_p->samples[head_ui & (TELEMETRY_RING_SIZE - 1)].valueNs_i   = f_valueNs_i;
+    ring_p->head_ui.store(head_ui + 1, std::memory_order_release);
+  }
+
+ private:
+  static void* threadMain(void* f_telemetry_p);
+  void         run();
+  void         drain(const uint64_t f_nowNs_ui);
+  void         checkIsolation();
+  void         serve(const int f_listenHandle_i, const bool f_http_b, const uint64_t f_nowNs_ui);
+  std::string  renderJson(const uint64_t f_nowNs_ui);
+  std::string  renderPrometheus();
+
+  /// Ring of the calling thread, set by attachThread()
+  static thread_local TelemetryRing* s_ring_p;
+
+  // Written by the measurement threads
+  TelemetryRing                m_rings[TELEMETRY_MAX_THREADS];
+  std::atomic<uint64_t>        m_numDropped_ui;
+  std::atomic<uint64_t>        m_numErrors_ui;
+  std::mutex                   m_registerMutex;
+  char                         m_names[TELEMETRY_MAX_SERIES][TELEMETRY_MAX_NAME];
+  std::atomic<uint32_t>        m_numSeries_ui;
+
+  // Owned by the telemetry thread
+  std::vector<TelemetrySeries*> m_series;
+  TelemetryIsolation            m_isolation[TELEMETRY_MAX_THREADS];
+  int                           m_socketHandle_i;
+  int                           m_httpHandle_i;
+  std::string                   m_socketPath;
+  uint64_t                      m_windowNs_ui;
+  uint64_t                      m_startNs_ui;
+
+  pthread_t                     m_thread;
+  bool                          m_running_b;
+  std::atomic<bool>             m_stop_b;
+};
+
+#endif /* TELEMETRY_H */
+
+
+/*****************************************************************************
+ * END OF FILE
+ ******************************************************************************/